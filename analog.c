@@ -0,0 +1,117 @@
+/**
+ * @file analog.c
+ * @brief Aquisição contínua do ADC por DMA, com sobreamostragem
+ *
+ * O canal de dados lê o FIFO do ADC (DREQ_ADC) e escreve no buffer com
+ * wrap de endereço (ring) a cada ANALOG_RING_SAMPLES conversões. Ao fim
+ * de ANALOG_BLOCK_SAMPLES conversões ele encadeia o canal de controle,
+ * que reescreve o contador do canal de dados (registrador com gatilho)
+ * e o reinicia. O FIFO de 4 posições cobre a troca, então nenhuma
+ * conversão se perde e a ordem do rodízio se mantém.
+ */
+#include "analog.h"
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+
+static volatile uint16_t ring[ANALOG_RING_SAMPLES] __attribute__((aligned(ANALOG_RING_SAMPLES * sizeof(uint16_t))));
+static const uint32_t block_samples = ANALOG_BLOCK_SAMPLES;  ///< Lido pelo canal de controle
+static int dma_data_chan = -1;
+static int dma_ctrl_chan = -1;
+static int8_t channel_slot[5] = {-1, -1, -1, -1, -1};  ///< Posição de cada canal no rodízio
+static uint32_t resyncs = 0;
+
+/**
+ * @brief Conversões transferidas no bloco atual
+ */
+static inline uint32_t transfers_done(void) {
+    return block_samples - dma_hw->ch[dma_data_chan].transfer_count;
+}
+/**
+ * @brief (Re)inicia o ADC e o DMA a partir do primeiro canal do rodízio
+ */
+static void analog_start(void) {
+    adc_run(false);
+    dma_channel_abort(dma_data_chan);
+    dma_channel_abort(dma_ctrl_chan);
+    adc_fifo_drain();
+    adc_hw->fcs |= ADC_FCS_OVER_BITS | ADC_FCS_UNDER_BITS;  // limpa os indicadores (W1C)
+
+    dma_channel_set_write_addr(dma_data_chan, ring, false);
+    dma_channel_set_trans_count(dma_data_chan, block_samples, true);
+
+    for (unsigned ch = 0; ch < 5; ch++) {
+        if (ANALOG_CHANNEL_MASK & (1u << ch)) {
+            adc_select_input(ch);
+            break;
+        }
+    }
+    adc_set_round_robin(ANALOG_CHANNEL_MASK);
+    adc_run(true);
+
+    // Primeira janela completa antes de liberar as leituras
+    while (transfers_done() < (ANALOG_OVERSAMPLE + 2) * ANALOG_NUM_CHANNELS) {
+        tight_loop_contents();
+    }
+}
+/**
+ * @brief Configura os canais, o rodízio do ADC e o DMA e inicia a aquisição
+ */
+void analog_init() {
+    int slot = 0;
+    for (unsigned ch = 0; ch < 5; ch++) {
+        if (!(ANALOG_CHANNEL_MASK & (1u << ch))) continue;
+        channel_slot[ch] = (int8_t)slot++;
+        if (ch < 4) adc_gpio_init(26 + ch);
+    }
+
+    adc_init();
+    adc_set_temp_sensor_enabled(ANALOG_CHANNEL_MASK & (1u << ANALOG_TEMPERATURE));
+    adc_fifo_setup(true, true, 1, false, false);
+    // Clock do ADC de 48 MHz: uma conversão a cada (1 + div) ciclos
+    adc_set_clkdiv(48000000.0f / ANALOG_SAMPLE_RATE_HZ - 1);
+
+    dma_data_chan = dma_claim_unused_channel(true);
+    dma_ctrl_chan = dma_claim_unused_channel(true);
+
+    dma_channel_config c = dma_channel_get_default_config(dma_data_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, ANALOG_RING_BITS);
+    channel_config_set_dreq(&c, DREQ_ADC);
+    channel_config_set_chain_to(&c, dma_ctrl_chan);
+    dma_channel_configure(dma_data_chan, &c, ring, &adc_hw->fifo, block_samples, false);
+
+    c = dma_channel_get_default_config(dma_ctrl_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    dma_channel_configure(dma_ctrl_chan, &c, &dma_hw->ch[dma_data_chan].al1_transfer_count_trig,
+                          &block_samples, 1, false);
+
+    analog_start();
+}
+/**
+ * @brief Leitura filtrada mais recente de um canal
+ *
+ * Um estouro do FIFO (conversão perdida) desalinharia o rodízio; nesse
+ * caso a aquisição é reiniciada antes da leitura.
+ */
+uint32_t analog_get(unsigned channel) {
+    if (channel >= 5 || channel_slot[channel] < 0 || dma_data_chan < 0) return 0;
+    if (adc_hw->fcs & ADC_FCS_OVER_BITS) {
+        resyncs++;
+        analog_start();
+    }
+    uint32_t first = analog_window_first(transfers_done(), (uint32_t)channel_slot[channel],
+                                         ANALOG_NUM_CHANNELS, ANALOG_OVERSAMPLE, block_samples);
+    return analog_decimate(ring, ANALOG_RING_SAMPLES - 1, first, ANALOG_NUM_CHANNELS,
+                           ANALOG_OVERSAMPLE, ANALOG_EXTRA_BITS);
+}
+/**
+ * @brief Reinícios da aquisição por estouro do FIFO do ADC
+ */
+uint32_t analog_get_resyncs() {
+    return resyncs;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file analog.h
+ * @brief Aquisição contínua do ADC por DMA, com sobreamostragem
+ *
+ * O ADC converte em rodízio (round-robin) os canais configurados, sem
+ * parar, e um canal DMA copia o FIFO do ADC para um buffer circular em
+ * RAM. Um segundo canal DMA recarrega o contador do primeiro ao fim de
+ * cada bloco, sem interrupção nem intervenção da CPU.
+ *
+ * Os consumidores leem o valor mais recente de um canal já filtrado: a
+ * média das últimas ANALOG_OVERSAMPLE conversões do canal, com
+ * ANALOG_EXTRA_BITS bits a mais de resolução efetiva. A leitura nunca
+ * espera por uma conversão.
+ *
+ * As funções de cálculo deste cabeçalho não dependem do hardware e são
+ * testadas no host (host/test_analog.c).
+ */
+#ifndef ANALOG_H
+#define ANALOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fixed.h"
+
+/** @defgroup AnalogChannels Canais do ADC
+ * @{
+ */
+#define ANALOG_JOY_Y 0          ///< GPIO 26
+#define ANALOG_JOY_X 1          ///< GPIO 27
+#define ANALOG_TEMPERATURE 4    ///< Sensor de temperatura interno
+/** @} */
+
+/** Canais em rodízio (bit i = canal i), convertidos em ordem crescente */
+#define ANALOG_CHANNEL_MASK ((1u << ANALOG_JOY_Y) | (1u << ANALOG_JOY_X) | (1u << ANALOG_TEMPERATURE))
+#define ANALOG_NUM_CHANNELS 3
+
+#define ANALOG_SAMPLE_RATE_HZ 48000  ///< Conversões por segundo (todos os canais)
+#define ANALOG_OVERSAMPLE 16         ///< Conversões somadas por leitura (potência de 4)
+#define ANALOG_RING_SAMPLES 256      ///< Buffer circular do DMA (potência de 2)
+#define ANALOG_RING_BITS 9           ///< log2 do tamanho do buffer em bytes
+
+#define ANALOG_ADC_BITS 12
+#define ANALOG_EXTRA_BITS 2          ///< log4(ANALOG_OVERSAMPLE)
+#define ANALOG_RESULT_BITS (ANALOG_ADC_BITS + ANALOG_EXTRA_BITS)
+#define ANALOG_FULL_SCALE ((1u << ANALOG_RESULT_BITS) - 1)
+
+/** Converte um limiar de 12 bits (adc_read) para a escala das leituras */
+#define ANALOG_FROM_12BIT(v) ((uint32_t)(v) << ANALOG_EXTRA_BITS)
+
+/**
+ * Conversões por bloco do DMA: múltiplo do buffer e do número de canais,
+ * para que a posição no bloco determine a posição no buffer e o canal
+ */
+#define ANALOG_BLOCK_SAMPLES (ANALOG_RING_SAMPLES * ANALOG_NUM_CHANNELS * 1024u)
+
+_Static_assert((1u << ANALOG_RING_BITS) == ANALOG_RING_SAMPLES * sizeof(uint16_t), "ANALOG_RING_BITS incoerente");
+_Static_assert((1u << (2 * ANALOG_EXTRA_BITS)) == ANALOG_OVERSAMPLE, "ANALOG_OVERSAMPLE deve ser 4^ANALOG_EXTRA_BITS");
+_Static_assert(ANALOG_NUM_CHANNELS * (ANALOG_OVERSAMPLE + 1) < ANALOG_RING_SAMPLES, "buffer pequeno para a janela");
+
+/**
+ * @brief Soma count conversões do buffer, espaçadas de stride, e reduz
+ * a escala para ANALOG_ADC_BITS + extra_bits bits
+ *
+ * Sobreamostragem por 4^n dá n bits efetivos: a soma de 4^n amostras de
+ * 12 bits tem 12 + 2n bits, mas o ruído (não correlacionado) cresce 2^n
+ * vezes, então só n desses bits são úteis e o deslocamento de n descarta
+ * os demais.
+ *
+ * @param ring Buffer circular de conversões
+ * @param ring_mask Tamanho do buffer − 1 (potência de 2)
+ * @param first Índice da conversão mais antiga da janela
+ * @param stride Distância entre conversões do mesmo canal
+ * @param count Conversões na janela (potência de 2)
+ * @param extra_bits Bits acrescentados à resolução do ADC
+ */
+static inline uint32_t analog_decimate(const volatile uint16_t *ring, uint32_t ring_mask, uint32_t first,
+                                       uint32_t stride, uint32_t count, unsigned extra_bits) {
+    uint32_t sum = 0;
+    unsigned log2_count = 0;
+    while ((1u << log2_count) < count) log2_count++;
+    for (uint32_t k = 0; k < count; k++) {
+        sum += ring[(first + k * stride) & ring_mask] & 0x0FFF;
+    }
+    return sum >> (log2_count - extra_bits);
+}
+
+/**
+ * @brief Índice da conversão mais antiga de um canal na janela mais recente
+ *
+ * @param done Conversões já transferidas no bloco atual do DMA
+ * @param slot Posição do canal na ordem do rodízio (0 a channels − 1)
+ * @param channels Canais no rodízio
+ * @param count Conversões do canal na janela
+ * @param block Conversões por bloco (múltiplo de channels)
+ * @return Índice no bloco (0 a block − 1); reduzir pelo tamanho do buffer
+ *
+ * A rodada em andamento e a anterior são ignoradas: a última conversão
+ * contada pelo DMA pode ainda não ter sido escrita.
+ */
+static inline uint32_t analog_window_first(uint32_t done, uint32_t slot, uint32_t channels,
+                                           uint32_t count, uint32_t block) {
+    uint32_t round_start = done - done % channels;  // início da rodada em andamento
+    return (round_start + block - (count + 1) * channels + slot) % block;
+}
+
+/**
+ * @brief Temperatura do sensor interno (RP2040) a partir da leitura filtrada
+ *
+ * T = 27 − (V − 0,706 V) / 0,001721 V/°C, com referência de 3,3 V.
+ *
+ * @param raw Leitura com ANALOG_RESULT_BITS bits
+ * @return Temperatura em °C (Q23.8)
+ */
+static inline fix_t analog_temperature(uint32_t raw) {
+    int64_t microvolts = (int64_t)raw * 3300000 / (ANALOG_FULL_SCALE + 1);
+    return FIX_FROM_INT(27) - (fix_t)(((microvolts - 706000) * FIX_ONE) / 1721);
+}
+
+/**
+ * @brief Configura os canais, o rodízio do ADC e o DMA e inicia a aquisição
+ *
+ * Aguarda a primeira janela completa (cerca de 1 ms).
+ */
+void analog_init(void);
+
+/**
+ * @brief Leitura filtrada mais recente de um canal
+ * @param channel Canal do ADC (ANALOG_JOY_X, ANALOG_JOY_Y, ANALOG_TEMPERATURE)
+ * @return Valor com ANALOG_RESULT_BITS bits (0 se o canal não estiver no rodízio)
+ */
+uint32_t analog_get(unsigned channel);
+
+/**
+ * @brief Reinícios da aquisição por estouro do FIFO do ADC
+ */
+uint32_t analog_get_resyncs(void);
+
+#endif // ANALOG_H
@@ -0,0 +1,106 @@
+/**
+ * @file anomaly.c
+ * @brief Detectores incrementais de anomalia por sensor
+ *
+ * Média e variância ficam em Q.16 (8 bits além do fix_t) para que o
+ * passo 1/2^shift não seja perdido por truncamento. O z-score é testado
+ * sem raiz nem divisão: d² > z²·var.
+ */
+#include "anomaly.h"
+#include <stddef.h>
+#include <string.h>
+
+static const char *const rule_names[ANOMALY_RULE_COUNT] = {
+    "faixa", "z", "cusum+", "cusum-", "taxa"
+};
+
+void anomaly_init(anomaly_state_t *state) {
+    memset(state, 0, sizeof(*state));
+}
+/**
+ * @brief Soma acumulada com piso zero, saturada para não transbordar
+ */
+static inline fix_t cusum_step(fix_t sum, int64_t increment) {
+    int64_t next = (int64_t)sum + increment;
+    if (next < 0) return 0;
+    return next > INT32_MAX ? INT32_MAX : (fix_t)next;
+}
+uint8_t anomaly_update(anomaly_state_t *state, const anomaly_config_t *config, fix_t value, uint32_t now_ms) {
+    if (config == NULL) return 0;
+    uint8_t rules = 0;
+
+    if (state->samples == 0) {
+        state->mean = (int64_t)value << FIX_FRAC_BITS;
+        state->var = 0;
+        state->last = value;
+        state->last_ms = now_ms;
+        state->samples = 1;
+        return 0;
+    }
+
+    uint32_t dt_ms = now_ms - state->last_ms;
+    if (config->rate_max > 0 && dt_ms > 0) {
+        int64_t step = (int64_t)value - state->last;
+        if (step < 0) step = -step;
+        // |Δx|/Δt > rate_max, com Δt em ms
+        if (step * 1000 > (int64_t)config->rate_max * dt_ms) rules |= ANOMALY_RATE;
+    }
+
+    int64_t d = (int64_t)value - anomaly_mean(state);
+    int64_t d_sq = d * d;  // Q.16
+    if (state->samples >= config->warmup) {
+        if (config->z_limit > 0) {
+            int64_t var = state->var;
+            int64_t floor = (int64_t)config->sigma_min * config->sigma_min;
+            if (var < floor) var = floor;
+            int64_t z_sq = (int64_t)config->z_limit * config->z_limit;
+            if (d_sq > ((z_sq * var) >> (2 * FIX_FRAC_BITS))) rules |= ANOMALY_ZSCORE;
+        }
+        if (config->cusum_h > 0) {
+            state->cusum_hi = cusum_step(state->cusum_hi, d - config->cusum_k);
+            state->cusum_lo = cusum_step(state->cusum_lo, -d - config->cusum_k);
+            if (state->cusum_hi > config->cusum_h) {
+                rules |= ANOMALY_CUSUM_UP;
+                state->cusum_hi = 0;
+            }
+            if (state->cusum_lo > config->cusum_h) {
+                rules |= ANOMALY_CUSUM_DOWN;
+                state->cusum_lo = 0;
+            }
+        }
+    }
+
+    // EWMA: m += (x − m)/2^s; v += (d² − v)/2^s
+    int64_t diff = ((int64_t)value << FIX_FRAC_BITS) - state->mean;
+    state->mean += diff >> config->ewma_shift;
+    state->var += (d_sq - state->var) >> config->ewma_shift;
+
+    state->last = value;
+    state->last_ms = now_ms;
+    if (state->samples < UINT32_MAX) state->samples++;
+    return rules;
+}
+fix_t anomaly_mean(const anomaly_state_t *state) {
+    return (fix_t)(state->mean >> FIX_FRAC_BITS);
+}
+fix_t anomaly_stddev(const anomaly_state_t *state) {
+    return (fix_t)fix_isqrt64((uint64_t)state->var);
+}
+const char *anomaly_rule_name(uint8_t rule) {
+    for (int i = 0; i < ANOMALY_RULE_COUNT; i++) {
+        if (rule == (1u << i)) return rule_names[i];
+    }
+    return "?";
+}
+char *anomaly_format_rules(uint8_t rules, char *buf, int size) {
+    int len = 0;
+    buf[0] = '\0';
+    for (int i = 0; i < ANOMALY_RULE_COUNT && len < size - 1; i++) {
+        if (!(rules & (1u << i))) continue;
+        const char *name = rule_names[i];
+        if (len > 0) buf[len++] = '+';
+        while (*name && len < size - 1) buf[len++] = *name++;
+        buf[len] = '\0';
+    }
+    return buf;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file anomaly.h
+ * @brief Detectores incrementais de anomalia por sensor
+ *
+ * Além dos limiares fixos do driver, cada leitura passa por três regras
+ * com memória fixa e custo O(1) por amostra, todas em ponto fixo:
+ *
+ * - z-score sobre média e variância exponenciais (EWMA): salto brusco
+ *   em relação ao comportamento recente, mesmo dentro dos limiares;
+ * - CUSUM bilateral em torno da média exponencial: deriva lenta e
+ *   persistente, acumulando desvios maiores que a folga k até h;
+ * - taxa de variação entre amostras consecutivas, em unidades por
+ *   segundo.
+ *
+ * A regra compara a amostra com as estatísticas anteriores a ela, que
+ * só então são atualizadas. z-score e CUSUM aguardam `warmup` amostras.
+ */
+#ifndef ANOMALY_H
+#define ANOMALY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fixed.h"
+
+/** @defgroup AnomalyRules Regras que dispararam (bits)
+ * @{
+ */
+#define ANOMALY_RANGE       (1u << 0)  ///< Fora de [anomaly_min, anomaly_max]
+#define ANOMALY_ZSCORE      (1u << 1)  ///< |x − média| > z_limit·desvio
+#define ANOMALY_CUSUM_UP    (1u << 2)  ///< Deriva acima da média
+#define ANOMALY_CUSUM_DOWN  (1u << 3)  ///< Deriva abaixo da média
+#define ANOMALY_RATE        (1u << 4)  ///< Variação mais rápida que rate_max
+#define ANOMALY_RULE_COUNT  5
+/** @} */
+
+/**
+ * @brief Parâmetros dos detectores de um sensor
+ *
+ * Limites iguais a zero desligam a regra correspondente.
+ */
+typedef struct {
+    uint8_t ewma_shift;  ///< Peso da amostra na média: 1/2^ewma_shift
+    uint8_t warmup;      ///< Amostras antes de avaliar z-score e CUSUM
+    fix_t z_limit;       ///< Desvios padrão para o z-score
+    fix_t sigma_min;     ///< Piso do desvio padrão (evita z enorme com sinal constante)
+    fix_t cusum_k;       ///< Folga do CUSUM (desvio tolerado por amostra)
+    fix_t cusum_h;       ///< Limiar de decisão do CUSUM
+    fix_t rate_max;      ///< Variação máxima, em unidades por segundo
+} anomaly_config_t;
+
+/**
+ * @brief Estado dos detectores de um sensor
+ */
+typedef struct {
+    int64_t mean;        ///< Média exponencial (Q.16)
+    int64_t var;         ///< Variância exponencial (Q.16, unidade²)
+    fix_t cusum_hi;      ///< Soma acumulada acima da média
+    fix_t cusum_lo;      ///< Soma acumulada abaixo da média
+    fix_t last;          ///< Amostra anterior
+    uint32_t last_ms;    ///< Instante da amostra anterior
+    uint32_t samples;    ///< Amostras processadas
+} anomaly_state_t;
+
+/**
+ * @brief Zera o estado dos detectores
+ */
+void anomaly_init(anomaly_state_t *state);
+
+/**
+ * @brief Processa uma amostra
+ * @param state Estado do sensor
+ * @param config Parâmetros (NULL = nenhuma regra estatística)
+ * @param value Amostra
+ * @param now_ms Instante da amostra (ms desde o boot)
+ * @return Regras que dispararam (ANOMALY_*, sem ANOMALY_RANGE)
+ */
+uint8_t anomaly_update(anomaly_state_t *state, const anomaly_config_t *config, fix_t value, uint32_t now_ms);
+
+/**
+ * @brief Média exponencial atual
+ */
+fix_t anomaly_mean(const anomaly_state_t *state);
+
+/**
+ * @brief Desvio padrão exponencial atual
+ */
+fix_t anomaly_stddev(const anomaly_state_t *state);
+
+/**
+ * @brief Nome curto de uma regra (um único bit ANOMALY_*)
+ */
+const char *anomaly_rule_name(uint8_t rule);
+
+/**
+ * @brief Escreve os nomes das regras separados por '+'
+ * @param rules Bits ANOMALY_*
+ * @param buf Destino
+ * @param size Tamanho de buf
+ * @return buf
+ */
+char *anomaly_format_rules(uint8_t rules, char *buf, int size);
+
+#endif // ANOMALY_H
@@ -0,0 +1,268 @@
+/**
+ * @file audio.c
+ * @brief Motor de áudio não bloqueante para o buzzer
+ *
+ * A fila de notas é protegida por uma seção crítica (spin lock e
+ * interrupções desabilitadas), então pode ser alimentada de qualquer
+ * núcleo. O PWM só é tocado pela callback do alarme, que executa no
+ * núcleo que chamou audio_init(). Cada disparo devolve a duração da nota
+ * aplicada, e o SDK reagenda o alarme a partir do instante previsto do
+ * disparo anterior — a sequência não acumula deriva.
+ */
+#include "audio.h"
+#include "pico/stdlib.h"
+#include "pico/time.h"
+#include "pico/critical_section.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "hardware/gpio.h"
+#include "profile.h"
+
+/** Nenhuma sequência tocando */
+#define AUDIO_IDLE -1
+
+/** Atraso do primeiro disparo de uma sequência (us) */
+#define AUDIO_START_DELAY_US 20
+
+static uint buzzer_pin;
+static uint buzzer_slice;
+static alarm_pool_t *pool;
+static critical_section_t lock;
+
+// Fila circular de notas (protegida por lock)
+static audio_note_t queue[AUDIO_QUEUE_SIZE];
+static uint queue_head = 0;
+static uint queue_tail = 0;
+static volatile int queue_priority = AUDIO_IDLE;  ///< Prioridade das notas da fila e da nota atual
+
+static alarm_id_t alarm_id = 0;
+static uint32_t generation = 0;          ///< Invalida cadeias de alarme substituídas
+
+static inline uint queue_count(void) {
+    return (queue_head - queue_tail) % AUDIO_QUEUE_SIZE;
+}
+/**
+ * @brief Programa o PWM para uma nota
+ *
+ * O contador do PWM tem 16 bits; o divisor inteiro é escolhido para que
+ * o wrap caiba nele mesmo nas frequências graves.
+ */
+static void buzzer_apply(const audio_note_t *note) {
+    if (note->frequency == 0 || note->duty == 0) {
+        pwm_set_gpio_level(buzzer_pin, 0);
+        return;
+    }
+    uint32_t clock = clock_get_hz(clk_sys);
+    uint32_t div = clock / ((uint32_t)note->frequency * 65536u) + 1;
+    if (div > 255) div = 255;
+    uint32_t wrap = clock / (div * note->frequency) - 1;
+    if (wrap > 0xFFFF) wrap = 0xFFFF;
+
+    pwm_set_clkdiv_int_frac(buzzer_slice, div, 0);
+    pwm_set_wrap(buzzer_slice, wrap);
+    pwm_set_gpio_level(buzzer_pin, (uint16_t)(wrap * note->duty / 100));
+}
+/**
+ * @brief Aplica a próxima nota da fila
+ *
+ * @param chain Geração da cadeia de alarmes que disparou
+ * @return Duração da nota em us (reagenda), ou 0 com a fila vazia
+ */
+static int64_t audio_advance(uint32_t chain) {
+    critical_section_enter_blocking(&lock);
+    if (chain != generation) {
+        // Cadeia substituída por uma sequência de prioridade maior
+        critical_section_exit(&lock);
+        return 0;
+    }
+    if (queue_head == queue_tail) {
+        pwm_set_gpio_level(buzzer_pin, 0);
+        queue_priority = AUDIO_IDLE;
+        alarm_id = 0;
+        critical_section_exit(&lock);
+        return 0;
+    }
+    audio_note_t note = queue[queue_tail];
+    queue_tail = (queue_tail + 1) % AUDIO_QUEUE_SIZE;
+    buzzer_apply(&note);
+    critical_section_exit(&lock);
+
+    // Nota de duração zero: dispara de novo logo em seguida
+    return note.duration_ms ? (int64_t)note.duration_ms * 1000 : 1;
+}
+/**
+ * @brief Callback do alarme: aplica a próxima nota da fila
+ */
+static int64_t audio_alarm_callback(alarm_id_t id, void *user_data) {
+    (void)id;
+    PROFILE_BEGIN(start_us);
+    int64_t next = audio_advance((uint32_t)(uintptr_t)user_data);
+    PROFILE_END(PROFILE_AUDIO_IRQ, start_us);
+    return next;
+}
+/**
+ * @brief Nova cadeia de alarmes pedida com o lock tomado
+ */
+typedef struct {
+    uint32_t chain;        ///< Geração da nova cadeia
+    alarm_id_t previous;   ///< Alarme da cadeia substituída (0 = nenhum)
+} audio_restart_t;
+
+/**
+ * @brief Registra uma nova cadeia de alarmes (chamada com lock tomado)
+ *
+ * Só troca a geração e guarda o alarme a cancelar; o pool de alarmes é
+ * chamado depois, por audio_schedule(), já sem o lock.
+ */
+static audio_restart_t audio_restart_locked(void) {
+    audio_restart_t restart = {++generation, alarm_id};
+    alarm_id = 0;
+    return restart;
+}
+/**
+ * @brief Cancela a cadeia anterior e agenda a nova (chamada sem o lock)
+ *
+ * O pool de alarmes e a seção crítica usam spin locks do mesmo banco;
+ * se caíssem no mesmo, tomar um dentro do outro travaria o núcleo com as
+ * interrupções desligadas. Uma cadeia que dispare entre a saída do lock
+ * e este agendamento (a anterior, ou esta, se um pedido mais novo já a
+ * substituiu) vê a geração trocada e termina sozinha. O primeiro disparo
+ * nunca é executado no contexto de quem chamou, para que o PWM continue
+ * sendo acessado só pelo núcleo do alarme.
+ *
+ * Se o pool de alarmes estiver cheio, nada faria a fila andar e
+ * audio_busy() ficaria verdadeiro para sempre: a fila é descartada, o
+ * buzzer silenciado e o motor volta a ocioso.
+ *
+ * @return false se não houver alarme livre
+ */
+static bool audio_schedule(audio_restart_t restart) {
+    if (restart.previous > 0) {
+        alarm_pool_cancel_alarm(pool, restart.previous);
+    }
+    uint64_t delay = AUDIO_START_DELAY_US;
+    alarm_id_t id;
+    while ((id = alarm_pool_add_alarm_in_us(pool, delay, audio_alarm_callback,
+                                            (void *)(uintptr_t)restart.chain, false)) == 0) {
+        delay *= 2;
+    }
+
+    critical_section_enter_blocking(&lock);
+    bool current = restart.chain == generation;
+    if (current && id > 0) {
+        alarm_id = id;
+    } else if (current) {
+        queue_tail = queue_head;
+        pwm_set_gpio_level(buzzer_pin, 0);
+        queue_priority = AUDIO_IDLE;
+    }
+    critical_section_exit(&lock);
+    return id > 0 || !current;
+}
+/**
+ * @brief Inicializa o PWM do buzzer e o alarme do motor de áudio
+ */
+void audio_init(uint pin) {
+    buzzer_pin = pin;
+    buzzer_slice = pwm_gpio_to_slice_num(pin);
+    gpio_set_function(pin, GPIO_FUNC_PWM);
+    pwm_set_wrap(buzzer_slice, 255);
+    pwm_set_clkdiv(buzzer_slice, 1.0f);
+    pwm_set_gpio_level(pin, 0);
+    pwm_set_enabled(buzzer_slice, true);
+
+    critical_section_init(&lock);
+#if MONITOR_DUAL_CORE
+    // Pool próprio: o IRQ do alarme é habilitado no núcleo que o cria
+    pool = alarm_pool_create_with_unused_hardware_alarm(4);
+#else
+    pool = alarm_pool_get_default();
+#endif
+}
+/**
+ * @brief Enfileira uma sequência de notas
+ *
+ * Prioridade maior que a atual descarta a fila e interrompe a nota em
+ * execução; prioridade igual é anexada ao fim; menor é ignorada.
+ */
+bool audio_play(const audio_note_t *notes, size_t count, audio_priority_t priority) {
+    if (count == 0 || count >= AUDIO_QUEUE_SIZE) return false;
+
+    PROFILE_BEGIN(start_us);
+    critical_section_enter_blocking(&lock);
+    bool idle = queue_priority == AUDIO_IDLE;
+    if (!idle && (int)priority < queue_priority) {
+        critical_section_exit(&lock);
+        PROFILE_END(PROFILE_AUDIO_QUEUE, start_us);
+        return false;
+    }
+    bool preempt = !idle && (int)priority > queue_priority;
+    if (preempt) {
+        queue_tail = queue_head;
+    } else if (queue_count() + count >= AUDIO_QUEUE_SIZE) {
+        critical_section_exit(&lock);
+        PROFILE_END(PROFILE_AUDIO_QUEUE, start_us);
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        queue[queue_head] = notes[i];
+        queue_head = (queue_head + 1) % AUDIO_QUEUE_SIZE;
+    }
+    queue_priority = priority;
+    bool restart_needed = idle || preempt;
+    audio_restart_t restart = {0, 0};
+    if (restart_needed) {
+        restart = audio_restart_locked();
+    }
+    critical_section_exit(&lock);
+
+    bool started = restart_needed ? audio_schedule(restart) : true;
+    PROFILE_END(PROFILE_AUDIO_QUEUE, start_us);
+    return started;
+}
+/**
+ * @brief Enfileira uma única nota
+ */
+bool audio_tone(uint frequency, uint duration_ms, uint8_t duty, audio_priority_t priority) {
+    audio_note_t note = {
+        .frequency = (uint16_t)frequency,
+        .duration_ms = (uint16_t)(duration_ms > 0xFFFF ? 0xFFFF : duration_ms),
+        .duty = duty > 100 ? 100 : duty
+    };
+    return audio_play(&note, 1, priority);
+}
+/**
+ * @brief Interrompe a sequência atual se ela tiver a prioridade dada
+ *
+ * Enfileira uma pausa de duração zero no lugar da sequência, para que o
+ * silêncio também seja aplicado pelo núcleo do alarme.
+ */
+void audio_cancel(audio_priority_t priority) {
+    critical_section_enter_blocking(&lock);
+    bool cancel = queue_priority == (int)priority;
+    audio_restart_t restart = {0, 0};
+    if (cancel) {
+        queue_tail = queue_head;
+        queue[queue_head] = (audio_note_t){0, 0, 0};
+        queue_head = (queue_head + 1) % AUDIO_QUEUE_SIZE;
+        queue_priority = AUDIO_IDLE;
+        restart = audio_restart_locked();
+    }
+    critical_section_exit(&lock);
+    if (cancel) {
+        audio_schedule(restart);
+    }
+}
+/**
+ * @brief Verifica se há nota tocando ou pendente
+ */
+bool audio_busy() {
+    return queue_priority != AUDIO_IDLE;
+}
+/**
+ * @brief Toca um tom curto de realimentação (prioridade AUDIO_PRIO_CLICK)
+ */
+void play_tone(uint frequency, uint duration) {
+    audio_tone(frequency, duration, AUDIO_DUTY_DEFAULT, AUDIO_PRIO_CLICK);
+}
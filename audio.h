@@ -0,0 +1,99 @@
+/**
+ * @file audio.h
+ * @brief Motor de áudio não bloqueante para o buzzer
+ *
+ * As notas (frequência, duração, ciclo de trabalho) são enfileiradas e
+ * tocadas por um alarme de hardware: cada disparo aplica a próxima nota no
+ * PWM e reagenda o alarme para o fim dela. As chamadas públicas retornam
+ * imediatamente. Uma sequência de prioridade maior interrompe a atual e
+ * descarta as notas pendentes; sequências de prioridade menor que a em
+ * execução são ignoradas.
+ */
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "pico/stdlib.h"
+
+/** Capacidade da fila de notas */
+#define AUDIO_QUEUE_SIZE 32
+
+/** Ciclo de trabalho padrão (%) — onda quadrada */
+#define AUDIO_DUTY_DEFAULT 50
+
+/**
+ * @brief Prioridades das sequências sonoras
+ */
+typedef enum {
+    AUDIO_PRIO_MUSIC = 0,   ///< Música de inicialização
+    AUDIO_PRIO_CLICK,       ///< Realimentação de menu e botões
+    AUDIO_PRIO_ALERT,       ///< Alertas de anomalia e vida silvestre
+    AUDIO_PRIO_SOS          ///< Padrão SOS de incêndio
+} audio_priority_t;
+
+/**
+ * @brief Nota musical
+ */
+typedef struct {
+    uint16_t frequency;    ///< Frequência em Hz (0 = pausa)
+    uint16_t duration_ms;  ///< Duração em milissegundos
+    uint8_t duty;          ///< Ciclo de trabalho do PWM (0-100 %)
+} audio_note_t;
+
+/**
+ * @brief Inicializa o PWM do buzzer e o alarme do motor de áudio
+ *
+ * O alarme dispara no núcleo que chamar esta função; as demais funções
+ * podem ser chamadas de qualquer núcleo.
+ * @param pin Pino do buzzer
+ */
+void audio_init(uint pin);
+
+/**
+ * @brief Enfileira uma sequência de notas
+ *
+ * @param notes Notas da sequência
+ * @param count Quantidade de notas
+ * @param priority Prioridade da sequência
+ * @return false se descartada (prioridade menor que a atual, fila cheia ou
+ *         nenhum alarme livre)
+ */
+bool audio_play(const audio_note_t *notes, size_t count, audio_priority_t priority);
+
+/**
+ * @brief Enfileira uma única nota
+ *
+ * @param frequency Frequência em Hz (0 = pausa)
+ * @param duration_ms Duração em milissegundos
+ * @param duty Ciclo de trabalho (0-100 %)
+ * @param priority Prioridade
+ * @return false se descartada
+ */
+bool audio_tone(uint frequency, uint duration_ms, uint8_t duty, audio_priority_t priority);
+
+/**
+ * @brief Interrompe a sequência atual se ela tiver a prioridade dada
+ *
+ * Sequências de outras prioridades não são afetadas (ex.: o fim do SOS
+ * não corta um clique de menu que esteja tocando).
+ * @param priority Prioridade da sequência a interromper
+ */
+void audio_cancel(audio_priority_t priority);
+
+/**
+ * @brief Verifica se há nota tocando ou pendente
+ */
+bool audio_busy(void);
+
+/**
+ * @brief Toca um tom curto de realimentação (prioridade AUDIO_PRIO_CLICK)
+ *
+ * Não bloqueia: a nota é enfileirada e a função retorna imediatamente.
+ * @param frequency Frequência do tom em Hz (0 = pausa)
+ * @param duration Duração em milissegundos
+ */
+void play_tone(uint frequency, uint duration);
+
+#endif // AUDIO_H
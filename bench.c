@@ -0,0 +1,252 @@
+/**
+ * @file bench.c
+ * @brief Microbenchmarks dos caminhos críticos (MONITOR_BENCHMARK)
+ *
+ * As iterações são agrupadas em lotes que dobram de tamanho, e o timer é
+ * lido só entre lotes: a leitura de 64 bits do timer (e, no host, o
+ * avanço da HAL) fica fora do custo por operação.
+ */
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#include "ssd1306.h"
+#include "neopixel.h"
+#include "outputs.h"
+#include "history.h"
+#include "sensor.h"
+#include "sensor_sim.h"
+
+#ifdef MONITOR_HOST
+#define BENCH_PLATFORM "host"
+#else
+#define BENCH_PLATFORM "rp2040"
+#endif
+
+/**
+ * @brief Imprime total / iterations com duas casas decimais (vazio se zero)
+ */
+static void print_per_op(uint32_t total, uint32_t iterations) {
+    if (total == 0) return;
+    uint64_t hundredths = (uint64_t)total * 100u / iterations;
+    printf("%lu.%02lu", (unsigned long)(hundredths / 100), (unsigned long)(hundredths % 100));
+}
+void bench_header(void) {
+    printf("BENCH,plataforma,caso,iteracoes,ns_op,ciclos_op,i2c_bytes_quadro,pio_palavras_quadro\n");
+#ifndef MONITOR_HOST
+    printf("CICLOS,plataforma,caso,amostras,media,minimo,maximo\n");
+#endif
+}
+void bench_case(const char *name, bench_fn_t fn, void *ctx) {
+    fn(ctx, 0);
+
+    uint32_t i2c_start = ssd1306_get_total_bytes();
+    uint32_t frames_start = neopixel_get_frames_sent();
+    uint32_t iterations = 0;
+    uint64_t elapsed_us = 0;
+    for (uint32_t batch = 1; elapsed_us < BENCH_MIN_US; batch *= 2) {
+        uint64_t start = time_us_64();
+        for (uint32_t i = 0; i < batch; i++) {
+            fn(ctx, iterations + 1 + i);
+        }
+        elapsed_us += time_us_64() - start;
+        iterations += batch;
+    }
+    uint32_t i2c_bytes = ssd1306_get_total_bytes() - i2c_start;
+    uint32_t pio_words = (neopixel_get_frames_sent() - frames_start) * NUM_PIXELS;
+
+    printf("BENCH," BENCH_PLATFORM ",%s,%lu,%lu,", name, (unsigned long)iterations,
+           (unsigned long)(elapsed_us * 1000 / iterations));
+#ifndef MONITOR_HOST
+    printf("%lu", (unsigned long)(elapsed_us * clock_get_hz(clk_sys) / 1000000u / iterations));
+#endif
+    printf(",");
+    print_per_op(i2c_bytes, iterations);
+    printf(",");
+    print_per_op(pio_words, iterations);
+    printf("\n");
+}
+#ifndef MONITOR_HOST
+/**
+ * @brief Lê o contador do SysTick (24 bits, decrescente, clock do processador)
+ */
+static inline uint32_t systick_now(void) {
+    return systick_hw->cvr;
+}
+/**
+ * @brief Ciclos de uma chamada isolada, já descontada a própria medição
+ */
+static inline uint32_t cycles_of(bench_fn_t fn, void *ctx, uint32_t i, uint32_t overhead) {
+    uint32_t start = systick_now();
+    fn(ctx, i);
+    uint32_t cycles = (start - systick_now()) & 0x00FFFFFF;
+    return cycles > overhead ? cycles - overhead : 0;
+}
+static void bench_empty(void *ctx, uint32_t i) {
+    (void)ctx;
+    (void)i;
+}
+#endif
+void bench_cycles(const char *name, bench_fn_t fn, void *ctx, uint32_t samples) {
+#ifdef MONITOR_HOST
+    (void)name;
+    (void)fn;
+    (void)ctx;
+    (void)samples;
+#else
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;  // ENABLE | CLKSOURCE (processador)
+
+    // Custo da leitura do contador e da chamada indireta
+    uint32_t overhead = UINT32_MAX;
+    for (uint32_t i = 0; i < 16; i++) {
+        uint32_t cycles = cycles_of(bench_empty, NULL, i, 0);
+        if (cycles < overhead) overhead = cycles;
+    }
+
+    fn(ctx, 0);
+    uint64_t total = 0;
+    uint32_t best = UINT32_MAX, worst = 0;
+    for (uint32_t i = 1; i <= samples; i++) {
+        uint32_t cycles = cycles_of(fn, ctx, i, overhead);
+        total += cycles;
+        if (cycles < best) best = cycles;
+        if (cycles > worst) worst = cycles;
+    }
+    systick_hw->csr = 0;
+
+    printf("CICLOS," BENCH_PLATFORM ",%s,%lu,%lu,%lu,%lu\n", name, (unsigned long)samples,
+           (unsigned long)(total / samples), (unsigned long)best, (unsigned long)worst);
+#endif
+}
+
+/**
+ * @brief Estado do caminho de referência em float (implementação anterior)
+ */
+typedef struct {
+    float min_val, max_val, anomaly_min, anomaly_max, variation, value;
+    float history[10];
+} FloatSensor;
+/**
+ * @brief Caminho anterior por amostra: sinf, rand em float, deslocamento
+ * do histórico, soma da média e comparação de limiares em float
+ */
+static void bench_sample_float(void *ctx, uint32_t i) {
+    FloatSensor *sensor = ctx;
+    int hour = (int)(i % 24);
+    float daily = 5.0f * sinf((hour - 14) * 3.14159f / 12);
+    float base = (sensor->min_val + sensor->max_val) / 2 + daily;
+    float variation = ((float)rand() / RAND_MAX * 2 - 1) * sensor->variation;
+    float new_value = base + variation;
+    if (new_value < sensor->min_val) new_value = sensor->min_val;
+    if (new_value > sensor->max_val) new_value = sensor->max_val;
+    for (int k = 0; k < 9; k++) {
+        sensor->history[k] = sensor->history[k + 1];
+    }
+    sensor->history[9] = new_value;
+    sensor->value = new_value;
+
+    float sum = 0;
+    for (int k = 0; k < 10; k++) {
+        sum += sensor->history[k];
+    }
+    volatile float avg = sum / 10;
+    volatile bool anomalous = sensor->value < sensor->anomaly_min || sensor->value > sensor->anomaly_max;
+    (void)avg;
+    (void)anomalous;
+}
+/**
+ * @brief Leitura do driver simulado (sem histórico)
+ */
+static void bench_sim_read(void *ctx, uint32_t i) {
+    sensor_t *sensor = ctx;
+    fix_t value;
+    sensor->driver->read(sensor, i * 3600000u, &value);
+    volatile fix_t sink = value;
+    (void)sink;
+}
+/**
+ * @brief O mesmo trabalho do caminho em float, em ponto fixo: leitura do
+ * driver, inserção no histórico, média e comparação de limiares
+ */
+static void bench_sample_fixed(void *ctx, uint32_t i) {
+    sensor_t *sensor = ctx;
+    fix_t value;
+    sensor->driver->read(sensor, i * 3600000u, &value);
+    history_push(&sensor->history, value);
+    sensor->value = value;
+
+    volatile fix_t avg = history_mean(&sensor->history);
+    volatile bool anomalous = sensor->value < sensor->driver->anomaly_min ||
+                              sensor->value > sensor->driver->anomaly_max;
+    (void)avg;
+    (void)anomalous;
+}
+/**
+ * @brief Caminho completo por amostra (sensor_sample): além do histórico,
+ * taxa de variação, mínimo e máximo, detectores de anomalia e ouvinte
+ */
+static void bench_sample_full(void *ctx, uint32_t i) {
+    sensor_t *sensor = ctx;
+    sensor_sample(sensor, i * 3600000u);
+    volatile fix_t avg = sensor_mean(sensor);
+    volatile bool anomalous = sensor_is_anomalous(sensor);
+    (void)avg;
+    (void)anomalous;
+}
+/**
+ * @brief Média móvel: inserção na janela e consulta da média
+ */
+static void bench_history(void *ctx, uint32_t i) {
+    history_t *h = ctx;
+    history_push(h, FIX_CONST(20.0) + (fix_t)((i * 37u) & 0x3FF));
+    volatile fix_t avg = history_mean(h);
+    (void)avg;
+}
+#if !MONITOR_DUAL_CORE
+/**
+ * @brief Um quadro da animação da matriz por iteração
+ *
+ * O relógio é simulado para que cada chamada desenhe um quadro; o envio
+ * recusado durante o latch fica pendente, como no escalonador, e as
+ * palavras efetivamente enviadas ao PIO aparecem na última coluna.
+ */
+static void bench_animation(void *ctx, uint32_t i) {
+    (void)ctx;
+    outputs_poll(i * OUTPUT_ANIMATION_PERIOD_MS);
+}
+#endif
+
+void bench_run_modules(void) {
+    static FloatSensor float_sensor = {15.0f, 35.0f, 10.0f, 40.0f, 0.5f, 25.0f, {0}};
+    static sensor_t fixed_sensor = {.driver = &sensor_sim_temperature, .available = true, .enabled = true};
+    static sensor_t full_sensor = {.driver = &sensor_sim_temperature, .available = true, .enabled = true};
+    static history_t history;
+    static uint32_t history_storage[HISTORY_WORDS(SENSOR_HISTORY_WINDOW)];
+
+    history_init(&fixed_sensor.history, SENSOR_HISTORY_WINDOW, fixed_sensor.history_storage);
+    history_init(&full_sensor.history, SENSOR_HISTORY_WINDOW, full_sensor.history_storage);
+    anomaly_init(&full_sensor.detector);
+    history_init(&history, SENSOR_HISTORY_WINDOW, history_storage);
+
+    bench_case("sensor_leitura_sim", bench_sim_read, &fixed_sensor);
+    bench_case("sensor_amostra_float_ref", bench_sample_float, &float_sensor);
+    bench_case("sensor_amostra_fixo", bench_sample_fixed, &fixed_sensor);
+    bench_case("sensor_amostra_completa", bench_sample_full, &full_sensor);
+    bench_cycles("sensor_amostra_float_ref", bench_sample_float, &float_sensor, BENCH_CYCLE_SAMPLES);
+    bench_cycles("sensor_amostra_fixo", bench_sample_fixed, &fixed_sensor, BENCH_CYCLE_SAMPLES);
+    bench_cycles("sensor_amostra_completa", bench_sample_full, &full_sensor, BENCH_CYCLE_SAMPLES);
+    bench_case("historico_media", bench_history, &history);
+
+#if !MONITOR_DUAL_CORE
+    outputs_set_pattern(OUTPUT_PATTERN_ANIMATION);
+    bench_case("animacao_matriz", bench_animation, NULL);
+    outputs_set_pattern(OUTPUT_PATTERN_OFF);
+    outputs_poll(0);
+    neopixel_wait();
+#endif
+}
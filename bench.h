@@ -0,0 +1,89 @@
+/**
+ * @file bench.h
+ * @brief Microbenchmarks dos caminhos críticos (MONITOR_BENCHMARK)
+ *
+ * Cada caso executa uma operação em laço até somar BENCH_MIN_US e
+ * imprime uma linha CSV na serial, comparável entre commits:
+ *
+ *   BENCH,plataforma,caso,iteracoes,ns_op,ciclos_op,i2c_bytes_quadro,pio_palavras_quadro
+ *
+ * O tempo vem do timer de 1 MHz (time_us_64); na placa, ciclos_op é esse
+ * tempo convertido pelo clk_sys, e no host fica vazio. As duas últimas
+ * colunas são os bytes enviados ao display e as palavras enviadas ao PIO
+ * dos NeoPixels por operação, vazias quando a operação não usa o
+ * barramento.
+ *
+ * Na placa, os casos de amostragem dos sensores também são medidos
+ * chamada a chamada pelo SysTick, com média, melhor e pior caso:
+ *
+ *   CICLOS,plataforma,caso,amostras,media,minimo,maximo
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+/** Tempo mínimo medido por caso (us) */
+#ifndef BENCH_MIN_US
+#define BENCH_MIN_US 50000
+#endif
+
+/** Chamadas medidas uma a uma por bench_cycles() */
+#ifndef BENCH_CYCLE_SAMPLES
+#define BENCH_CYCLE_SAMPLES 1000
+#endif
+
+/**
+ * @brief Operação medida
+ * @param ctx Contexto do caso
+ * @param i Índice da iteração
+ */
+typedef void (*bench_fn_t)(void *ctx, uint32_t i);
+
+/**
+ * @brief Imprime o cabeçalho CSV
+ */
+void bench_header(void);
+
+/**
+ * @brief Mede um caso e imprime a sua linha
+ *
+ * Uma iteração de aquecimento antecede a medição. O número de iterações
+ * dobra até que o laço dure ao menos BENCH_MIN_US.
+ *
+ * @param name Nome do caso (sem vírgulas)
+ * @param fn Operação
+ * @param ctx Contexto repassado à operação
+ */
+void bench_case(const char *name, bench_fn_t fn, void *ctx);
+
+/**
+ * @brief Mede os ciclos de cada chamada isolada e imprime média, mínimo
+ * e máximo
+ *
+ * O M0+ não tem contador de ciclos (DWT); o SysTick, com o clock do
+ * processador como fonte, faz esse papel, descontado o custo de uma
+ * chamada vazia. Cada chamada deve durar bem menos que os 2^24 ciclos do
+ * contador. No host o SysTick não conta e nada é impresso.
+ *
+ * @param name Nome do caso (sem vírgulas)
+ * @param fn Operação
+ * @param ctx Contexto repassado à operação
+ * @param samples Chamadas medidas, após uma de aquecimento
+ */
+void bench_cycles(const char *name, bench_fn_t fn, void *ctx, uint32_t samples);
+
+/**
+ * @brief Casos dos módulos de sensores, histórico e saídas
+ *
+ * Compara também a amostragem em ponto fixo com o caminho de referência
+ * em float que ela substituiu, com o mesmo trabalho por amostra (leitura,
+ * histórico, média e limiares); o caminho completo de sensor_sample(),
+ * com detectores de anomalia, é um caso à parte.
+ *
+ * Deve rodar antes de sensor_set_listener() (init_rules()): os sensores
+ * do benchmark não são do registro, mas o ouvinte os trataria pelo id.
+ */
+void bench_run_modules(void);
+
+#endif // BENCH_H
@@ -0,0 +1,154 @@
+/**
+ * @file buttons.c
+ * @brief Botões por interrupção com debounce por alarme e fila de eventos
+ *
+ * A interrupção de GPIO apenas registra a borda e agenda o alarme de
+ * debounce (um por botão, nunca reagendado pelas bordas seguintes); os
+ * eventos são publicados somente pelas callbacks de alarme, todas no
+ * mesmo IRQ de timer, que é o único produtor da fila. A aplicação é a
+ * única consumidora.
+ *
+ * Um toque mais curto que a janela é reconhecido pela borda de descida
+ * vista com o botão solto: se o alarme encontra o pino já em 1, publica
+ * pressionar e soltar em seguida. O repique da soltura não gera toques,
+ * pois começa com o botão ainda pressionado.
+ */
+#include "buttons.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+
+/**
+ * @brief Estado de um botão (escrito nas interrupções)
+ */
+typedef struct {
+    uint pin;
+    volatile bool pressed;               ///< Estado estável
+    volatile bool tap_latched;           ///< Descida vista com o botão solto
+    volatile uint32_t edge_ms;           ///< Primeira borda da janela atual
+    volatile alarm_id_t debounce_alarm;  ///< 0 = nenhuma janela aberta
+    volatile alarm_id_t long_alarm;      ///< 0 = pressão longa não agendada
+} button_state_t;
+
+static button_state_t buttons[BUTTON_COUNT];
+
+static button_event_t queue[BUTTONS_QUEUE_SIZE];
+static volatile uint32_t queue_head = 0;  ///< Escrito apenas pelo IRQ de timer
+static volatile uint32_t queue_tail = 0;  ///< Escrito apenas pela aplicação
+static volatile uint32_t dropped = 0;
+static void (*notify)(void) = NULL;       ///< Chamada após publicar (contexto do alarme)
+
+static inline uint32_t now_ms(void) {
+    return to_ms_since_boot(get_absolute_time());
+}
+/**
+ * @brief Publica um evento (contexto do alarme)
+ */
+static void queue_push(int id, button_event_type_t type, uint32_t time_ms) {
+    uint32_t head = queue_head;
+    uint32_t next = (head + 1) % BUTTONS_QUEUE_SIZE;
+    if (next == queue_tail) {
+        dropped++;
+        return;
+    }
+    queue[head] = (button_event_t){time_ms, (uint8_t)id, (uint8_t)type};
+    __dmb();
+    queue_head = next;
+    if (notify) notify();
+}
+/**
+ * @brief Alarme de pressão longa: o botão continua pressionado
+ */
+static int64_t long_press_callback(alarm_id_t alarm, void *user_data) {
+    int id = (int)(uintptr_t)user_data;
+    button_state_t *b = &buttons[id];
+    if (b->long_alarm != alarm) return 0;
+    b->long_alarm = 0;
+    if (b->pressed) queue_push(id, BUTTON_EVENT_LONG_PRESS, now_ms());
+    return 0;
+}
+/**
+ * @brief Muda o estado estável e publica o evento correspondente
+ */
+static void set_pressed(int id, bool pressed, uint32_t time_ms) {
+    button_state_t *b = &buttons[id];
+    b->pressed = pressed;
+    if (b->long_alarm > 0) {
+        cancel_alarm(b->long_alarm);
+        b->long_alarm = 0;
+    }
+    if (pressed) {
+        queue_push(id, BUTTON_EVENT_PRESS, time_ms);
+        alarm_id_t alarm = add_alarm_in_ms(BUTTONS_LONG_PRESS_MS, long_press_callback, (void *)(uintptr_t)id, true);
+        b->long_alarm = alarm > 0 ? alarm : 0;
+    } else {
+        queue_push(id, BUTTON_EVENT_RELEASE, time_ms);
+    }
+}
+/**
+ * @brief Alarme de debounce: amostra o pino estável
+ */
+static int64_t debounce_callback(alarm_id_t alarm, void *user_data) {
+    (void)alarm;
+    int id = (int)(uintptr_t)user_data;
+    button_state_t *b = &buttons[id];
+    bool level = !gpio_get(b->pin);
+
+    if (level != b->pressed) {
+        set_pressed(id, level, b->edge_ms);
+    } else if (!b->pressed && b->tap_latched) {
+        // Toque mais curto que a janela
+        set_pressed(id, true, b->edge_ms);
+        set_pressed(id, false, now_ms());
+    }
+    b->tap_latched = false;
+    b->debounce_alarm = 0;
+    return 0;
+}
+/**
+ * @brief Interrupção de borda: abre a janela de debounce do botão
+ */
+static void gpio_callback(uint gpio, uint32_t events) {
+    for (int id = 0; id < BUTTON_COUNT; id++) {
+        button_state_t *b = &buttons[id];
+        if (b->pin != gpio) continue;
+
+        if (!b->pressed && (events & GPIO_IRQ_EDGE_FALL)) b->tap_latched = true;
+        if (b->debounce_alarm == 0) {
+            b->edge_ms = now_ms();
+            alarm_id_t alarm = add_alarm_in_ms(BUTTONS_DEBOUNCE_MS, debounce_callback, (void *)(uintptr_t)id, true);
+            b->debounce_alarm = alarm > 0 ? alarm : 0;
+        }
+        return;
+    }
+}
+void buttons_init(const uint pins[BUTTON_COUNT]) {
+    for (int id = 0; id < BUTTON_COUNT; id++) {
+        button_state_t *b = &buttons[id];
+        b->pin = pins[id];
+        gpio_init(b->pin);
+        gpio_set_dir(b->pin, GPIO_IN);
+        gpio_pull_up(b->pin);
+        b->pressed = !gpio_get(b->pin);
+        b->tap_latched = false;
+        b->debounce_alarm = 0;
+        b->long_alarm = 0;
+    }
+    for (int id = 0; id < BUTTON_COUNT; id++) {
+        gpio_set_irq_enabled_with_callback(pins[id], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, gpio_callback);
+    }
+}
+bool buttons_poll(button_event_t *event) {
+    uint32_t tail = queue_tail;
+    if (tail == queue_head) return false;
+    __dmb();
+    *event = queue[tail];
+    __dmb();
+    queue_tail = (tail + 1) % BUTTONS_QUEUE_SIZE;
+    return true;
+}
+void buttons_set_notify(void (*callback)(void)) {
+    notify = callback;
+}
+uint32_t buttons_get_dropped() {
+    return dropped;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file buttons.h
+ * @brief Botões por interrupção com debounce por alarme e fila de eventos
+ *
+ * Cada borda dos pinos dispara a interrupção de GPIO, que agenda um
+ * alarme de BUTTONS_DEBOUNCE_MS; o alarme amostra o pino já estável e
+ * publica pressionar, soltar e pressão longa numa fila SPSC sem travas,
+ * esvaziada pela aplicação com buttons_poll(). A leitura não depende do
+ * laço principal: um toque durante um sleep_ms fica na fila, e um toque
+ * mais curto que a janela de debounce ainda gera pressionar e soltar.
+ */
+#ifndef BUTTONS_H
+#define BUTTONS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+#define BUTTONS_DEBOUNCE_MS 20     ///< Janela de debounce após a primeira borda
+#define BUTTONS_LONG_PRESS_MS 1000 ///< Duração mínima de uma pressão longa
+#define BUTTONS_QUEUE_SIZE 32      ///< Eventos na fila (potência de 2)
+
+/**
+ * @brief Botões monitorados (índices de buttons_init)
+ */
+typedef enum {
+    BUTTON_A = 0,
+    BUTTON_B,
+    BUTTON_JOY,
+    BUTTON_COUNT
+} button_id_t;
+
+/**
+ * @brief Tipos de evento
+ */
+typedef enum {
+    BUTTON_EVENT_PRESS,       ///< Botão pressionado (após o debounce)
+    BUTTON_EVENT_RELEASE,     ///< Botão solto
+    BUTTON_EVENT_LONG_PRESS   ///< Ainda pressionado após BUTTONS_LONG_PRESS_MS
+} button_event_type_t;
+
+/**
+ * @brief Evento de botão
+ */
+typedef struct {
+    uint32_t time_ms;   ///< Instante da primeira borda (ms desde o boot)
+    uint8_t button;     ///< button_id_t
+    uint8_t type;       ///< button_event_type_t
+} button_event_t;
+
+/**
+ * @brief Configura os pinos (entrada com pull-up, ativo em 0) e as interrupções
+ * @param pins Pino de cada botão, na ordem de button_id_t
+ */
+void buttons_init(const uint pins[BUTTON_COUNT]);
+
+/**
+ * @brief Retira o evento mais antigo da fila
+ * @param event Evento retirado
+ * @return false se a fila estiver vazia
+ */
+bool buttons_poll(button_event_t *event);
+
+/**
+ * @brief Define a função chamada a cada evento publicado
+ *
+ * Executa no contexto do alarme: deve apenas sinalizar (ex.: acordar o
+ * escalonador com scheduler_trigger_from_isr()).
+ * @param callback Função de notificação, ou NULL
+ */
+void buttons_set_notify(void (*callback)(void));
+
+/**
+ * @brief Eventos descartados com a fila cheia
+ */
+uint32_t buttons_get_dropped(void);
+
+#endif // BUTTONS_H
@@ -0,0 +1,79 @@
+/**
+ * @file fixed.h
+ * @brief Aritmética de ponto fixo (Q23.8) para o caminho dos sensores
+ *
+ * O RP2040 (Cortex-M0+) não tem FPU: cada operação em float é uma chamada
+ * de biblioteca. Leituras, limiares e estatísticas dos sensores usam
+ * fix_t, um inteiro de 32 bits com 8 bits fracionários (resolução de
+ * 1/256 da unidade, faixa de ±8 milhões). float aparece apenas na
+ * formatação para o usuário (fix_to_float).
+ */
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+
+#define FIX_FRAC_BITS 8
+#define FIX_ONE (1 << FIX_FRAC_BITS)
+
+/** Valor em ponto fixo Q23.8 */
+typedef int32_t fix_t;
+
+/** Constante em ponto fixo a partir de um literal (avaliada em compilação) */
+#define FIX_CONST(x) ((fix_t)((x) * FIX_ONE + ((x) >= 0 ? 0.5 : -0.5)))
+
+/** Converte um inteiro para ponto fixo */
+#define FIX_FROM_INT(i) ((fix_t)(i) * FIX_ONE)
+
+/**
+ * @brief Converte para float (apenas para formatação)
+ */
+static inline float fix_to_float(fix_t v) {
+    return (float)v / FIX_ONE;
+}
+/**
+ * @brief Produto de dois valores em ponto fixo
+ */
+static inline fix_t fix_mul(fix_t a, fix_t b) {
+    return (fix_t)(((int64_t)a * b) >> FIX_FRAC_BITS);
+}
+/**
+ * @brief Divisão inteira com arredondamento para o mais próximo
+ */
+static inline int64_t fix_div_round(int64_t num, int64_t den) {
+    return (num >= 0 ? num + den / 2 : num - den / 2) / den;
+}
+/**
+ * @brief Converte para inteiro escalado (ex.: scale = 10 para décimos)
+ */
+static inline int32_t fix_to_scaled(fix_t v, int32_t scale) {
+    return (int32_t)fix_div_round((int64_t)v * scale, FIX_ONE);
+}
+/**
+ * @brief Limita um valor a [lo, hi]
+ */
+static inline fix_t fix_clamp(fix_t v, fix_t lo, fix_t hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+/**
+ * @brief Raiz quadrada inteira (piso) de um valor de 64 bits
+ *
+ * Método bit a bit, apenas somas e deslocamentos.
+ */
+static inline uint32_t fix_isqrt64(uint64_t v) {
+    uint64_t result = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > v) bit >>= 2;
+    while (bit != 0) {
+        if (v >= result + bit) {
+            v -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)result;
+}
+
+#endif // FIXED_H
@@ -0,0 +1,270 @@
+/**
+ * @file flashlog.c
+ * @brief Registro circular de leituras e alertas na flash, com nivelamento de desgaste
+ *
+ * Independente do hardware: todo acesso à memória passa pelo
+ * flashlog_storage_t, e a serialização é byte a byte (little-endian),
+ * sem depender do layout de structs.
+ */
+#include "flashlog.h"
+#include "profile.h"
+#include <string.h>
+
+static const flashlog_storage_t *storage = NULL;
+static uint8_t staging[FLASHLOG_SECTOR_SIZE];  ///< Setor em montagem
+static uint16_t staged = 0;           ///< Registros no buffer
+static uint32_t head_sector = 0;      ///< Último setor gravado
+static uint32_t head_seq = 0;         ///< Sequência do último setor gravado
+static bool has_head = false;         ///< Algum setor válido na flash
+static uint16_t boot_id = 0;
+static uint32_t stored_records = 0;   ///< Registros válidos na flash
+static uint32_t sectors_written = 0;
+
+static inline void put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+static inline void put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+static inline uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+static inline uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+/**
+ * @brief CRC-32 (polinômio refletido 0xEDB88320), incremental
+ *
+ * Começa com crc = 0xFFFFFFFF; o valor final é o complemento.
+ */
+static uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+    }
+    return crc;
+}
+/**
+ * @brief Cabeçalho de setor decodificado
+ */
+typedef struct {
+    uint32_t seq;
+    uint16_t boot;
+    uint16_t count;
+    uint32_t crc;
+} sector_header_t;
+
+/**
+ * @brief Lê e valida o cabeçalho de um setor (sem conferir o CRC)
+ *
+ * O cabeçalho é gravado por último, portanto um cabeçalho presente
+ * indica que os registros do setor chegaram à flash.
+ */
+static bool read_header(uint32_t sector, sector_header_t *header) {
+    uint8_t raw[FLASHLOG_HEADER_SIZE];
+    storage->read(sector * FLASHLOG_SECTOR_SIZE, raw, sizeof(raw));
+    if (get_u32(raw) != FLASHLOG_MAGIC) return false;
+    header->seq = get_u32(raw + 4);
+    header->boot = get_u16(raw + 8);
+    header->count = get_u16(raw + 10);
+    header->crc = get_u32(raw + 12);
+    return header->count <= FLASHLOG_RECORDS_PER_SECTOR;
+}
+/**
+ * @brief Confere o CRC de um setor lendo-o em blocos
+ */
+static bool verify_sector(uint32_t sector, const sector_header_t *header) {
+    uint8_t chunk[64];
+    uint32_t base = sector * FLASHLOG_SECTOR_SIZE;
+    uint32_t len = (uint32_t)header->count * FLASHLOG_RECORD_SIZE;
+
+    // Campos do cabeçalho antes do crc, depois os registros
+    storage->read(base, chunk, FLASHLOG_HEADER_SIZE - 4);
+    uint32_t crc = crc32_update(0xFFFFFFFFu, chunk, FLASHLOG_HEADER_SIZE - 4);
+    for (uint32_t done = 0; done < len; ) {
+        uint32_t n = len - done < sizeof(chunk) ? len - done : sizeof(chunk);
+        storage->read(base + FLASHLOG_HEADER_SIZE + done, chunk, n);
+        crc = crc32_update(crc, chunk, n);
+        done += n;
+    }
+    return ~crc == header->crc;
+}
+static void encode_record(uint8_t *p, const flashlog_record_t *record) {
+    put_u32(p, record->timestamp_ms);
+    put_u32(p + 4, (uint32_t)record->value);
+    p[8] = record->sensor;
+    p[9] = record->type;
+    put_u16(p + 10, record->flags);
+}
+static void decode_record(const uint8_t *p, flashlog_record_t *record) {
+    record->timestamp_ms = get_u32(p);
+    record->value = (int32_t)get_u32(p + 4);
+    record->sensor = p[8];
+    record->type = p[9];
+    record->flags = get_u16(p + 10);
+}
+/**
+ * @brief Localiza a cabeça do log e prepara o buffer de gravação
+ *
+ * Lê apenas os 16 bytes de cabeçalho de cada setor.
+ */
+uint32_t flashlog_init(const flashlog_storage_t *new_storage) {
+    storage = new_storage;
+    staged = 0;
+    has_head = false;
+    stored_records = 0;
+    sectors_written = 0;
+    boot_id = 0;
+    if (storage == NULL) return 0;
+
+    uint32_t valid = 0;
+    uint16_t last_boot = 0;
+    for (uint32_t s = 0; s < storage->sector_count; s++) {
+        sector_header_t header;
+        if (!read_header(s, &header)) continue;
+        valid++;
+        stored_records += header.count;
+        if (!has_head || (int32_t)(header.seq - head_seq) > 0) {
+            has_head = true;
+            head_sector = s;
+            head_seq = header.seq;
+            last_boot = header.boot;
+        }
+    }
+    if (has_head) boot_id = (uint16_t)(last_boot + 1);
+    return valid;
+}
+/**
+ * @brief Grava o buffer no setor seguinte à cabeça
+ */
+static bool write_staging(void) {
+    uint32_t sector = has_head ? (head_sector + 1) % storage->sector_count : 0;
+    uint32_t seq = has_head ? head_seq + 1 : 0;
+
+    // Os registros do setor sobrescrito deixam de existir
+    sector_header_t old;
+    uint16_t overwritten = read_header(sector, &old) ? old.count : 0;
+
+    uint32_t used = FLASHLOG_HEADER_SIZE + (uint32_t)staged * FLASHLOG_RECORD_SIZE;
+    memset(staging + used, 0xFF, FLASHLOG_SECTOR_SIZE - used);
+    put_u32(staging, FLASHLOG_MAGIC);
+    put_u32(staging + 4, seq);
+    put_u16(staging + 8, boot_id);
+    put_u16(staging + 10, staged);
+    uint32_t crc = crc32_update(0xFFFFFFFFu, staging, FLASHLOG_HEADER_SIZE - 4);
+    crc = crc32_update(crc, staging + FLASHLOG_HEADER_SIZE, used - FLASHLOG_HEADER_SIZE);
+    put_u32(staging + 12, ~crc);
+
+    // Em falha o buffer é mantido e a gravação é repetida no mesmo setor
+    PROFILE_BEGIN(start_us);
+    bool written = storage->write_sector(sector * FLASHLOG_SECTOR_SIZE, staging);
+    PROFILE_END(PROFILE_FLASH, start_us);
+    if (!written) return false;
+    has_head = true;
+    head_sector = sector;
+    head_seq = seq;
+    stored_records = stored_records - overwritten + staged;
+    sectors_written++;
+    staged = 0;
+    return true;
+}
+/**
+ * @brief Acrescenta um registro; grava um setor quando o buffer enche
+ */
+bool flashlog_append(const flashlog_record_t *record) {
+    if (storage == NULL) return false;
+    // Buffer cheio após uma gravação que falhou: tenta de novo antes de aceitar mais
+    if (staged >= FLASHLOG_RECORDS_PER_SECTOR && !write_staging()) return false;
+    encode_record(staging + FLASHLOG_HEADER_SIZE + (uint32_t)staged * FLASHLOG_RECORD_SIZE, record);
+    staged++;
+    if (staged < FLASHLOG_RECORDS_PER_SECTOR) return true;
+    return write_staging();
+}
+/**
+ * @brief Grava os registros pendentes, mesmo com o setor incompleto
+ */
+bool flashlog_flush() {
+    if (storage == NULL || staged == 0) return storage != NULL;
+    return write_staging();
+}
+/**
+ * @brief Posiciona o cursor no registro mais antigo
+ *
+ * O setor mais antigo é o seguinte à cabeça; setores vazios ou
+ * inválidos no caminho são pulados.
+ */
+void flashlog_cursor_begin(flashlog_cursor_t *cursor) {
+    cursor->sectors_left = (storage && has_head) ? storage->sector_count : 0;
+    cursor->sector = has_head ? head_sector : 0;
+    cursor->index = 0;
+    cursor->count = 0;
+    cursor->boot = 0;
+    cursor->in_staging = false;
+}
+/**
+ * @brief Lê o próximo registro
+ *
+ * Cada setor tem o CRC conferido ao entrar nele; setores corrompidos
+ * são pulados inteiros. Gravações durante a leitura podem sobrescrever
+ * o setor mais antigo ainda não lido.
+ */
+bool flashlog_cursor_next(flashlog_cursor_t *cursor, flashlog_record_t *record, uint16_t *boot) {
+    if (storage == NULL) return false;
+
+    while (!cursor->in_staging && cursor->index >= cursor->count) {
+        if (cursor->sectors_left == 0) {
+            cursor->in_staging = true;
+            cursor->index = 0;
+            break;
+        }
+        cursor->sectors_left--;
+        cursor->sector = (cursor->sector + 1) % storage->sector_count;
+        cursor->index = 0;
+        cursor->count = 0;
+        sector_header_t header;
+        if (read_header(cursor->sector, &header) && verify_sector(cursor->sector, &header)) {
+            cursor->count = header.count;
+            cursor->boot = header.boot;
+        }
+    }
+
+    if (cursor->in_staging) {
+        if (cursor->index >= staged) return false;
+        decode_record(staging + FLASHLOG_HEADER_SIZE + (uint32_t)cursor->index * FLASHLOG_RECORD_SIZE, record);
+        cursor->index++;
+        if (boot) *boot = boot_id;
+        return true;
+    }
+
+    uint8_t raw[FLASHLOG_RECORD_SIZE];
+    storage->read(cursor->sector * FLASHLOG_SECTOR_SIZE + FLASHLOG_HEADER_SIZE +
+                  (uint32_t)cursor->index * FLASHLOG_RECORD_SIZE, raw, sizeof(raw));
+    decode_record(raw, record);
+    cursor->index++;
+    if (boot) *boot = cursor->boot;
+    return true;
+}
+/**
+ * @brief Contador desta inicialização
+ */
+uint16_t flashlog_boot_id() {
+    return boot_id;
+}
+/**
+ * @brief Registros no log (flash e buffer)
+ */
+uint32_t flashlog_record_count() {
+    return stored_records + staged;
+}
+/**
+ * @brief Setores gravados desde o boot
+ */
+uint32_t flashlog_sectors_written() {
+    return sectors_written;
+}
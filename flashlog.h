@@ -0,0 +1,157 @@
+/**
+ * @file flashlog.h
+ * @brief Registro circular de leituras e alertas na flash, com nivelamento de desgaste
+ *
+ * Os registros (tamanho fixo) são acumulados em um buffer de RAM do tamanho
+ * de um setor e gravados de uma só vez (um apagamento e uma programação por
+ * setor, nunca por amostra). Os setores da região reservada são usados em
+ * rodízio, de modo que cada um é apagado uma vez a cada volta completa.
+ *
+ * Layout de um setor:
+ *
+ *   cabeçalho (16 bytes)
+ *     magic     u32  FLASHLOG_MAGIC
+ *     seq       u32  número de sequência do setor (cresce a cada gravação)
+ *     boot      u16  contador de inicializações em que o setor foi gravado
+ *     count     u16  registros válidos no setor
+ *     crc       u32  CRC-32 do cabeçalho (sem o crc) e dos registros
+ *   registros (FLASHLOG_RECORDS_PER_SECTOR × 12 bytes)
+ *
+ * Na inicialização apenas os cabeçalhos são lidos: o setor válido de maior
+ * sequência é a cabeça do log. Setores com CRC inválido (gravação
+ * interrompida) são ignorados.
+ *
+ * O acesso à memória passa por flashlog_storage_t: flashlog_flash.c
+ * implementa a flash do RP2040 e host/flashlog_file.c um arquivo no host.
+ */
+#ifndef FLASHLOG_H
+#define FLASHLOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define FLASHLOG_SECTOR_SIZE 4096u
+#define FLASHLOG_MAGIC 0x474F4C57u   ///< "WLOG"
+#define FLASHLOG_HEADER_SIZE 16u
+#define FLASHLOG_RECORD_SIZE 12u
+#define FLASHLOG_RECORDS_PER_SECTOR ((FLASHLOG_SECTOR_SIZE - FLASHLOG_HEADER_SIZE) / FLASHLOG_RECORD_SIZE)
+
+/** Sensor de registros que não se referem a um sensor (eventos) */
+#define FLASHLOG_NO_SENSOR 0xFF
+
+/**
+ * @brief Tipo de registro
+ */
+typedef enum {
+    FLASHLOG_READING = 0,  ///< Leitura de sensor
+    FLASHLOG_EVENT         ///< Alerta ou evento do sistema
+} flashlog_type_t;
+
+/** @defgroup FlashlogFlags Bits do campo de alertas
+ * @{
+ */
+#define FLASHLOG_FLAG_ANOMALY   (1u << 0)  ///< Leitura anômala (limiares ou detectores)
+#define FLASHLOG_FLAG_FIRE      (1u << 1)  ///< Incêndio detectado
+#define FLASHLOG_FLAG_WILDLIFE  (1u << 2)  ///< Animal detectado
+#define FLASHLOG_FLAG_RULE      (1u << 3)  ///< Regra de alerta disparada (valor = índice)
+/** Em leituras: regras de anomalia disparadas (ANOMALY_*) a partir deste bit */
+#define FLASHLOG_ANOMALY_RULES_SHIFT 8
+/** @} */
+
+/**
+ * @brief Registro do log (12 bytes na flash, little-endian)
+ */
+typedef struct {
+    uint32_t timestamp_ms;  ///< ms desde o boot
+    int32_t value;          ///< Leitura (Q23.8) ou dado do evento
+    uint8_t sensor;         ///< Índice do sensor ou FLASHLOG_NO_SENSOR
+    uint8_t type;           ///< flashlog_type_t
+    uint16_t flags;         ///< FLASHLOG_FLAG_*
+} flashlog_record_t;
+
+/**
+ * @brief Acesso à memória que guarda o log
+ *
+ * Os deslocamentos são relativos ao início da região reservada.
+ */
+typedef struct {
+    uint32_t sector_count;  ///< Setores da região
+    /** Lê len bytes a partir de offset */
+    void (*read)(uint32_t offset, void *buf, size_t len);
+    /**
+     * Apaga um setor e grava FLASHLOG_SECTOR_SIZE bytes, com o cabeçalho
+     * (FLASHLOG_HEADER_SIZE bytes iniciais) por último; false em falha
+     */
+    bool (*write_sector)(uint32_t offset, const void *data);
+} flashlog_storage_t;
+
+/**
+ * @brief Cursor de leitura do log, do registro mais antigo ao mais novo
+ */
+typedef struct {
+    uint32_t sectors_left;   ///< Setores da flash ainda não percorridos
+    uint32_t sector;         ///< Setor atual
+    uint16_t index;          ///< Próximo registro no setor atual
+    uint16_t count;          ///< Registros no setor atual
+    uint16_t boot;           ///< Inicialização em que o setor foi gravado
+    bool in_staging;         ///< Lendo os registros ainda em RAM
+} flashlog_cursor_t;
+
+/**
+ * @brief Localiza a cabeça do log e prepara o buffer de gravação
+ * @param storage Memória do log (NULL = log desativado)
+ * @return Número de setores válidos encontrados
+ */
+uint32_t flashlog_init(const flashlog_storage_t *storage);
+
+/**
+ * @brief Acrescenta um registro; grava um setor quando o buffer enche
+ * @return false se o log estiver desativado ou a gravação falhar
+ */
+bool flashlog_append(const flashlog_record_t *record);
+
+/**
+ * @brief Grava os registros pendentes, mesmo com o setor incompleto
+ *
+ * Consome um setor inteiro; usar apenas em eventos importantes.
+ */
+bool flashlog_flush(void);
+
+/**
+ * @brief Posiciona o cursor no registro mais antigo
+ */
+void flashlog_cursor_begin(flashlog_cursor_t *cursor);
+
+/**
+ * @brief Lê o próximo registro
+ * @param boot Inicialização em que o registro foi feito (pode ser NULL)
+ * @return false ao fim do log
+ */
+bool flashlog_cursor_next(flashlog_cursor_t *cursor, flashlog_record_t *record, uint16_t *boot);
+
+/**
+ * @brief Memória do log na flash interna do RP2040 (flashlog_flash.c)
+ *
+ * Na compilação no host, um arquivo de imagem (host/flashlog_file.c).
+ *
+ * @return NULL se a região reservada se sobrepuser ao programa
+ */
+const flashlog_storage_t *flashlog_flash_storage(void);
+
+/**
+ * @brief Contador desta inicialização
+ */
+uint16_t flashlog_boot_id(void);
+
+/**
+ * @brief Registros no log (flash e buffer)
+ */
+uint32_t flashlog_record_count(void);
+
+/**
+ * @brief Setores gravados desde o boot
+ */
+uint32_t flashlog_sectors_written(void);
+
+#endif // FLASHLOG_H
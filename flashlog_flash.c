@@ -0,0 +1,64 @@
+/**
+ * @file flashlog_flash.c
+ * @brief Memória do log na flash do RP2040
+ *
+ * A região reservada fica no fim da flash. A leitura é feita pelo XIP
+ * sem cache (não desloca o código do cache durante um dump). A gravação
+ * apaga o setor e programa primeiro as páginas de registros e por último
+ * a página do cabeçalho, com as interrupções desligadas e o outro núcleo
+ * parado (flash_safe_execute), pois o XIP fica indisponível.
+ */
+#include "flashlog.h"
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+
+#ifndef FLASHLOG_REGION_SECTORS
+#define FLASHLOG_REGION_SECTORS 128   ///< 512 KB no fim da flash
+#endif
+#define FLASHLOG_REGION_SIZE (FLASHLOG_REGION_SECTORS * FLASH_SECTOR_SIZE)
+#define FLASHLOG_REGION_OFFSET (PICO_FLASH_SIZE_BYTES - FLASHLOG_REGION_SIZE)
+#define FLASHLOG_WRITE_TIMEOUT_MS 100  ///< Espera pelo outro núcleo
+
+_Static_assert(FLASH_SECTOR_SIZE == FLASHLOG_SECTOR_SIZE, "setor do log difere do setor da flash");
+
+extern char __flash_binary_end;
+
+/**
+ * @brief Parâmetros da gravação executada com a flash isolada
+ */
+typedef struct {
+    uint32_t offset;
+    const uint8_t *data;
+} flash_write_t;
+
+static void flash_read(uint32_t offset, void *buf, size_t len) {
+    memcpy(buf, (const void *)(uintptr_t)(XIP_NOCACHE_NOALLOC_BASE + FLASHLOG_REGION_OFFSET + offset), len);
+}
+static void flash_write_locked(void *param) {
+    const flash_write_t *write = param;
+    flash_range_erase(write->offset, FLASH_SECTOR_SIZE);
+    flash_range_program(write->offset + FLASH_PAGE_SIZE, write->data + FLASH_PAGE_SIZE,
+                        FLASH_SECTOR_SIZE - FLASH_PAGE_SIZE);
+    flash_range_program(write->offset, write->data, FLASH_PAGE_SIZE);
+}
+static bool flash_write_sector(uint32_t offset, const void *data) {
+    flash_write_t write = {FLASHLOG_REGION_OFFSET + offset, data};
+    return flash_safe_execute(flash_write_locked, &write, FLASHLOG_WRITE_TIMEOUT_MS) == PICO_OK;
+}
+
+static const flashlog_storage_t flash_storage = {
+    .sector_count = FLASHLOG_REGION_SECTORS,
+    .read = flash_read,
+    .write_sector = flash_write_sector
+};
+
+/**
+ * @brief Memória do log na flash interna
+ */
+const flashlog_storage_t *flashlog_flash_storage() {
+    // A região não pode alcançar o próprio programa
+    if ((uintptr_t)&__flash_binary_end - XIP_BASE > FLASHLOG_REGION_OFFSET) return NULL;
+    return &flash_storage;
+}
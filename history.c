@@ -0,0 +1,131 @@
+/**
+ * @file history.c
+ * @brief Histórico de leituras em buffer circular com estatísticas contínuas
+ *
+ * Com amostras inteiras (Q23.8), a soma e a soma dos quadrados são
+ * exatas: a variância sai de n·Σx² − (Σx)² sem cancelamento numérico nem
+ * recálculos periódicos. Os produtos usam 64 bits; com amostras de até
+ * ±2^20 unidades Q (±4096 na unidade do sensor) e janelas de até
+ * HISTORY_MAX_WINDOW amostras não há estouro.
+ *
+ * As duas filas têm a capacidade da janela: a frente expirada sai antes
+ * da inserção, então cada fila guarda no máximo `window` sequências.
+ */
+#include "history.h"
+
+static inline fix_t value_at(const history_t *h, uint32_t seq) {
+    return h->values[seq % h->window];
+}
+static inline uint32_t deque_front(const history_deque_t *q) {
+    return q->seq[q->head];
+}
+static inline uint32_t deque_back(const history_t *h, const history_deque_t *q) {
+    return q->seq[(q->head + q->size - 1) % h->window];
+}
+static inline void deque_push_back(history_t *h, history_deque_t *q, uint32_t seq) {
+    q->seq[(q->head + q->size) % h->window] = seq;
+    q->size++;
+}
+static inline void deque_pop_front(history_t *h, history_deque_t *q) {
+    q->head = (uint16_t)((q->head + 1) % h->window);
+    q->size--;
+}
+/**
+ * @brief Acrescenta uma amostra à fila monotônica
+ *
+ * Remove da frente a amostra que saiu da janela e, do fim, as que nunca
+ * mais serão extremo (piores que a nova). A remoção da frente vem antes
+ * da inserção: assim a fila nunca passa de `window` elementos, mesmo com
+ * uma série monotônica na janela máxima.
+ *
+ * @param want_min true para a fila de mínimo, false para a de máximo
+ */
+static void deque_update(history_t *h, history_deque_t *q, uint32_t seq, fix_t value, bool want_min) {
+    if (q->size > 0 && seq - deque_front(q) >= h->window) {
+        deque_pop_front(h, q);
+    }
+    while (q->size > 0) {
+        fix_t back = value_at(h, deque_back(h, q));
+        if (want_min ? back < value : back > value) break;
+        q->size--;
+    }
+    deque_push_back(h, q, seq);
+}
+/**
+ * @brief Inicializa um histórico vazio
+ */
+void history_init(history_t *h, uint16_t window, uint32_t *storage) {
+    if (window == 0) window = 1;
+    if (window > HISTORY_MAX_WINDOW) window = HISTORY_MAX_WINDOW;
+    h->values = (fix_t *)storage;
+    h->min_q.seq = storage + window;
+    h->max_q.seq = storage + 2u * window;
+    h->window = window;
+    h->count = 0;
+    h->next_seq = 0;
+    h->sum = 0;
+    h->sum_sq = 0;
+    h->min_q.head = h->min_q.size = 0;
+    h->max_q.head = h->max_q.size = 0;
+}
+/**
+ * @brief Acrescenta uma amostra à janela
+ */
+void history_push(history_t *h, fix_t value) {
+    uint32_t seq = h->next_seq;
+
+    if (h->count < h->window) {
+        h->count++;
+    } else {
+        fix_t oldest = value_at(h, seq - h->window);
+        h->sum -= oldest;
+        h->sum_sq -= (int64_t)oldest * oldest;
+    }
+    h->sum += value;
+    h->sum_sq += (int64_t)value * value;
+
+    h->values[seq % h->window] = value;
+    h->next_seq = seq + 1;
+
+    deque_update(h, &h->min_q, seq, value, true);
+    deque_update(h, &h->max_q, seq, value, false);
+}
+/**
+ * @brief Média das amostras da janela
+ */
+fix_t history_mean(const history_t *h) {
+    return h->count ? (fix_t)fix_div_round(h->sum, h->count) : 0;
+}
+/**
+ * @brief Menor amostra da janela
+ */
+fix_t history_min(const history_t *h) {
+    return h->count ? value_at(h, deque_front(&h->min_q)) : 0;
+}
+/**
+ * @brief Maior amostra da janela
+ */
+fix_t history_max(const history_t *h) {
+    return h->count ? value_at(h, deque_front(&h->max_q)) : 0;
+}
+/**
+ * @brief Variância populacional em Q.16 (quadrado da unidade Q23.8)
+ */
+static int64_t history_variance_q16(const history_t *h) {
+    if (h->count == 0) return 0;
+    int64_t n = h->count;
+    int64_t var = fix_div_round(n * h->sum_sq - h->sum * h->sum, n * n);
+    return var > 0 ? var : 0;
+}
+/**
+ * @brief Variância populacional das amostras da janela
+ */
+fix_t history_variance(const history_t *h) {
+    return (fix_t)(history_variance_q16(h) >> FIX_FRAC_BITS);
+}
+/**
+ * @brief Desvio padrão populacional das amostras da janela
+ */
+fix_t history_stddev(const history_t *h) {
+    return (fix_t)fix_isqrt64((uint64_t)history_variance_q16(h));
+}
@@ -0,0 +1,98 @@
+/**
+ * @file history.h
+ * @brief Histórico de leituras em buffer circular com estatísticas contínuas
+ *
+ * Mantém as últimas `window` amostras de um sensor (ponto fixo Q23.8) e,
+ * a cada amostra, atualiza em O(1) a soma e a soma dos quadrados (média e
+ * variância) e o mínimo e o máximo (filas monotônicas). Todas as consultas
+ * são O(1), exceto o desvio padrão, que acrescenta uma raiz inteira.
+ *
+ * A memória das amostras e das duas filas é fornecida por quem usa o
+ * histórico, com o tamanho da janela configurada: HISTORY_WORDS(window)
+ * palavras de 32 bits, ou 12 bytes por amostra.
+ */
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fixed.h"
+
+/**
+ * Maior janela suportada (amostras): com leituras de até ±2^20 unidades Q
+ * (±4096 na unidade do sensor), n²·x² ainda cabe nas somas de 64 bits
+ */
+#define HISTORY_MAX_WINDOW 2048
+
+/** Palavras de 32 bits de memória para uma janela (amostras e as duas filas) */
+#define HISTORY_WORDS(window) (3u * (window))
+
+/**
+ * @brief Fila monotônica de números de sequência das amostras
+ *
+ * Na fila de mínimo os valores crescem da frente para o fim; na de máximo
+ * decrescem. A frente é sempre o extremo da janela. A fila nunca passa de
+ * `window` elementos.
+ */
+typedef struct {
+    uint32_t *seq;   ///< `window` posições
+    uint16_t head;   ///< Posição da frente
+    uint16_t size;   ///< Elementos na fila
+} history_deque_t;
+
+/**
+ * @brief Histórico de um sensor
+ */
+typedef struct {
+    fix_t *values;                     ///< Buffer circular (índice = seq % window)
+    uint16_t window;                   ///< Tamanho da janela
+    uint16_t count;                    ///< Amostras na janela (até window)
+    uint32_t next_seq;                 ///< Sequência da próxima amostra
+    int64_t sum;                       ///< Soma exata das amostras da janela
+    int64_t sum_sq;                    ///< Soma exata dos quadrados (Q.16)
+    history_deque_t min_q;             ///< Candidatos a mínimo
+    history_deque_t max_q;             ///< Candidatos a máximo
+} history_t;
+
+/**
+ * @brief Inicializa um histórico vazio
+ * @param h Histórico
+ * @param window Tamanho da janela (1 a HISTORY_MAX_WINDOW)
+ * @param storage HISTORY_WORDS(window) palavras, usadas enquanto o
+ *        histórico existir
+ */
+void history_init(history_t *h, uint16_t window, uint32_t *storage);
+
+/**
+ * @brief Acrescenta uma amostra, descartando a mais antiga se a janela estiver cheia
+ * @param h Histórico
+ * @param value Nova amostra
+ */
+void history_push(history_t *h, fix_t value);
+
+/**
+ * @brief Média das amostras da janela (0 se vazia)
+ */
+fix_t history_mean(const history_t *h);
+
+/**
+ * @brief Menor amostra da janela (0 se vazia)
+ */
+fix_t history_min(const history_t *h);
+
+/**
+ * @brief Maior amostra da janela (0 se vazia)
+ */
+fix_t history_max(const history_t *h);
+
+/**
+ * @brief Variância populacional das amostras da janela
+ */
+fix_t history_variance(const history_t *h);
+
+/**
+ * @brief Desvio padrão populacional das amostras da janela
+ */
+fix_t history_stddev(const history_t *h);
+
+#endif // HISTORY_H
@@ -0,0 +1,71 @@
+/**
+ * @file flashlog_file.c
+ * @brief Memória do log da flash sobre um arquivo, no host
+ *
+ * Substitui flashlog_flash.c na compilação do firmware no host:
+ * flashlog_flash_storage() usa a imagem de MONITOR_HOST_FLASH
+ * (padrão monitor_flash.bin), que persiste entre execuções como a flash.
+ */
+#include "flashlog_file.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static FILE *image = NULL;
+static flashlog_storage_t storage;
+
+static void file_read(uint32_t offset, void *buf, size_t len) {
+    if (fseek(image, (long)offset, SEEK_SET) != 0 || fread(buf, 1, len, image) != len) {
+        memset(buf, 0xFF, len);
+    }
+}
+/**
+ * @brief Grava um setor com o cabeçalho por último, como na flash
+ */
+static bool file_write_sector(uint32_t offset, const void *data) {
+    const uint8_t *bytes = data;
+    uint8_t erased[FLASHLOG_SECTOR_SIZE];
+    memset(erased, 0xFF, sizeof(erased));
+    if (fseek(image, (long)offset, SEEK_SET) != 0 || fwrite(erased, 1, sizeof(erased), image) != sizeof(erased)) return false;
+    if (fseek(image, (long)(offset + FLASHLOG_HEADER_SIZE), SEEK_SET) != 0) return false;
+    if (fwrite(bytes + FLASHLOG_HEADER_SIZE, 1, FLASHLOG_SECTOR_SIZE - FLASHLOG_HEADER_SIZE, image) !=
+        FLASHLOG_SECTOR_SIZE - FLASHLOG_HEADER_SIZE) return false;
+    if (fseek(image, (long)offset, SEEK_SET) != 0) return false;
+    if (fwrite(bytes, 1, FLASHLOG_HEADER_SIZE, image) != FLASHLOG_HEADER_SIZE) return false;
+    return fflush(image) == 0;
+}
+/**
+ * @brief Abre a imagem, criando-a apagada se não existir
+ */
+const flashlog_storage_t *flashlog_file_storage(const char *path) {
+    flashlog_file_close();
+    image = fopen(path, "r+b");
+    if (image == NULL) {
+        image = fopen(path, "w+b");
+        if (image == NULL) return NULL;
+        uint8_t erased[FLASHLOG_SECTOR_SIZE];
+        memset(erased, 0xFF, sizeof(erased));
+        for (int i = 0; i < FLASHLOG_FILE_DEFAULT_SECTORS; i++) fwrite(erased, 1, sizeof(erased), image);
+        fflush(image);
+    }
+    fseek(image, 0, SEEK_END);
+    storage.sector_count = (uint32_t)(ftell(image) / FLASHLOG_SECTOR_SIZE);
+    storage.read = file_read;
+    storage.write_sector = file_write_sector;
+    if (storage.sector_count == 0) {
+        flashlog_file_close();
+        return NULL;
+    }
+    return &storage;
+}
+void flashlog_file_close(void) {
+    if (image != NULL) fclose(image);
+    image = NULL;
+}
+/**
+ * @brief Memória do log no host: a imagem de MONITOR_HOST_FLASH
+ */
+const flashlog_storage_t *flashlog_flash_storage(void) {
+    const char *path = getenv("MONITOR_HOST_FLASH");
+    return flashlog_file_storage(path && path[0] ? path : "monitor_flash.bin");
+}
@@ -0,0 +1,29 @@
+/**
+ * @file flashlog_file.h
+ * @brief Memória do log da flash (flashlog.h) sobre um arquivo, no host
+ *
+ * O arquivo faz o papel da região reservada: pode ser uma imagem lida da
+ * placa (picotool save -r) ou uma imagem nova, criada apagada (0xFF).
+ * Usado pela compilação do firmware no host e por tools/flashlog_host.c.
+ */
+#ifndef FLASHLOG_FILE_H
+#define FLASHLOG_FILE_H
+
+#include "flashlog.h"
+
+/** Setores de uma imagem nova (mesma região do RP2040) */
+#define FLASHLOG_FILE_DEFAULT_SECTORS 128
+
+/**
+ * @brief Abre a imagem, criando-a apagada se não existir
+ * @param path Caminho da imagem
+ * @return Memória do log, ou NULL se o arquivo não puder ser aberto
+ */
+const flashlog_storage_t *flashlog_file_storage(const char *path);
+
+/**
+ * @brief Fecha a imagem aberta por flashlog_file_storage()
+ */
+void flashlog_file_close(void);
+
+#endif // FLASHLOG_FILE_H
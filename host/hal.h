@@ -0,0 +1,92 @@
+/**
+ * @file hal.h
+ * @brief Interface interna da HAL simulada do host
+ *
+ * Os módulos host/hal_*.c implementam o subconjunto do pico-sdk usado
+ * pelo firmware. Não há threads: o tempo é o relógio monotônico, e
+ * alarmes, DMA ritmada e o roteiro de entradas avançam em hal_poll(),
+ * chamada sempre que o firmware lê o tempo, espera ou gira em
+ * tight_loop_contents().
+ *
+ * Variáveis de ambiente:
+ *   MONITOR_HOST_RUN_MS   encerra após esse tempo simulado (ms)
+ *   MONITOR_HOST_INPUT    roteiro de botões e joystick (hal_gpio.c)
+ *   MONITOR_HOST_PBM      diretório para os quadros do display em PBM
+ *   MONITOR_HOST_FLASH    imagem do log da flash (flashlog_file.c)
+ *
+ * O resumo de tráfego (I2C, PIO, DMA, ADC, alarmes) é escrito em stderr
+ * ao encerrar, para não se misturar à telemetria em stdout.
+ */
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/** @defgroup HalTime Tempo e encerramento (hal_time.c)
+ * @{
+ */
+/** Tempo desde o boot em us, sem processar eventos */
+uint64_t hal_time_us(void);
+/** Processa alarmes vencidos, DMA ritmada, entradas e o limite de execução */
+void hal_poll(void);
+/** true com as interrupções mascaradas (seção crítica) */
+bool hal_irq_masked(void);
+/** Escreve o resumo em stderr e encerra o processo */
+void hal_exit(int status);
+/** @} */
+
+/** @defgroup HalBus Barramento de 32 bits (hal_dma.c)
+ * @{
+ */
+/** Endereço de barramento de um ponteiro (aborta se não couber em 32 bits) */
+uint32_t hal_bus_addr(const volatile void *ptr);
+/** Ponteiro de um endereço de barramento */
+static inline volatile void *hal_bus_ptr(uint32_t addr) {
+    return (volatile void *)(uintptr_t)addr;
+}
+/** Avança os canais ritmados pelo ADC com as conversões disponíveis */
+void hal_dma_poll(void);
+void hal_dma_report(FILE *out);
+/** @} */
+
+/** @defgroup HalPeripherals Periféricos alcançados pela DMA
+ * @{
+ */
+/** Escrita em IC_DATA_CMD; false se addr não for de um controlador I2C */
+bool hal_i2c_bus_write(uint32_t addr, uint32_t value);
+/** Fim de uma cadeia de DMA: conclui quadros do display */
+void hal_i2c_dma_done(void);
+void hal_i2c_report(FILE *out);
+
+/** Escrita na FIFO de TX; false se addr não for de uma PIO */
+bool hal_pio_bus_write(uint32_t addr, uint32_t value);
+/** Fim de uma cadeia de DMA: conclui quadros dos NeoPixels */
+void hal_pio_dma_done(void);
+void hal_pio_report(FILE *out);
+
+/** Leitura da FIFO do ADC; false se addr não for a FIFO */
+bool hal_adc_bus_read(uint32_t addr, uint32_t *value);
+/** Gera as conversões vencidas; devolve quantas estão na FIFO */
+uint32_t hal_adc_poll(uint64_t now_us);
+void hal_adc_report(FILE *out);
+/** @} */
+
+/** @defgroup HalInput Entradas roteirizadas e saídas (hal_gpio.c)
+ * @{
+ */
+/** Aplica os eventos do roteiro vencidos */
+void hal_input_poll(uint64_t now_us);
+/** Entrega as bordas pendentes à callback de GPIO (fora da máscara) */
+void hal_gpio_irq_poll(void);
+/** true se há borda pendente para a callback de GPIO */
+bool hal_gpio_irq_pending(void);
+/** Instante do próximo evento do roteiro (UINT64_MAX se não houver) */
+uint64_t hal_input_next_us(void);
+/** Posição do joystick no canal do ADC (12 bits) */
+uint16_t hal_input_joystick(unsigned channel);
+void hal_gpio_report(FILE *out);
+/** @} */
+
+#endif // HOST_HAL_H
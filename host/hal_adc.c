@@ -0,0 +1,168 @@
+/**
+ * @file hal_adc.c
+ * @brief ADC do host
+ *
+ * Com adc_run(true) as conversões são geradas no ritmo do divisor (um
+ * clock de 48 MHz, 1 + div ciclos por conversão) e ficam na fila até a
+ * DMA ou a CPU lerem. O canal de cada conversão é fixado pela ordem do
+ * rodízio. Mais de 4 conversões pendentes estouram o FIFO, como no
+ * RP2040: as mais antigas são descartadas e FCS.OVER é indicado.
+ *
+ * FCS é memória comum no host e não tem escrita de 1 para apagar: o
+ * modelo o reescreve a cada atualização, e OVER/UNDER valem até
+ * adc_fifo_drain() ou adc_run().
+ */
+#include "hal.h"
+#include "hardware/adc.h"
+
+#define ADC_CLOCK_HZ 48000000u
+#define ADC_FIFO_DEPTH 4
+#define ADC_NUM_INPUTS 5
+#define TEMPERATURE_RAW 876     ///< 0,706 V: 27 °C
+#define NOISE_LSB 2
+
+static adc_hw_t adc_regs;
+adc_hw_t *adc_hw = &adc_regs;
+
+static uint selected = 0;           ///< Canal da próxima conversão
+static uint round_robin = 0;
+static bool running = false;
+static bool fifo_enabled = false;
+static float clkdiv = 0;
+
+static uint64_t run_start_us = 0;
+static uint64_t generated = 0;      ///< Conversões desde adc_run(true)
+static uint32_t queued = 0;         ///< Conversões ainda não lidas (FIFO)
+static uint queued_channel = 0;     ///< Canal da conversão mais antiga da fila
+static bool over = false;
+
+static uint64_t conversions = 0;
+static uint64_t overflows = 0;
+static uint32_t noise_state = 12345;
+
+static inline uint32_t rate_hz(void) {
+    return (uint32_t)(ADC_CLOCK_HZ / (1.0f + clkdiv));
+}
+/**
+ * @brief Próximo canal do rodízio após ch
+ */
+static uint next_channel(uint ch) {
+    if (round_robin == 0) return ch;
+    for (uint i = 1; i <= ADC_NUM_INPUTS; i++) {
+        uint candidate = (ch + i) % ADC_NUM_INPUTS;
+        if (round_robin & (1u << candidate)) return candidate;
+    }
+    return ch;
+}
+static uint16_t convert(uint channel) {
+    noise_state = noise_state * 1103515245u + 12345u;
+    int noise = (int)((noise_state >> 16) % (2 * NOISE_LSB + 1)) - NOISE_LSB;
+    int value = channel == 4 ? TEMPERATURE_RAW : channel < 2 ? hal_input_joystick(channel) : 0;
+    value += noise;
+    if (value < 0) value = 0;
+    if (value > 4095) value = 4095;
+    conversions++;
+    return (uint16_t)value;
+}
+static void publish(void) {
+    adc_regs.fcs = (fifo_enabled ? ADC_FCS_EN_BITS | ADC_FCS_DREQ_EN_BITS : 0) |
+                   ((queued > ADC_FIFO_DEPTH ? ADC_FIFO_DEPTH : queued) << ADC_FCS_LEVEL_LSB) |
+                   (over ? ADC_FCS_OVER_BITS : 0);
+}
+/**
+ * @brief Gera as conversões vencidas e aplica o limite do FIFO
+ *
+ * O que a DMA não leu desde a última chamada além de 4 conversões é
+ * descartado, e o rodízio segue. Após uma longa pausa do processo, no
+ * máximo 1 s de conversões é gerado.
+ */
+uint32_t hal_adc_poll(uint64_t now_us) {
+    if (queued > ADC_FIFO_DEPTH) {
+        for (uint32_t k = queued - ADC_FIFO_DEPTH; k > 0; k--) queued_channel = next_channel(queued_channel);
+        overflows += queued - ADC_FIFO_DEPTH;
+        queued = ADC_FIFO_DEPTH;
+        over = true;
+    }
+    if (running) {
+        uint64_t due = (now_us - run_start_us) * rate_hz() / 1000000u;
+        if (due - generated > rate_hz()) generated = due - rate_hz();
+        queued += (uint32_t)(due - generated);
+        generated = due;
+    }
+    publish();
+    return queued;
+}
+/**
+ * @brief Leitura da FIFO pela DMA: a conversão mais antiga da fila
+ */
+bool hal_adc_bus_read(uint32_t addr, uint32_t *value) {
+    if (addr != hal_bus_addr(&adc_regs.fifo)) return false;
+    if (queued == 0) {
+        *value = 0;
+        return true;
+    }
+    *value = convert(queued_channel);
+    queued_channel = next_channel(queued_channel);
+    queued--;
+    return true;
+}
+void hal_adc_report(FILE *out) {
+    fprintf(out, "adc:     %llu conversões a %lu Hz, %llu perdidas por estouro do FIFO\n",
+            (unsigned long long)conversions, (unsigned long)rate_hz(), (unsigned long long)overflows);
+}
+
+void adc_init(void) {
+    adc_regs.cs = ADC_CS_EN_BITS;
+    running = false;
+    queued = 0;
+    publish();
+}
+void adc_gpio_init(uint gpio) {
+    (void)gpio;
+}
+void adc_select_input(uint input) {
+    selected = input;
+}
+uint adc_get_selected_input(void) {
+    return selected;
+}
+void adc_set_round_robin(uint input_mask) {
+    round_robin = input_mask;
+}
+void adc_set_temp_sensor_enabled(bool enable) {
+    if (enable) adc_regs.cs |= ADC_CS_TS_EN_BITS;
+    else adc_regs.cs &= ~ADC_CS_TS_EN_BITS;
+}
+uint16_t adc_read(void) {
+    uint16_t value = convert(selected);
+    selected = next_channel(selected);
+    return value;
+}
+/**
+ * @brief Inicia ou para o rodízio a partir do canal selecionado
+ */
+void adc_run(bool run) {
+    if (run && !running) {
+        run_start_us = hal_time_us();
+        generated = 0;
+        queued_channel = selected;
+    }
+    running = run;
+    over = false;
+    if (run) adc_regs.cs |= ADC_CS_START_MANY_BITS;
+    else adc_regs.cs &= ~ADC_CS_START_MANY_BITS;
+    publish();
+}
+void adc_set_clkdiv(float div) {
+    clkdiv = div;
+}
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+    (void)dreq_en; (void)dreq_thresh; (void)err_in_fifo; (void)byte_shift;
+    fifo_enabled = en;
+    publish();
+}
+void adc_fifo_drain(void) {
+    queued = 0;
+    over = false;
+    publish();
+}
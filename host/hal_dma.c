@@ -0,0 +1,262 @@
+/**
+ * @file hal_dma.c
+ * @brief Controlador DMA do RP2040 emulado no host
+ *
+ * O estado visível fica nos próprios registradores (dma_hw): READ_ADDR,
+ * WRITE_ADDR e TRANS_COUNT avançam a cada transferência, como no
+ * hardware, e o valor de recarga do contador é guardado à parte. Escritas
+ * da própria DMA nos registradores passam pela mesma decodificação de
+ * aliases, inclusive disparo nulo, o que permite a técnica de blocos de
+ * controle.
+ *
+ * Um disparo executa imediatamente o canal e a cadeia que ele provoca,
+ * exceto canais ritmados pelo ADC, que transferem uma conversão por vez
+ * em hal_dma_poll().
+ */
+#include "hal.h"
+#include "hardware/dma.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Alinhado como no RP2040: os anéis de endereço dependem dos bits baixos
+static dma_hw_t dma_regs __attribute__((aligned(4096)));
+dma_hw_t *dma_hw = &dma_regs;
+
+static uint32_t reload[NUM_DMA_CHANNELS];   ///< TRANS_COUNT escrito (recarga)
+static bool busy[NUM_DMA_CHANNELS];
+static uint16_t claimed = 0;
+
+static uint32_t pending = 0;                ///< Canais disparados, ainda não executados
+static bool running = false;
+static bool touched_i2c = false;
+static bool touched_pio = false;
+
+static uint64_t transfers = 0;
+static uint64_t triggers = 0;
+static uint64_t null_triggers = 0;
+static uint64_t chains = 0;
+
+uint32_t hal_bus_addr(const volatile void *ptr) {
+    uintptr_t addr = (uintptr_t)ptr;
+    if (addr > UINT32_MAX) {
+        fprintf(stderr, "DMA: endereço %p fora do barramento de 32 bits (ligar sem PIE)\n", (void *)addr);
+        abort();
+    }
+    return (uint32_t)addr;
+}
+static inline uint32_t ctrl_of(uint ch) {
+    return dma_regs.ch[ch].ctrl_trig;
+}
+static inline uint treq_of(uint ch) {
+    return (ctrl_of(ch) & DMA_CH0_CTRL_TRIG_TREQ_SEL_BITS) >> DMA_CH0_CTRL_TRIG_TREQ_SEL_LSB;
+}
+static inline bool paced(uint ch) {
+    return treq_of(ch) == DREQ_ADC;
+}
+/**
+ * @brief Inicia um canal: recarrega o contador e agenda a execução
+ */
+static void trigger(uint ch) {
+    triggers++;
+    if (!(ctrl_of(ch) & DMA_CH0_CTRL_TRIG_EN_BITS)) return;
+    dma_regs.ch[ch].transfer_count = reload[ch];
+    if (reload[ch] == 0) return;
+    busy[ch] = true;
+    if (!paced(ch)) pending |= 1u << ch;
+}
+/**
+ * @brief Escrita em um registrador de canal, pelo offset no bloco do canal
+ *
+ * Aliases: 0x00-0x0C base, 0x10-0x1C alias 1, 0x20-0x2C alias 2,
+ * 0x30-0x3C alias 3; o último registrador de cada alias dispara o canal,
+ * salvo quando o valor escrito é zero (disparo nulo).
+ */
+static void write_channel_reg(uint ch, uint32_t offset, uint32_t value) {
+    dma_channel_hw_t *hw = &dma_regs.ch[ch];
+    switch (offset) {
+        case 0x00: case 0x14: case 0x28: case 0x3C: hw->read_addr = value; break;
+        case 0x04: case 0x18: case 0x2C: case 0x34: hw->write_addr = value; break;
+        case 0x08: case 0x1C: case 0x24: case 0x38: reload[ch] = value; break;
+        case 0x0C: case 0x10: case 0x20: case 0x30:
+            hw->ctrl_trig = value & ~DMA_CH0_CTRL_TRIG_BUSY_BITS;
+            break;
+        default: return;
+    }
+    if ((offset & 0xC) == 0xC) {
+        if (value == 0) null_triggers++;
+        else trigger(ch);
+    }
+}
+/**
+ * @brief Avança um endereço, respeitando o anel configurado
+ */
+static uint32_t advance(uint32_t addr, uint32_t size, uint32_t ring_bits) {
+    if (ring_bits == 0) return addr + size;
+    uint32_t mask = (1u << ring_bits) - 1;
+    return (addr & ~mask) | ((addr + size) & mask);
+}
+static uint32_t bus_read(uint32_t addr, uint32_t size) {
+    uint32_t value;
+    if (hal_adc_bus_read(addr, &value)) return value;
+    volatile void *p = hal_bus_ptr(addr);
+    switch (size) {
+        case 1: return *(volatile uint8_t *)p;
+        case 2: return *(volatile uint16_t *)p;
+        default: return *(volatile uint32_t *)p;
+    }
+}
+static void bus_write(uint32_t addr, uint32_t value, uint32_t size) {
+    uint32_t base = hal_bus_addr(&dma_regs);
+    if (addr >= base && addr < base + sizeof(dma_regs)) {
+        write_channel_reg((addr - base) / sizeof(dma_channel_hw_t), (addr - base) % sizeof(dma_channel_hw_t), value);
+        return;
+    }
+    if (hal_i2c_bus_write(addr, value)) {
+        touched_i2c = true;
+        return;
+    }
+    if (hal_pio_bus_write(addr, value)) {
+        touched_pio = true;
+        return;
+    }
+    volatile void *p = hal_bus_ptr(addr);
+    switch (size) {
+        case 1: *(volatile uint8_t *)p = (uint8_t)value; break;
+        case 2: *(volatile uint16_t *)p = (uint16_t)value; break;
+        default: *(volatile uint32_t *)p = value; break;
+    }
+}
+/**
+ * @brief Executa uma transferência; ao zerar o contador, encadeia
+ */
+static void step(uint ch) {
+    dma_channel_hw_t *hw = &dma_regs.ch[ch];
+    uint32_t ctrl = hw->ctrl_trig;
+    uint32_t size = 1u << ((ctrl & DMA_CH0_CTRL_TRIG_DATA_SIZE_BITS) >> DMA_CH0_CTRL_TRIG_DATA_SIZE_LSB);
+    uint32_t ring_bits = (ctrl & DMA_CH0_CTRL_TRIG_RING_SIZE_BITS) >> DMA_CH0_CTRL_TRIG_RING_SIZE_LSB;
+    bool ring_write = ctrl & DMA_CH0_CTRL_TRIG_RING_SEL_BITS;
+
+    uint32_t read = hw->read_addr;
+    uint32_t write = hw->write_addr;
+    bus_write(write, bus_read(read, size), size);
+    transfers++;
+    if (ctrl & DMA_CH0_CTRL_TRIG_INCR_READ_BITS) hw->read_addr = advance(read, size, ring_write ? 0 : ring_bits);
+    if (ctrl & DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS) hw->write_addr = advance(write, size, ring_write ? ring_bits : 0);
+
+    if (--hw->transfer_count == 0) {
+        busy[ch] = false;
+        uint chain_to = (ctrl & DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS) >> DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB;
+        if (chain_to != ch) trigger(chain_to);
+    }
+}
+/**
+ * @brief Executa os canais disparados até não restar nenhum pendente
+ *
+ * Ao fim, os periféricos alcançados concluem seus quadros.
+ */
+static void run_pending(void) {
+    if (running || pending == 0) return;
+    running = true;
+    while (pending) {
+        uint ch = (uint)__builtin_ctz(pending);
+        pending &= ~(1u << ch);
+        while (busy[ch] && !paced(ch)) step(ch);
+    }
+    running = false;
+    chains++;
+    if (touched_i2c) hal_i2c_dma_done();
+    if (touched_pio) hal_pio_dma_done();
+    touched_i2c = touched_pio = false;
+}
+void hal_dma_poll(void) {
+    uint32_t available = hal_adc_poll(hal_time_us());
+    for (uint ch = 0; ch < NUM_DMA_CHANNELS && available; ch++) {
+        while (available && busy[ch] && paced(ch)) {
+            step(ch);
+            available--;
+            if (pending) run_pending();
+        }
+    }
+}
+void hal_dma_report(FILE *out) {
+    fprintf(out, "dma:     %llu transferências, %llu disparos (%llu nulos), %llu cadeias\n",
+            (unsigned long long)transfers, (unsigned long long)triggers,
+            (unsigned long long)null_triggers, (unsigned long long)chains);
+}
+
+int dma_claim_unused_channel(bool required) {
+    for (uint ch = 0; ch < NUM_DMA_CHANNELS; ch++) {
+        if (!(claimed & (1u << ch))) {
+            claimed |= 1u << ch;
+            return (int)ch;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "DMA: nenhum canal livre\n");
+        abort();
+    }
+    return -1;
+}
+void dma_channel_unclaim(uint channel) {
+    claimed &= ~(1u << channel);
+}
+/**
+ * @brief Configuração padrão do SDK: habilitado, 32 bits, leitura
+ * incremental, sem encadeamento (chain_to = o próprio canal), sem DREQ
+ */
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    dma_channel_config c = {0};
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, DREQ_FORCE);
+    channel_config_set_chain_to(&c, channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_ring(&c, false, 0);
+    channel_config_set_irq_quiet(&c, false);
+    channel_config_set_enable(&c, true);
+    return c;
+}
+void dma_channel_set_config(uint channel, const dma_channel_config *config, bool trigger_now) {
+    write_channel_reg(channel, trigger_now ? 0x0C : 0x10, config->ctrl);
+    run_pending();
+}
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger_now) {
+    write_channel_reg(channel, trigger_now ? 0x3C : 0x14, hal_bus_addr(read_addr));
+    run_pending();
+}
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger_now) {
+    write_channel_reg(channel, trigger_now ? 0x2C : 0x18, hal_bus_addr(write_addr));
+    run_pending();
+}
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger_now) {
+    write_channel_reg(channel, trigger_now ? 0x1C : 0x24, trans_count);
+    run_pending();
+}
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger_now) {
+    dma_channel_set_read_addr(channel, read_addr, false);
+    dma_channel_set_write_addr(channel, write_addr, false);
+    dma_channel_set_trans_count(channel, transfer_count, false);
+    dma_channel_set_config(channel, config, trigger_now);
+}
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count) {
+    dma_channel_set_read_addr(channel, read_addr, false);
+    dma_channel_set_trans_count(channel, transfer_count, true);
+}
+void dma_channel_start(uint channel) {
+    trigger(channel);
+    run_pending();
+}
+void dma_channel_abort(uint channel) {
+    busy[channel] = false;
+    pending &= ~(1u << channel);
+}
+bool dma_channel_is_busy(uint channel) {
+    hal_poll();
+    return busy[channel];
+}
+void dma_channel_wait_for_finish_blocking(uint channel) {
+    while (dma_channel_is_busy(channel)) {
+        tight_loop_contents();
+    }
+}
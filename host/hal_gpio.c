@@ -0,0 +1,297 @@
+/**
+ * @file hal_gpio.c
+ * @brief GPIO, PWM e relógios do host, e o roteiro de entradas
+ *
+ * clock_configure() apenas registra a nova frequência: o tempo simulado
+ * não depende do clk_sys.
+ *
+ * Roteiro (MONITOR_HOST_INPUT): eventos separados por vírgula no formato
+ * ms:ação, com ms desde o boot. Ações:
+ *   a, b, j                 pressiona o botão A, B ou do joystick por 100 ms
+ *   A, B, J                 pressiona por 1500 ms (pressão longa)
+ *   left, right, up, down   inclina o joystick por 150 ms
+ * Cada pressionar e soltar repica duas vezes no primeiro 1 ms, como um
+ * contato mecânico; as bordas geram as interrupções de GPIO habilitadas.
+ * Sem a variável, o roteiro padrão liga todas as opções do menu inicial
+ * e inicia o monitoramento. MONITOR_HOST_INPUT= (vazio) não pressiona nada.
+ */
+#include "hal.h"
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define HOST_BUTTON_A_PIN 5
+#define HOST_BUTTON_B_PIN 6
+#define HOST_JOY_BUTTON_PIN 22
+
+#define PRESS_US 100000u
+#define LONG_PRESS_US 1500000u
+#define TILT_US 150000u
+#define BOUNCE_US 300u
+#define MAX_EVENTS 256
+
+#define JOY_CENTER 2048
+#define JOY_LOW 200
+#define JOY_HIGH 3900
+
+/** Liga as seis opções do menu inicial (A, direita, ...) e inicia (B) */
+#define DEFAULT_SCRIPT "4000:a,4300:right,4600:a,4900:right,5200:a,5500:right," \
+                       "5800:a,6100:right,6400:a,6700:right,7000:a,7300:b"
+
+typedef enum {
+    EV_PIN_LOW, EV_PIN_RELEASE, EV_JOY_SET
+} event_kind_t;
+
+typedef struct {
+    uint64_t at_us;
+    event_kind_t kind;
+    uint8_t arg;        ///< Pino, ou canal do joystick
+    uint16_t value;     ///< Posição do joystick
+} input_event_t;
+
+static input_event_t events[MAX_EVENTS];
+static int event_count = 0;
+static int next_event = 0;
+static bool script_loaded = false;
+
+static bool pin_out[NUM_BANK0_GPIOS];
+static bool pin_level[NUM_BANK0_GPIOS];
+static bool pin_pull_up[NUM_BANK0_GPIOS];
+static bool pin_pressed[NUM_BANK0_GPIOS];
+static uint32_t pin_toggles[NUM_BANK0_GPIOS];
+static uint32_t irq_mask[NUM_BANK0_GPIOS];
+static uint32_t irq_pending[NUM_BANK0_GPIOS];
+static gpio_irq_callback_t irq_callback = NULL;
+static uint32_t irqs_delivered = 0;
+static uint16_t joystick[2] = {JOY_CENTER, JOY_CENTER};
+
+static uint16_t pwm_wrap[8];
+static uint32_t pwm_div16[8];
+static uint32_t pwm_level_changes = 0;
+static uint32_t pwm_tones = 0;
+
+static uint32_t clock_hz[CLK_COUNT] = {
+    [clk_ref] = 12 * MHZ, [clk_sys] = 125 * MHZ, [clk_peri] = 125 * MHZ,
+    [clk_usb] = 48 * MHZ, [clk_adc] = 48 * MHZ,
+};
+static uint32_t clock_changes = 0;
+
+static systick_hw_t systick_regs;
+systick_hw_t *systick_hw = &systick_regs;
+
+static void add_event(uint64_t at_us, event_kind_t kind, uint8_t arg, uint16_t value) {
+    if (event_count == MAX_EVENTS) return;
+    events[event_count++] = (input_event_t){at_us, kind, arg, value};
+}
+/**
+ * @brief Pressiona ou solta com repique: três bordas em 2·BOUNCE_US
+ */
+static void add_bouncy_edge(uint64_t at_us, uint8_t pin, bool press) {
+    event_kind_t settle = press ? EV_PIN_LOW : EV_PIN_RELEASE;
+    event_kind_t glitch = press ? EV_PIN_RELEASE : EV_PIN_LOW;
+    add_event(at_us, settle, pin, 0);
+    add_event(at_us + BOUNCE_US, glitch, pin, 0);
+    add_event(at_us + 2 * BOUNCE_US, settle, pin, 0);
+}
+static int compare_events(const void *a, const void *b) {
+    const input_event_t *x = a, *y = b;
+    return (x->at_us > y->at_us) - (x->at_us < y->at_us);
+}
+/**
+ * @brief Converte o roteiro em eventos de pressionar e soltar
+ */
+static void load_script(void) {
+    script_loaded = true;
+    const char *env = getenv("MONITOR_HOST_INPUT");
+    char script[1024];
+    strncpy(script, env ? env : DEFAULT_SCRIPT, sizeof(script) - 1);
+    script[sizeof(script) - 1] = '\0';
+
+    for (char *item = strtok(script, ","); item != NULL; item = strtok(NULL, ",")) {
+        char *colon = strchr(item, ':');
+        if (colon == NULL) continue;
+        uint64_t at = strtoull(item, NULL, 10) * 1000;
+        const char *action = colon + 1;
+        int pin = strcasecmp(action, "a") == 0 ? HOST_BUTTON_A_PIN :
+                  strcasecmp(action, "b") == 0 ? HOST_BUTTON_B_PIN :
+                  strcasecmp(action, "j") == 0 ? HOST_JOY_BUTTON_PIN : -1;
+        if (pin >= 0) {
+            uint64_t duration = isupper((unsigned char)action[0]) ? LONG_PRESS_US : PRESS_US;
+            add_bouncy_edge(at, (uint8_t)pin, true);
+            add_bouncy_edge(at + duration, (uint8_t)pin, false);
+            continue;
+        }
+        // Canal 1 (X) e canal 0 (Y) do ADC, como na BitDogLab
+        int channel = -1;
+        uint16_t value = JOY_CENTER;
+        if (strcmp(action, "left") == 0) { channel = 1; value = JOY_LOW; }
+        else if (strcmp(action, "right") == 0) { channel = 1; value = JOY_HIGH; }
+        else if (strcmp(action, "down") == 0) { channel = 0; value = JOY_LOW; }
+        else if (strcmp(action, "up") == 0) { channel = 0; value = JOY_HIGH; }
+        if (channel < 0) {
+            fprintf(stderr, "MONITOR_HOST_INPUT: ação desconhecida '%s'\n", action);
+            continue;
+        }
+        add_event(at, EV_JOY_SET, (uint8_t)channel, value);
+        add_event(at + TILT_US, EV_JOY_SET, (uint8_t)channel, JOY_CENTER);
+    }
+    qsort(events, (size_t)event_count, sizeof(events[0]), compare_events);
+}
+/**
+ * @brief Nível lido num pino de entrada
+ */
+static bool input_level(uint gpio) {
+    return pin_pressed[gpio] ? false : pin_pull_up[gpio];
+}
+/**
+ * @brief Aplica um pressionar/soltar e registra a borda para a interrupção
+ */
+static void set_pressed(uint8_t pin, bool pressed) {
+    bool before = input_level(pin);
+    pin_pressed[pin] = pressed;
+    bool after = input_level(pin);
+    if (before == after) return;
+    irq_pending[pin] |= (after ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL) & irq_mask[pin];
+}
+void hal_input_poll(uint64_t now_us) {
+    if (!script_loaded) load_script();
+    while (next_event < event_count && events[next_event].at_us <= now_us) {
+        const input_event_t *ev = &events[next_event++];
+        switch (ev->kind) {
+            case EV_PIN_LOW: set_pressed(ev->arg, true); break;
+            case EV_PIN_RELEASE: set_pressed(ev->arg, false); break;
+            case EV_JOY_SET: joystick[ev->arg] = ev->value; break;
+        }
+    }
+}
+/**
+ * @brief Entrega as bordas pendentes à callback de GPIO
+ *
+ * Como no RP2040, as bordas acumulam enquanto as interrupções estão
+ * mascaradas e chegam juntas numa única chamada por pino.
+ */
+void hal_gpio_irq_poll(void) {
+    if (irq_callback == NULL) return;
+    for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+        uint32_t events = irq_pending[pin];
+        if (events == 0) continue;
+        irq_pending[pin] = 0;
+        irqs_delivered++;
+        irq_callback(pin, events);
+    }
+}
+bool hal_gpio_irq_pending(void) {
+    if (irq_callback == NULL) return false;
+    for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+        if (irq_pending[pin]) return true;
+    }
+    return false;
+}
+uint64_t hal_input_next_us(void) {
+    if (!script_loaded) load_script();
+    return next_event < event_count ? events[next_event].at_us : UINT64_MAX;
+}
+uint16_t hal_input_joystick(unsigned channel) {
+    return channel < 2 ? joystick[channel] : JOY_CENTER;
+}
+void hal_gpio_report(FILE *out) {
+    fprintf(out, "gpio:    roteiro %d/%d eventos, %lu interrupções; trocas de nível:", next_event, event_count,
+            (unsigned long)irqs_delivered);
+    for (int pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+        if (pin_toggles[pin]) fprintf(out, " gp%d=%lu", pin, (unsigned long)pin_toggles[pin]);
+    }
+    fprintf(out, "\npwm:     %lu mudanças de nível, %lu tons\n", (unsigned long)pwm_level_changes,
+            (unsigned long)pwm_tones);
+    fprintf(out, "clocks:  %lu reconfigurações, clk_sys %lu Hz, clk_peri %lu Hz\n", (unsigned long)clock_changes,
+            (unsigned long)clock_hz[clk_sys], (unsigned long)clock_hz[clk_peri]);
+}
+
+void gpio_init(uint gpio) {
+    pin_out[gpio] = false;
+    pin_level[gpio] = false;
+}
+void gpio_set_dir(uint gpio, bool out) {
+    pin_out[gpio] = out;
+}
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+    (void)gpio;
+    (void)fn;
+}
+void gpio_pull_up(uint gpio) {
+    pin_pull_up[gpio] = true;
+}
+void gpio_pull_down(uint gpio) {
+    pin_pull_up[gpio] = false;
+}
+void gpio_disable_pulls(uint gpio) {
+    pin_pull_up[gpio] = false;
+}
+void gpio_set_input_enabled(uint gpio, bool enabled) {
+    (void)gpio;
+    (void)enabled;
+}
+void gpio_put(uint gpio, bool value) {
+    if (pin_level[gpio] != value) pin_toggles[gpio]++;
+    pin_level[gpio] = value;
+}
+/**
+ * @brief Saída: nível escrito; entrada: botão pressionado leva a 0
+ */
+bool gpio_get(uint gpio) {
+    hal_poll();
+    if (pin_out[gpio]) return pin_level[gpio];
+    return input_level(gpio);
+}
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled) {
+    if (enabled) irq_mask[gpio] |= event_mask;
+    else irq_mask[gpio] &= ~event_mask;
+    irq_pending[gpio] &= irq_mask[gpio];
+}
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled,
+                                        gpio_irq_callback_t callback) {
+    gpio_set_irq_enabled(gpio, event_mask, enabled);
+    irq_callback = callback;
+}
+void gpio_acknowledge_irq(uint gpio, uint32_t event_mask) {
+    irq_pending[gpio] &= ~event_mask;
+}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap) {
+    pwm_wrap[slice_num & 7] = wrap;
+}
+void pwm_set_clkdiv(uint slice_num, float divider) {
+    pwm_div16[slice_num & 7] = (uint32_t)(divider * 16.0f);
+}
+void pwm_set_clkdiv_int_frac(uint slice_num, uint8_t integer, uint8_t fract) {
+    pwm_div16[slice_num & 7] = ((uint32_t)integer << 4) | (fract & 0xF);
+}
+void pwm_set_enabled(uint slice_num, bool enabled) {
+    (void)slice_num;
+    (void)enabled;
+}
+void pwm_set_gpio_level(uint gpio, uint16_t level) {
+    static uint16_t last_level[NUM_BANK0_GPIOS];
+    if (level != last_level[gpio]) {
+        pwm_level_changes++;
+        if (level != 0) pwm_tones++;
+    }
+    last_level[gpio] = level;
+}
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    return clk_index < CLK_COUNT ? clock_hz[clk_index] : 0;
+}
+bool clock_configure(enum clock_index clk_index, uint32_t src, uint32_t auxsrc, uint32_t src_freq,
+                     uint32_t freq) {
+    (void)src;
+    (void)auxsrc;
+    if (clk_index >= CLK_COUNT || freq == 0 || freq > src_freq) return false;
+    if (clock_hz[clk_index] != freq) clock_changes++;
+    clock_hz[clk_index] = freq;
+    return true;
+}
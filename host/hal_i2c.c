@@ -0,0 +1,282 @@
+/**
+ * @file hal_i2c.c
+ * @brief Controladores I2C do host e o SSD1306 simulado (0x3C)
+ *
+ * Palavras escritas em IC_DATA_CMD (pela CPU ou pela DMA) formam uma
+ * transação até o bit STOP; i2c_write_blocking() entrega a transação
+ * inteira. O SSD1306 interpreta o byte de controle (0x00 comandos,
+ * 0x40 dados), os comandos de endereçamento e a linha inicial, e mantém
+ * a GDDRAM. O decodificador de comandos conserva o estado entre
+ * transações, como o controlador real, pois o firmware envia os
+ * argumentos de um comando em transações separadas.
+ *
+ * Com MONITOR_HOST_I2C_MAX_KHZ=N, transações com o controlador acima de
+ * N kHz ficam sem ACK (display ou fiação que não suportam Fast-mode Plus):
+ * i2c_write_blocking() falha e a DMA sinaliza TX_ABRT.
+ *
+ * Com MONITOR_HOST_PBM=DIR, cada quadro que altera a tela é salvo como
+ * DIR/frame_NNNNN.pbm, e a tela final como DIR/display.pbm. O quadro é a
+ * imagem vista pelo usuário (linha inicial e inversão aplicadas).
+ */
+#include "hal.h"
+#include "hardware/i2c.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SSD1306_ADDR 0x3C
+#define SSD1306_WIDTH 128
+#define SSD1306_PAGES 8
+#define SSD1306_HEIGHT (SSD1306_PAGES * 8)
+#define MAX_TRANSACTION 2048
+
+static i2c_hw_t i2c0_regs, i2c1_regs;
+i2c_inst_t i2c0_inst = {&i2c0_regs, false};
+i2c_inst_t i2c1_inst = {&i2c1_regs, false};
+
+/** Transação em montagem por controlador */
+typedef struct {
+    uint8_t bytes[MAX_TRANSACTION];
+    size_t len;
+    uint8_t addr;
+} transaction_t;
+static transaction_t open_tx[2];
+
+static uint32_t baudrate[2];
+static uint64_t bytes_total = 0;
+static uint64_t bytes_display = 0;
+static uint64_t transactions = 0;
+static uint64_t nacks = 0;
+static uint64_t bus_time_us = 0;     ///< Tempo estimado no fio (9 bits por byte)
+static int64_t max_baud = -1;        ///< MONITOR_HOST_I2C_MAX_KHZ em Hz (0 = sem limite)
+
+/** Estado do SSD1306 */
+static struct {
+    uint8_t gddram[SSD1306_PAGES][SSD1306_WIDTH];
+    uint8_t col_start, col_end, col;
+    uint8_t page_start, page_end, page;
+    uint8_t start_line;
+    bool inverted;
+    bool on;
+    uint8_t cmd[8];        ///< Comando em decodificação e argumentos
+    uint8_t cmd_len;
+    uint8_t cmd_need;
+    bool dirty;            ///< GDDRAM ou modo alterados desde o último quadro
+} oled = {.col_end = SSD1306_WIDTH - 1, .page_end = SSD1306_PAGES - 1};
+
+static uint32_t frames_done = 0;
+static uint32_t frames_dumped = 0;
+static uint8_t last_dumped[SSD1306_HEIGHT][SSD1306_WIDTH / 8];
+static bool has_dump = false;
+
+static inline uint index_of(i2c_hw_t *hw) {
+    return hw == &i2c1_regs ? 1 : 0;
+}
+/**
+ * @brief Argumentos de cada comando do SSD1306
+ */
+static uint8_t command_args(uint8_t cmd) {
+    switch (cmd) {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5:
+        case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+    }
+}
+static void execute_command(const uint8_t *cmd) {
+    switch (cmd[0]) {
+        case 0x21:
+            oled.col_start = oled.col = cmd[1] & 0x7F;
+            oled.col_end = cmd[2] & 0x7F;
+            break;
+        case 0x22:
+            oled.page_start = oled.page = cmd[1] & 0x07;
+            oled.page_end = cmd[2] & 0x07;
+            break;
+        case 0xA6: case 0xA7:
+            oled.inverted = cmd[0] == 0xA7;
+            oled.dirty = true;
+            break;
+        case 0xAE: case 0xAF:
+            oled.on = cmd[0] == 0xAF;
+            oled.dirty = true;
+            break;
+        default:
+            if (cmd[0] >= 0x40 && cmd[0] <= 0x7F) {
+                oled.start_line = cmd[0] & 0x3F;
+                oled.dirty = true;
+            }
+            break;
+    }
+}
+static void oled_command_byte(uint8_t byte) {
+    if (oled.cmd_len == 0) oled.cmd_need = command_args(byte);
+    oled.cmd[oled.cmd_len++] = byte;
+    if (oled.cmd_len > oled.cmd_need) {
+        execute_command(oled.cmd);
+        oled.cmd_len = 0;
+    }
+}
+/**
+ * @brief Escreve um byte de dados no endereçamento horizontal
+ */
+static void oled_data_byte(uint8_t byte) {
+    if (oled.gddram[oled.page][oled.col] != byte) oled.dirty = true;
+    oled.gddram[oled.page][oled.col] = byte;
+    if (oled.col < oled.col_end) {
+        oled.col++;
+        return;
+    }
+    oled.col = oled.col_start;
+    oled.page = oled.page < oled.page_end ? oled.page + 1 : oled.page_start;
+}
+/**
+ * @brief Entrega uma transação ao SSD1306
+ *
+ * Com Co = 0 (0x00 ou 0x40) o restante da transação tem o tipo do byte
+ * de controle.
+ */
+static void oled_transaction(const uint8_t *bytes, size_t len) {
+    if (len == 0) return;
+    bool data = bytes[0] & 0x40;
+    for (size_t i = 1; i < len; i++) {
+        if (data) oled_data_byte(bytes[i]);
+        else oled_command_byte(bytes[i]);
+    }
+}
+/**
+ * @brief Imagem vista no painel: linha inicial, inversão e display desligado
+ */
+static void render(uint8_t image[SSD1306_HEIGHT][SSD1306_WIDTH / 8]) {
+    memset(image, 0, SSD1306_HEIGHT * SSD1306_WIDTH / 8);
+    for (int y = 0; y < SSD1306_HEIGHT; y++) {
+        int row = (y + oled.start_line) % SSD1306_HEIGHT;
+        for (int x = 0; x < SSD1306_WIDTH; x++) {
+            bool lit = oled.on && (((oled.gddram[row / 8][x] >> (row % 8)) & 1) != oled.inverted);
+            if (lit) image[y][x / 8] |= (uint8_t)(0x80 >> (x % 8));
+        }
+    }
+}
+static bool write_pbm(const char *path, uint8_t image[SSD1306_HEIGHT][SSD1306_WIDTH / 8]) {
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) return false;
+    fprintf(f, "P4\n%d %d\n", SSD1306_WIDTH, SSD1306_HEIGHT);
+    fwrite(image, 1, SSD1306_HEIGHT * SSD1306_WIDTH / 8, f);
+    return fclose(f) == 0;
+}
+/**
+ * @brief Conclui um quadro e o salva se a imagem mudou
+ */
+static void oled_frame_done(void) {
+    if (!oled.dirty) return;
+    oled.dirty = false;
+    frames_done++;
+
+    const char *dir = getenv("MONITOR_HOST_PBM");
+    if (dir == NULL || dir[0] == '\0') return;
+    uint8_t image[SSD1306_HEIGHT][SSD1306_WIDTH / 8];
+    render(image);
+    if (has_dump && memcmp(image, last_dumped, sizeof(image)) == 0) return;
+    memcpy(last_dumped, image, sizeof(image));
+    has_dump = true;
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/frame_%05lu.pbm", dir, (unsigned long)frames_dumped);
+    if (write_pbm(path, image)) frames_dumped++;
+}
+/**
+ * @brief O dispositivo responde no clock atual do controlador?
+ */
+static bool clock_supported(uint index) {
+    if (max_baud < 0) {
+        const char *env = getenv("MONITOR_HOST_I2C_MAX_KHZ");
+        max_baud = (env != NULL && env[0] != '\0') ? strtoll(env, NULL, 10) * 1000 : 0;
+    }
+    return max_baud == 0 || baudrate[index] <= max_baud;
+}
+/**
+ * @brief Entrega a transação ao dispositivo endereçado
+ * @return false se ninguém respondeu (NACK)
+ */
+static bool deliver(uint index, const uint8_t *bytes, size_t len, uint8_t addr) {
+    transactions++;
+    bytes_total += len;
+    if (baudrate[index]) bus_time_us += (uint64_t)(len + 1) * 9 * 1000000u / baudrate[index];
+    if (addr != SSD1306_ADDR || !clock_supported(index)) {
+        nacks++;
+        return false;
+    }
+    bytes_display += len;
+    oled_transaction(bytes, len);
+    return true;
+}
+bool hal_i2c_bus_write(uint32_t addr, uint32_t value) {
+    i2c_hw_t *hw;
+    if (addr == hal_bus_addr(&i2c0_regs.data_cmd)) hw = &i2c0_regs;
+    else if (addr == hal_bus_addr(&i2c1_regs.data_cmd)) hw = &i2c1_regs;
+    else return false;
+
+    uint index = index_of(hw);
+    transaction_t *tx = &open_tx[index];
+    if (tx->len == 0) tx->addr = (uint8_t)hw->tar;
+    if (tx->len < MAX_TRANSACTION) tx->bytes[tx->len++] = (uint8_t)value;
+    if (value & I2C_IC_DATA_CMD_STOP_BITS) {
+        if (!deliver(index, tx->bytes, tx->len, tx->addr)) hw->raw_intr_stat |= I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+        tx->len = 0;
+    }
+    return true;
+}
+void hal_i2c_dma_done(void) {
+    oled_frame_done();
+}
+void hal_i2c_report(FILE *out) {
+    fprintf(out, "i2c:     %llu transações, %llu bytes (%llu para 0x3C), %llu sem resposta, "
+                 "%.1f ms no barramento a %u kHz\n",
+            (unsigned long long)transactions, (unsigned long long)bytes_total,
+            (unsigned long long)bytes_display, (unsigned long long)nacks, bus_time_us / 1000.0,
+            baudrate[1] / 1000);
+    fprintf(out, "display: %lu quadros, %lu salvos em PBM\n", (unsigned long)frames_done,
+            (unsigned long)frames_dumped);
+
+    const char *dir = getenv("MONITOR_HOST_PBM");
+    if (dir != NULL && dir[0] != '\0') {
+        uint8_t image[SSD1306_HEIGHT][SSD1306_WIDTH / 8];
+        char path[512];
+        render(image);
+        snprintf(path, sizeof(path), "%s/display.pbm", dir);
+        write_pbm(path, image);
+    }
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baud) {
+    i2c->hw->enable = 0;
+    i2c->hw->tar = 0x055;       // Valor de reset de IC_TAR
+    i2c->hw->status = I2C_IC_STATUS_TFE_BITS | I2C_IC_STATUS_TFNF_BITS;
+    i2c->hw->raw_intr_stat = 0;
+    i2c->hw->enable = 1;
+    return i2c_set_baudrate(i2c, baud);
+}
+void i2c_deinit(i2c_inst_t *i2c) {
+    i2c->hw->enable = 0;
+}
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baud) {
+    baudrate[index_of(i2c->hw)] = baud;
+    return baud;
+}
+/**
+ * @brief Transação completa a partir da CPU
+ * @return len, ou PICO_ERROR_GENERIC se nenhum dispositivo responder
+ */
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)nostop;
+    i2c->hw->tar = addr;
+    bool acked = deliver(index_of(i2c->hw), src, len, addr);
+    oled_frame_done();
+    return acked ? (int)len : PICO_ERROR_GENERIC;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file hal_pio.c
+ * @brief PIO do host: registra as palavras da FIFO de TX
+ *
+ * Cada cadeia de DMA (ou sequência de pio_sm_put_blocking() seguida de
+ * uma cadeia) que escreve na FIFO conclui um quadro de NeoPixels. O
+ * resumo mostra quantos quadros e palavras saíram e o último quadro, em
+ * GRB como o programa PIO o envia (24 bits mais altos da palavra).
+ */
+#include "hal.h"
+#include "hardware/pio.h"
+
+#define MAX_FRAME_WORDS 64
+
+pio_hw_t pio0_hw_inst;
+pio_hw_t pio1_hw_inst;
+
+static uint32_t frame[MAX_FRAME_WORDS];
+static uint32_t frame_len = 0;
+static uint32_t last_frame[MAX_FRAME_WORDS];
+static uint32_t last_len = 0;
+static uint64_t words = 0;
+static uint64_t frames = 0;
+static uint8_t used_instructions[2] = {0, 0};
+
+static void push(uint32_t value) {
+    words++;
+    if (frame_len < MAX_FRAME_WORDS) frame[frame_len++] = value;
+}
+bool hal_pio_bus_write(uint32_t addr, uint32_t value) {
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++) {
+        if (addr == hal_bus_addr(&pio0_hw_inst.txf[sm]) || addr == hal_bus_addr(&pio1_hw_inst.txf[sm])) {
+            push(value);
+            return true;
+        }
+    }
+    return false;
+}
+void hal_pio_dma_done(void) {
+    if (frame_len == 0) return;
+    frames++;
+    for (uint32_t i = 0; i < frame_len; i++) last_frame[i] = frame[i];
+    last_len = frame_len;
+    frame_len = 0;
+}
+void hal_pio_report(FILE *out) {
+    fprintf(out, "pio:     %llu palavras, %llu quadros; último quadro (GRB):",
+            (unsigned long long)words, (unsigned long long)frames);
+    for (uint32_t i = 0; i < last_len; i++) fprintf(out, " %06lx", (unsigned long)(last_frame[i] >> 8));
+    fprintf(out, "\n");
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    uint index = pio_get_index(pio);
+    uint offset = used_instructions[index];
+    used_instructions[index] = (uint8_t)(offset + program->length);
+    return offset;
+}
+void pio_gpio_init(PIO pio, uint pin) {
+    (void)pio;
+    (void)pin;
+}
+int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out) {
+    (void)pio; (void)sm; (void)pin_base; (void)pin_count; (void)is_out;
+    return PICO_OK;
+}
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) {
+    (void)pio; (void)sm; (void)initial_pc; (void)config;
+    return PICO_OK;
+}
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {
+    (void)pio;
+    (void)sm;
+    (void)enabled;
+}
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+    pio->txf[sm] = data;
+    push(data);
+}
@@ -0,0 +1,43 @@
+/**
+ * @file hal_stdio.c
+ * @brief E/S padrão do host: stdout e stdin do processo
+ *
+ * stdin é consultado com poll(), sem alterar o modo do descritor (que
+ * pode ser compartilhado com o shell). Em um terminal os caracteres
+ * chegam após Enter; por um pipe, imediatamente. Fim de arquivo em stdin
+ * equivale a nenhum caractere.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include "hal.h"
+#include "pico/stdio.h"
+#include <poll.h>
+#include <unistd.h>
+
+static bool stdin_eof = false;
+
+bool stdio_init_all(void) {
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    hal_poll();
+    return true;
+}
+int getchar_timeout_us(uint32_t timeout_us) {
+    hal_poll();
+    if (stdin_eof) return PICO_ERROR_TIMEOUT;
+    struct pollfd fd = {.fd = STDIN_FILENO, .events = POLLIN};
+    if (poll(&fd, 1, (int)(timeout_us / 1000)) <= 0 || !(fd.revents & (POLLIN | POLLHUP))) {
+        return PICO_ERROR_TIMEOUT;
+    }
+    unsigned char c;
+    if (read(STDIN_FILENO, &c, 1) != 1) {
+        stdin_eof = true;
+        return PICO_ERROR_TIMEOUT;
+    }
+    return c;
+}
+int stdio_put_string(const char *s, int len, bool newline, bool cr_translation) {
+    (void)cr_translation;
+    fwrite(s, 1, (size_t)len, stdout);
+    if (newline) fputc('\n', stdout);
+    fflush(stdout);
+    return len;
+}
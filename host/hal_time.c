@@ -0,0 +1,255 @@
+/**
+ * @file hal_time.c
+ * @brief Tempo, espera, alarmes e seções críticas do host
+ *
+ * Os alarmes formam uma única fila, qualquer que seja o pool. Uma
+ * callback executa dentro de hal_poll(), como uma interrupção que
+ * chegasse naquele ponto, e nunca com as interrupções mascaradas nem
+ * dentro de outra callback; ao desmascarar, as pendentes são entregues
+ * como no hardware. As esperas dormem até o próximo alarme ou evento de
+ * entrada, de modo que o processo não ocupa a CPU enquanto o firmware
+ * está ocioso.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include "hal.h"
+#include "pico/time.h"
+#include "hardware/sync.h"
+#include <signal.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define HAL_MAX_ALARMS 16
+
+struct alarm_pool {
+    int unused;
+};
+
+typedef struct {
+    alarm_id_t id;           ///< 0 = livre
+    uint64_t target_us;
+    alarm_callback_t callback;
+    void *user_data;
+} host_alarm_t;
+
+static struct timespec boot;
+static bool booted = false;
+static uint64_t run_limit_us = 0;     ///< 0 = sem limite
+static volatile sig_atomic_t stop_requested = 0;
+
+static alarm_pool_t default_pool;
+static host_alarm_t alarms[HAL_MAX_ALARMS];
+static alarm_id_t next_alarm_id = 1;
+static uint32_t irq_mask_depth = 0;
+static bool in_poll = false;
+
+static uint64_t alarms_fired = 0;
+static uint64_t sleep_calls = 0;
+static uint64_t wfi_calls = 0;
+static uint64_t slept_us = 0;
+
+static void on_signal(int sig) {
+    (void)sig;
+    stop_requested = 1;
+}
+/**
+ * @brief Marca o boot no primeiro uso e lê o limite de execução
+ */
+static void hal_boot(void) {
+    if (booted) return;
+    booted = true;
+    clock_gettime(CLOCK_MONOTONIC, &boot);
+    const char *limit = getenv("MONITOR_HOST_RUN_MS");
+    if (limit != NULL) run_limit_us = strtoull(limit, NULL, 10) * 1000;
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+}
+uint64_t hal_time_us(void) {
+    hal_boot();
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - boot.tv_sec) * 1000000u + (uint64_t)((now.tv_nsec - boot.tv_nsec) / 1000);
+}
+bool hal_irq_masked(void) {
+    return irq_mask_depth > 0 || in_poll;
+}
+/**
+ * @brief Alarme livre mais cedo vencido até now_us, ou NULL
+ */
+static host_alarm_t *earliest_due(uint64_t now_us) {
+    host_alarm_t *best = NULL;
+    for (int i = 0; i < HAL_MAX_ALARMS; i++) {
+        if (alarms[i].id != 0 && alarms[i].target_us <= now_us &&
+            (best == NULL || alarms[i].target_us < best->target_us)) {
+            best = &alarms[i];
+        }
+    }
+    return best;
+}
+static void fire_alarms(void) {
+    host_alarm_t *alarm;
+    while ((alarm = earliest_due(hal_time_us())) != NULL) {
+        alarm_id_t id = alarm->id;
+        uint64_t target = alarm->target_us;
+        alarms_fired++;
+        int64_t repeat = alarm->callback(id, alarm->user_data);
+        // A callback pode ter cancelado o próprio alarme
+        if (alarm->id != id) continue;
+        if (repeat > 0) {
+            alarm->target_us = target + (uint64_t)repeat;
+        } else if (repeat < 0) {
+            alarm->target_us = hal_time_us() + (uint64_t)-repeat;
+        } else {
+            alarm->id = 0;
+        }
+    }
+}
+void hal_poll(void) {
+    if (in_poll) return;
+    if (stop_requested || (run_limit_us != 0 && hal_time_us() >= run_limit_us)) hal_exit(0);
+    in_poll = true;
+    uint64_t now = hal_time_us();
+    hal_input_poll(now);
+    hal_dma_poll();
+    if (irq_mask_depth == 0) {
+        hal_gpio_irq_poll();
+        fire_alarms();
+    }
+    in_poll = false;
+}
+/**
+ * @brief Próximo instante em que hal_poll() tem algo a fazer
+ */
+static uint64_t next_event_us(void) {
+    uint64_t next = hal_input_next_us();
+    for (int i = 0; i < HAL_MAX_ALARMS; i++) {
+        if (alarms[i].id != 0 && alarms[i].target_us < next) next = alarms[i].target_us;
+    }
+    if (run_limit_us != 0 && run_limit_us < next) next = run_limit_us;
+    return next;
+}
+void hal_exit(int status) {
+    fflush(stdout);
+    uint64_t elapsed = hal_time_us();
+    fprintf(stderr, "\n=== HAL do host: %.3f s ===\n", elapsed / 1e6);
+    fprintf(stderr, "tempo:   %llu alarmes disparados, %llu esperas, %llu WFI, %.1f%% do tempo dormindo\n",
+            (unsigned long long)alarms_fired, (unsigned long long)sleep_calls, (unsigned long long)wfi_calls,
+            elapsed ? 100.0 * (double)slept_us / (double)elapsed : 0.0);
+    hal_i2c_report(stderr);
+    hal_pio_report(stderr);
+    hal_dma_report(stderr);
+    hal_adc_report(stderr);
+    hal_gpio_report(stderr);
+    exit(status);
+}
+
+absolute_time_t get_absolute_time(void) {
+    hal_poll();
+    return hal_time_us();
+}
+uint64_t time_us_64(void) {
+    hal_poll();
+    return hal_time_us();
+}
+uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+void tight_loop_contents(void) {
+    hal_poll();
+}
+/**
+ * @brief Dorme até target, acordando para alarmes e entradas no caminho
+ *
+ * A DMA ritmada pelo ADC é atendida a cada 1 ms, como se a FIFO do ADC
+ * fosse esvaziada continuamente.
+ */
+void sleep_until(absolute_time_t target) {
+    sleep_calls++;
+    hal_poll();
+    uint64_t now;
+    while ((now = hal_time_us()) < target) {
+        uint64_t wake = next_event_us();
+        if (wake > target) wake = target;
+        if (wake > now + 1000) wake = now + 1000;
+        if (wake > now) {
+            uint64_t us = wake - now;
+            struct timespec ts = {(time_t)(us / 1000000), (long)(us % 1000000) * 1000};
+            nanosleep(&ts, NULL);
+            slept_us += us;
+        }
+        hal_poll();
+    }
+}
+/**
+ * @brief Dorme até um alarme vencer ou uma borda de GPIO ficar pendente
+ *
+ * Não entrega nada: com as interrupções mascaradas, a entrega ocorre em
+ * restore_interrupts().
+ */
+void hal_wfi(void) {
+    wfi_calls++;
+    while (true) {
+        hal_poll();
+        uint64_t now = hal_time_us();
+        if (earliest_due(now) != NULL || hal_gpio_irq_pending()) return;
+        uint64_t wake = next_event_us();
+        if (wake > now + 1000) wake = now + 1000;
+        if (wake > now) {
+            uint64_t us = wake - now;
+            struct timespec ts = {(time_t)(us / 1000000), (long)(us % 1000000) * 1000};
+            nanosleep(&ts, NULL);
+            slept_us += us;
+        }
+    }
+}
+void sleep_us(uint64_t us) {
+    sleep_until(hal_time_us() + us);
+}
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000);
+}
+
+alarm_pool_t *alarm_pool_get_default(void) {
+    return &default_pool;
+}
+alarm_pool_t *alarm_pool_create_with_unused_hardware_alarm(uint max_timers) {
+    (void)max_timers;
+    return &default_pool;
+}
+/**
+ * @brief Agenda um alarme
+ * @return Identificador (> 0), ou -1 sem espaço na fila
+ */
+alarm_id_t alarm_pool_add_alarm_in_us(alarm_pool_t *pool, uint64_t us, alarm_callback_t callback,
+                                      void *user_data, bool fire_if_past) {
+    (void)pool;
+    (void)fire_if_past;
+    for (int i = 0; i < HAL_MAX_ALARMS; i++) {
+        if (alarms[i].id == 0) {
+            alarms[i].id = next_alarm_id;
+            next_alarm_id = next_alarm_id == INT32_MAX ? 1 : next_alarm_id + 1;
+            alarms[i].target_us = hal_time_us() + us;
+            alarms[i].callback = callback;
+            alarms[i].user_data = user_data;
+            return alarms[i].id;
+        }
+    }
+    return -1;
+}
+bool alarm_pool_cancel_alarm(alarm_pool_t *pool, alarm_id_t alarm_id) {
+    (void)pool;
+    for (int i = 0; i < HAL_MAX_ALARMS; i++) {
+        if (alarm_id > 0 && alarms[i].id == alarm_id) {
+            alarms[i].id = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t save_and_disable_interrupts(void) {
+    return irq_mask_depth++;
+}
+void restore_interrupts(uint32_t status) {
+    irq_mask_depth = status;
+    if (irq_mask_depth == 0 && !in_poll) hal_poll();
+}
@@ -0,0 +1,74 @@
+# == Compilação do firmware para o host (Linux) ==
+#
+# Os mesmos fontes do firmware, com os cabeçalhos do pico-sdk de
+# host/include e os periféricos simulados de host/*.c. O log da flash usa
+# um arquivo (host/flashlog_file.c) no lugar de flashlog_flash.c.
+#
+# A DMA simulada trabalha com endereços de 32 bits, como o barramento do
+# RP2040: o executável é ligado sem PIE para que os buffers estáticos
+# fiquem abaixo de 4 GiB.
+
+if (MONITOR_DUAL_CORE)
+    message(FATAL_ERROR "MONITOR_HOST nao suporta MONITOR_DUAL_CORE (a HAL do host tem um unico nucleo)")
+endif()
+
+add_executable(monitor_host
+    ${MONITOR_SOURCES}
+    host/hal_time.c
+    host/hal_gpio.c
+    host/hal_stdio.c
+    host/hal_dma.c
+    host/hal_i2c.c
+    host/hal_pio.c
+    host/hal_adc.c
+    host/flashlog_file.c
+)
+
+# host/include vem antes do diretório principal: substitui monitor.pio.h
+target_include_directories(monitor_host PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/include
+    ${CMAKE_CURRENT_LIST_DIR}
+    ${CMAKE_SOURCE_DIR}
+)
+
+target_compile_definitions(monitor_host PRIVATE MONITOR_HOST=1 MONITOR_DISPLAY_MAX_FPS=${MONITOR_DISPLAY_MAX_FPS}
+                                                SENSOR_HISTORY_WINDOW=${MONITOR_HISTORY_WINDOW})
+target_compile_options(monitor_host PRIVATE -fno-pie -Wall -Wextra)
+target_link_options(monitor_host PRIVATE -no-pie)
+target_link_libraries(monitor_host PRIVATE m)
+
+if (MONITOR_BENCHMARK)
+    target_compile_definitions(monitor_host PRIVATE MONITOR_BENCHMARK=1)
+    target_sources(monitor_host PRIVATE bench.c)
+endif()
+
+if (MONITOR_PROFILE)
+    target_compile_definitions(monitor_host PRIVATE MONITOR_PROFILE=1)
+    target_sources(monitor_host PRIVATE profile.c)
+endif()
+
+if (MONITOR_TELEMETRY_BINARY)
+    target_compile_definitions(monitor_host PRIVATE MONITOR_TELEMETRY_BINARY=1)
+endif()
+
+if (MONITOR_IDLE_CLOCK_SCALING)
+    target_compile_definitions(monitor_host PRIVATE MONITOR_IDLE_CLOCK_SCALING=1)
+endif()
+
+if (MONITOR_I2C_FAST_PLUS)
+    target_compile_definitions(monitor_host PRIVATE MONITOR_I2C_FAST_PLUS=1)
+endif()
+
+# Testes de unidade dos módulos sem hardware (ctest)
+enable_testing()
+
+add_executable(test_history host/test_history.c history.c)
+target_include_directories(test_history PRIVATE ${CMAKE_SOURCE_DIR})
+target_compile_options(test_history PRIVATE -Wall -Wextra)
+add_test(NAME historico COMMAND test_history)
+
+add_executable(test_analog host/test_analog.c)
+target_include_directories(test_analog PRIVATE ${CMAKE_SOURCE_DIR})
+target_compile_options(test_analog PRIVATE -Wall -Wextra)
+target_link_libraries(test_analog PRIVATE m)
+add_test(NAME analog COMMAND test_analog)
@@ -0,0 +1,46 @@
+/**
+ * @file adc.h
+ * @brief ADC do host (host/hal_adc.c)
+ *
+ * As conversões são geradas no ritmo do divisor configurado, em rodízio,
+ * com ruído de ±2 LSB: joystick no centro (ou no valor do roteiro de
+ * entradas) e sensor de temperatura em 27 °C.
+ */
+#ifndef HOST_HARDWARE_ADC_H
+#define HOST_HARDWARE_ADC_H
+
+#include "pico.h"
+
+#define ADC_CS_EN_BITS 0x00000001u
+#define ADC_CS_TS_EN_BITS 0x00000002u
+#define ADC_CS_START_MANY_BITS 0x00000008u
+#define ADC_FCS_EN_BITS 0x00000001u
+#define ADC_FCS_DREQ_EN_BITS 0x00000008u
+#define ADC_FCS_LEVEL_LSB 16u
+#define ADC_FCS_LEVEL_BITS 0x000f0000u
+#define ADC_FCS_UNDER_BITS 0x00000400u
+#define ADC_FCS_OVER_BITS 0x00000800u
+
+typedef struct {
+    volatile uint32_t cs;
+    volatile uint32_t result;
+    volatile uint32_t fcs;
+    volatile uint32_t fifo;
+    volatile uint32_t div;
+} adc_hw_t;
+
+extern adc_hw_t *adc_hw;
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+uint adc_get_selected_input(void);
+void adc_set_round_robin(uint input_mask);
+void adc_set_temp_sensor_enabled(bool enable);
+uint16_t adc_read(void);
+void adc_run(bool run);
+void adc_set_clkdiv(float clkdiv);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_fifo_drain(void);
+
+#endif // HOST_HARDWARE_ADC_H
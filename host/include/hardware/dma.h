@@ -0,0 +1,130 @@
+/**
+ * @file dma.h
+ * @brief Controlador DMA do RP2040 emulado no host (host/hal_dma.c)
+ *
+ * Mesmos registradores, aliases e bits de CTRL do RP2040, inclusive os
+ * registradores de disparo e o disparo nulo, para que cadeias de blocos
+ * de controle funcionem sem alteração. Endereços são de 32 bits, como no
+ * barramento do RP2040: o executável do host é ligado sem PIE, e os
+ * buffers estáticos ficam abaixo de 4 GiB.
+ *
+ * Canais sem DREQ de periférico lento executam até o fim no disparo;
+ * canais ritmados pelo ADC avançam conforme o tempo decorrido.
+ */
+#ifndef HOST_HARDWARE_DMA_H
+#define HOST_HARDWARE_DMA_H
+
+#include "pico.h"
+
+#define NUM_DMA_CHANNELS 12
+
+/** @defgroup DmaCtrl Bits de CHx_CTRL (como no RP2040)
+ * @{
+ */
+#define DMA_CH0_CTRL_TRIG_EN_BITS 0x00000001u
+#define DMA_CH0_CTRL_TRIG_HIGH_PRIORITY_BITS 0x00000002u
+#define DMA_CH0_CTRL_TRIG_DATA_SIZE_LSB 2u
+#define DMA_CH0_CTRL_TRIG_DATA_SIZE_BITS 0x0000000cu
+#define DMA_CH0_CTRL_TRIG_INCR_READ_BITS 0x00000010u
+#define DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS 0x00000020u
+#define DMA_CH0_CTRL_TRIG_RING_SIZE_LSB 6u
+#define DMA_CH0_CTRL_TRIG_RING_SIZE_BITS 0x000003c0u
+#define DMA_CH0_CTRL_TRIG_RING_SEL_BITS 0x00000400u
+#define DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB 11u
+#define DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS 0x00007800u
+#define DMA_CH0_CTRL_TRIG_TREQ_SEL_LSB 15u
+#define DMA_CH0_CTRL_TRIG_TREQ_SEL_BITS 0x001f8000u
+#define DMA_CH0_CTRL_TRIG_IRQ_QUIET_BITS 0x00200000u
+#define DMA_CH0_CTRL_TRIG_BUSY_BITS 0x01000000u
+/** @} */
+
+/** @defgroup Dreq Sinais de DREQ usados pelo firmware
+ * @{
+ */
+#define DREQ_PIO0_TX0 0
+#define DREQ_PIO1_TX0 8
+#define DREQ_I2C0_TX 32
+#define DREQ_I2C1_TX 34
+#define DREQ_ADC 36
+#define DREQ_FORCE 0x3f
+/** @} */
+
+typedef struct {
+    volatile uint32_t read_addr;
+    volatile uint32_t write_addr;
+    volatile uint32_t transfer_count;
+    volatile uint32_t ctrl_trig;
+    volatile uint32_t al1_ctrl;
+    volatile uint32_t al1_read_addr;
+    volatile uint32_t al1_write_addr;
+    volatile uint32_t al1_transfer_count_trig;
+    volatile uint32_t al2_ctrl;
+    volatile uint32_t al2_transfer_count;
+    volatile uint32_t al2_read_addr;
+    volatile uint32_t al2_write_addr_trig;
+    volatile uint32_t al3_ctrl;
+    volatile uint32_t al3_write_addr;
+    volatile uint32_t al3_transfer_count;
+    volatile uint32_t al3_read_addr_trig;
+} dma_channel_hw_t;
+
+typedef struct {
+    dma_channel_hw_t ch[NUM_DMA_CHANNELS];
+} dma_hw_t;
+
+extern dma_hw_t *dma_hw;
+
+typedef struct {
+    uint32_t ctrl;
+} dma_channel_config;
+
+enum dma_channel_transfer_size {
+    DMA_SIZE_8 = 0,
+    DMA_SIZE_16 = 1,
+    DMA_SIZE_32 = 2
+};
+
+int dma_claim_unused_channel(bool required);
+void dma_channel_unclaim(uint channel);
+
+dma_channel_config dma_channel_get_default_config(uint channel);
+
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->ctrl = (c->ctrl & ~DMA_CH0_CTRL_TRIG_DATA_SIZE_BITS) | ((uint32_t)size << DMA_CH0_CTRL_TRIG_DATA_SIZE_LSB);
+}
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->ctrl = incr ? c->ctrl | DMA_CH0_CTRL_TRIG_INCR_READ_BITS : c->ctrl & ~DMA_CH0_CTRL_TRIG_INCR_READ_BITS;
+}
+static inline void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    c->ctrl = incr ? c->ctrl | DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS : c->ctrl & ~DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS;
+}
+static inline void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->ctrl = (c->ctrl & ~DMA_CH0_CTRL_TRIG_TREQ_SEL_BITS) | (dreq << DMA_CH0_CTRL_TRIG_TREQ_SEL_LSB);
+}
+static inline void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) {
+    c->ctrl = (c->ctrl & ~DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS) | (chain_to << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB);
+}
+static inline void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits) {
+    c->ctrl = (c->ctrl & ~(DMA_CH0_CTRL_TRIG_RING_SIZE_BITS | DMA_CH0_CTRL_TRIG_RING_SEL_BITS)) |
+              (size_bits << DMA_CH0_CTRL_TRIG_RING_SIZE_LSB) | (write ? DMA_CH0_CTRL_TRIG_RING_SEL_BITS : 0);
+}
+static inline void channel_config_set_irq_quiet(dma_channel_config *c, bool irq_quiet) {
+    c->ctrl = irq_quiet ? c->ctrl | DMA_CH0_CTRL_TRIG_IRQ_QUIET_BITS : c->ctrl & ~DMA_CH0_CTRL_TRIG_IRQ_QUIET_BITS;
+}
+static inline void channel_config_set_enable(dma_channel_config *c, bool enable) {
+    c->ctrl = enable ? c->ctrl | DMA_CH0_CTRL_TRIG_EN_BITS : c->ctrl & ~DMA_CH0_CTRL_TRIG_EN_BITS;
+}
+
+void dma_channel_set_config(uint channel, const dma_channel_config *config, bool trigger);
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger);
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger);
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger);
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count);
+void dma_channel_start(uint channel);
+void dma_channel_abort(uint channel);
+bool dma_channel_is_busy(uint channel);
+void dma_channel_wait_for_finish_blocking(uint channel);
+
+#endif // HOST_HARDWARE_DMA_H
@@ -0,0 +1,62 @@
+/**
+ * @file i2c.h
+ * @brief Controlador I2C do host (host/hal_i2c.c)
+ *
+ * Os bytes enviados são agrupados em transações (até o STOP) e entregues
+ * ao dispositivo do endereço: 0x3C é um SSD1306 simulado, cuja GDDRAM
+ * pode ser salva como PBM. A FIFO de TX nunca enche; o único aborto é o
+ * NACK de MONITOR_HOST_I2C_MAX_KHZ, que fica em raw_intr_stat até o
+ * próximo i2c_init().
+ */
+#ifndef HOST_HARDWARE_I2C_H
+#define HOST_HARDWARE_I2C_H
+
+#include "pico.h"
+
+#define I2C_IC_DATA_CMD_STOP_BITS 0x00000200u
+#define I2C_IC_DATA_CMD_RESTART_BITS 0x00000400u
+#define I2C_IC_STATUS_ACTIVITY_BITS 0x00000001u
+#define I2C_IC_STATUS_TFNF_BITS 0x00000002u
+#define I2C_IC_STATUS_TFE_BITS 0x00000004u
+#define I2C_IC_STATUS_MST_ACTIVITY_BITS 0x00000020u
+#define I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS 0x00000040u
+
+/** Subconjunto dos registradores do DW_apb_i2c usado pelo firmware */
+typedef struct {
+    volatile uint32_t enable;
+    volatile uint32_t tar;
+    volatile uint32_t data_cmd;
+    volatile uint32_t status;
+    volatile uint32_t txflr;
+    volatile uint32_t raw_intr_stat;
+    volatile uint32_t clr_tx_abrt;
+    volatile uint32_t tx_abrt_source;
+} i2c_hw_t;
+
+typedef struct i2c_inst {
+    i2c_hw_t *hw;
+    bool restart_on_next;
+} i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst;
+extern i2c_inst_t i2c1_inst;
+
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+void i2c_deinit(i2c_inst_t *i2c);
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+static inline i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c) {
+    return i2c->hw;
+}
+static inline uint i2c_get_index(i2c_inst_t *i2c) {
+    return i2c == i2c1 ? 1 : 0;
+}
+static inline uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx) {
+    return 32 + 2 * i2c_get_index(i2c) + (is_tx ? 0 : 1);
+}
+
+#endif // HOST_HARDWARE_I2C_H
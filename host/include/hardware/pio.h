@@ -0,0 +1,93 @@
+/**
+ * @file pio.h
+ * @brief PIO do host: programas não executam, as palavras da FIFO de TX
+ * são registradas (host/hal_pio.c)
+ */
+#ifndef HOST_HARDWARE_PIO_H
+#define HOST_HARDWARE_PIO_H
+
+#include "pico.h"
+
+#define NUM_PIO_STATE_MACHINES 4
+
+typedef struct {
+    volatile uint32_t ctrl;
+    volatile uint32_t fstat;
+    volatile uint32_t txf[NUM_PIO_STATE_MACHINES];
+    volatile uint32_t rxf[NUM_PIO_STATE_MACHINES];
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+extern pio_hw_t pio0_hw_inst;
+extern pio_hw_t pio1_hw_inst;
+
+#define pio0 (&pio0_hw_inst)
+#define pio1 (&pio1_hw_inst)
+
+typedef struct {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+
+typedef struct {
+    uint32_t clkdiv;
+    uint32_t execctrl;
+    uint32_t shiftctrl;
+    uint32_t pinctrl;
+} pio_sm_config;
+
+enum pio_fifo_join {
+    PIO_FIFO_JOIN_NONE = 0,
+    PIO_FIFO_JOIN_TX = 1,
+    PIO_FIFO_JOIN_RX = 2,
+};
+
+static inline uint pio_get_index(PIO pio) {
+    return pio == pio1 ? 1 : 0;
+}
+static inline uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+    return pio_get_index(pio) * 8 + sm + (is_tx ? 0 : 4);
+}
+
+static inline pio_sm_config pio_get_default_sm_config(void) {
+    pio_sm_config c = {0, 0, 0, 0};
+    return c;
+}
+static inline void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap) {
+    (void)c; (void)wrap_target; (void)wrap;
+}
+static inline void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs) {
+    (void)c; (void)bit_count; (void)optional; (void)pindirs;
+}
+static inline void sm_config_set_set_pins(pio_sm_config *c, uint set_base, uint set_count) {
+    (void)c; (void)set_base; (void)set_count;
+}
+static inline void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count) {
+    (void)c; (void)out_base; (void)out_count;
+}
+static inline void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base) {
+    (void)c; (void)sideset_base;
+}
+static inline void sm_config_set_clkdiv(pio_sm_config *c, float div) {
+    c->clkdiv = (uint32_t)(div * 256.0f);
+}
+static inline void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold) {
+    (void)c; (void)shift_right; (void)autopull; (void)pull_threshold;
+}
+static inline void sm_config_set_out_special(pio_sm_config *c, bool sticky, bool has_enable_pin, uint enable_pin_index) {
+    (void)c; (void)sticky; (void)has_enable_pin; (void)enable_pin_index;
+}
+static inline void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join) {
+    (void)c; (void)join;
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program);
+void pio_gpio_init(PIO pio, uint pin);
+int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out);
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+
+#endif // HOST_HARDWARE_PIO_H
@@ -0,0 +1,19 @@
+/**
+ * @file systick.h
+ * @brief Registradores do SysTick (host: sem contagem)
+ */
+#ifndef HOST_HARDWARE_STRUCTS_SYSTICK_H
+#define HOST_HARDWARE_STRUCTS_SYSTICK_H
+
+#include "pico.h"
+
+typedef struct {
+    volatile uint32_t csr;
+    volatile uint32_t rvr;
+    volatile uint32_t cvr;
+    volatile uint32_t calib;
+} systick_hw_t;
+
+extern systick_hw_t *systick_hw;
+
+#endif // HOST_HARDWARE_STRUCTS_SYSTICK_H
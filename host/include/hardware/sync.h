@@ -0,0 +1,13 @@
+/**
+ * @file sync.h
+ * @brief Máscara de interrupções do host: adia alarmes e DMA ritmada
+ */
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+
+#include "pico.h"
+
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+
+#endif // HOST_HARDWARE_SYNC_H
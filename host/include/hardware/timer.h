@@ -0,0 +1,21 @@
+/**
+ * @file timer.h
+ * @brief Contador de us e tipos de alarme do pico-sdk (host)
+ */
+#ifndef HOST_HARDWARE_TIMER_H
+#define HOST_HARDWARE_TIMER_H
+
+#include "pico.h"
+
+typedef int32_t alarm_id_t;
+
+/**
+ * @brief Callback de alarme
+ * @return >0 reagenda a partir do disparo previsto; <0 a partir de agora; 0 encerra
+ */
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+
+#endif // HOST_HARDWARE_TIMER_H
@@ -0,0 +1,28 @@
+/**
+ * @file uart.h
+ * @brief UART do stdio (host): a saída serial é o stdout do processo
+ */
+#ifndef HOST_HARDWARE_UART_H
+#define HOST_HARDWARE_UART_H
+
+#include "pico.h"
+
+typedef struct uart_inst uart_inst_t;
+
+#define uart0 ((uart_inst_t *)0)
+#define uart_default uart0
+
+#ifndef PICO_DEFAULT_UART_BAUD_RATE
+#define PICO_DEFAULT_UART_BAUD_RATE 115200
+#endif
+
+/**
+ * @brief Recalcula o divisor da UART (sem efeito no host)
+ * @return Taxa obtida
+ */
+static inline uint uart_set_baudrate(uart_inst_t *uart, uint baudrate) {
+    (void)uart;
+    return baudrate;
+}
+
+#endif // HOST_HARDWARE_UART_H
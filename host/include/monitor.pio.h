@@ -0,0 +1,54 @@
+/**
+ * @file monitor.pio.h
+ * @brief Equivalente do cabeçalho gerado de monitor.pio, para o host
+ *
+ * pioasm não faz parte da compilação no host; o programa e a função de
+ * inicialização são os de monitor.pio. O programa não é executado: a PIO
+ * do host apenas registra as palavras colocadas na FIFO de TX.
+ */
+#ifndef HOST_MONITOR_PIO_H
+#define HOST_MONITOR_PIO_H
+
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+
+#define monitor_wrap_target 0
+#define monitor_wrap 6
+
+static const uint16_t monitor_program_instructions[] = {
+    0x6021, //  0: out    x, 1
+    0x0023, //  1: jmp    !x, 3
+    0xe401, //  2: set    pins, 1 [4]
+    0x0005, //  3: jmp    5
+    0xe201, //  4: set    pins, 1 [2]
+    0xe200, //  5: set    pins, 0 [2]
+    0xe100, //  6: set    pins, 0 [1]
+};
+
+static const pio_program_t monitor_program = {
+    .instructions = monitor_program_instructions,
+    .length = 7,
+    .origin = -1,
+};
+
+static inline pio_sm_config monitor_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + monitor_wrap_target, offset + monitor_wrap);
+    return c;
+}
+
+static inline void monitor_program_init(PIO pio, uint sm, uint offset, uint pin) {
+    pio_sm_config c = monitor_program_get_default_config(offset);
+    sm_config_set_set_pins(&c, pin, 1);
+    pio_gpio_init(pio, pin);
+    pio_sm_set_consecutive_pindirs(pio, sm, pin, 1, true);
+    float div = clock_get_hz(clk_sys) / 8000000.0;
+    sm_config_set_clkdiv(&c, div);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+    sm_config_set_out_shift(&c, false, true, 24);
+    sm_config_set_out_special(&c, true, false, false);
+    pio_sm_init(pio, sm, offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+#endif // HOST_MONITOR_PIO_H
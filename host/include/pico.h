@@ -0,0 +1,42 @@
+/**
+ * @file pico.h
+ * @brief Tipos e macros básicos do pico-sdk para a compilação no host
+ *
+ * Apenas o subconjunto usado pelo firmware. As barreiras e o WFE são
+ * vazios: no host tudo executa em uma única thread. O WFI dorme até a
+ * próxima "interrupção" (alarme vencido ou borda de GPIO).
+ */
+#ifndef HOST_PICO_H
+#define HOST_PICO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+#define PICO_OK 0
+#define PICO_ERROR_NONE 0
+#define PICO_ERROR_TIMEOUT (-1)
+#define PICO_ERROR_GENERIC (-2)
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#define __not_in_flash_func(f) f
+#define __time_critical_func(f) f
+
+#define __dmb() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __sev() ((void)0)
+#define __wfe() ((void)0)
+#define __wfi() hal_wfi()
+
+/**
+ * @brief Espera ativa: no host, ponto em que alarmes e DMA avançam
+ */
+void tight_loop_contents(void);
+
+/**
+ * @brief WFI: dorme até haver interrupção pendente, mesmo mascarada
+ */
+void hal_wfi(void);
+
+#endif // HOST_PICO_H
@@ -0,0 +1,11 @@
+/**
+ * @file binary_info.h
+ * @brief Metadados do binário: sem efeito no host
+ */
+#ifndef HOST_PICO_BINARY_INFO_H
+#define HOST_PICO_BINARY_INFO_H
+
+#define bi_decl(...)
+#define bi_decl_if_func_used(...)
+
+#endif // HOST_PICO_BINARY_INFO_H
@@ -0,0 +1,25 @@
+/**
+ * @file critical_section.h
+ * @brief Seções críticas: no host, apenas adiam os alarmes
+ */
+#ifndef HOST_PICO_CRITICAL_SECTION_H
+#define HOST_PICO_CRITICAL_SECTION_H
+
+#include "pico.h"
+#include "hardware/sync.h"
+
+typedef struct {
+    uint32_t save;
+} critical_section_t;
+
+static inline void critical_section_init(critical_section_t *crit_sec) {
+    crit_sec->save = 0;
+}
+static inline void critical_section_enter_blocking(critical_section_t *crit_sec) {
+    crit_sec->save = save_and_disable_interrupts();
+}
+static inline void critical_section_exit(critical_section_t *crit_sec) {
+    restore_interrupts(crit_sec->save);
+}
+
+#endif // HOST_PICO_CRITICAL_SECTION_H
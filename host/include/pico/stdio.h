@@ -0,0 +1,26 @@
+/**
+ * @file stdio.h
+ * @brief E/S padrão do pico-sdk sobre stdin/stdout do processo
+ */
+#ifndef HOST_PICO_STDIO_H
+#define HOST_PICO_STDIO_H
+
+#include "pico.h"
+
+/**
+ * @brief Inicializa a simulação (entradas, limite de execução) e a saída
+ */
+bool stdio_init_all(void);
+
+/**
+ * @brief Lê um caractere de stdin sem bloquear além de timeout_us
+ * @return Caractere ou PICO_ERROR_TIMEOUT
+ */
+int getchar_timeout_us(uint32_t timeout_us);
+
+/**
+ * @brief Escreve len bytes em stdout, sem tradução
+ */
+int stdio_put_string(const char *s, int len, bool newline, bool cr_translation);
+
+#endif // HOST_PICO_STDIO_H
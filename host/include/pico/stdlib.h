@@ -0,0 +1,14 @@
+/**
+ * @file stdlib.h
+ * @brief pico/stdlib.h do host: tempo, GPIO e E/S padrão
+ */
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include "pico.h"
+#include "pico/types.h"
+#include "pico/time.h"
+#include "pico/stdio.h"
+#include "hardware/gpio.h"
+
+#endif // HOST_PICO_STDLIB_H
@@ -0,0 +1,13 @@
+/**
+ * @file types.h
+ * @brief Tipos de tempo do pico-sdk (host)
+ */
+#ifndef HOST_PICO_TYPES_H
+#define HOST_PICO_TYPES_H
+
+#include "pico.h"
+
+/** Instante absoluto em us desde o boot */
+typedef uint64_t absolute_time_t;
+
+#endif // HOST_PICO_TYPES_H
@@ -0,0 +1,124 @@
+/**
+ * @file test_analog.c
+ * @brief Teste das contas de aquisição do ADC (analog.h) no host
+ *
+ * Monta o buffer circular como o DMA o deixaria após `done` conversões do
+ * bloco atual (com o bloco anterior completo) e confere, para cada canal
+ * do rodízio, a janela escolhida por analog_window_first() e a média com
+ * bits extras de analog_decimate(). Confere também a escala da
+ * sobreamostragem e a conversão do sensor de temperatura interno.
+ *
+ * Executado pelo ctest na compilação do host (MONITOR_HOST=ON).
+ */
+#include "analog.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static int failures = 0;
+static uint16_t ring[ANALOG_RING_SAMPLES];
+
+static void check(const char *what, long arg, int64_t got, int64_t want) {
+    if (got == want) return;
+    if (failures++ < 10) {
+        printf("FALHA %s (%ld): %lld (esperado %lld)\n", what, arg, (long long)got, (long long)want);
+    }
+}
+/**
+ * @brief Conversão de 12 bits de um canal em uma rodada do rodízio
+ *
+ * Cada canal tem seu nível e uma variação que muda a cada rodada, para
+ * que uma janela deslocada de uma rodada dê outra média.
+ */
+static uint16_t conversion(uint32_t slot, uint32_t round) {
+    static const uint16_t level[ANALOG_NUM_CHANNELS] = {100, 2048, 3900};
+    return (uint16_t)(level[slot] + (round * 7 + slot) % 29);
+}
+/**
+ * @brief Deixa no buffer as últimas conversões, com o bit de erro do FIFO
+ * (bit 15) aceso nas rodadas ímpares
+ * @param global Conversões desde o início do bloco anterior
+ */
+static void fill_ring(uint32_t global) {
+    for (uint32_t g = global - ANALOG_RING_SAMPLES; g < global; g++) {
+        uint32_t round = g / ANALOG_NUM_CHANNELS;
+        uint16_t flag = (round & 1) ? 0x8000 : 0;
+        ring[g & (ANALOG_RING_SAMPLES - 1)] = conversion(g % ANALOG_NUM_CHANNELS, round) | flag;
+    }
+}
+/**
+ * @brief Janela e média de cada canal após `done` conversões do bloco
+ */
+static void check_window(uint32_t done) {
+    uint32_t global = ANALOG_BLOCK_SAMPLES + done;
+    fill_ring(global);
+
+    // Rodadas consideradas: as ANALOG_OVERSAMPLE anteriores à última completa
+    uint32_t current_round = global / ANALOG_NUM_CHANNELS;
+    for (uint32_t slot = 0; slot < ANALOG_NUM_CHANNELS; slot++) {
+        uint32_t sum = 0;
+        for (uint32_t r = current_round - 1 - ANALOG_OVERSAMPLE; r < current_round - 1; r++) {
+            sum += conversion(slot, r);
+        }
+        uint32_t first = analog_window_first(done, slot, ANALOG_NUM_CHANNELS, ANALOG_OVERSAMPLE,
+                                             ANALOG_BLOCK_SAMPLES);
+        check("inicio da janela", (long)done, first % ANALOG_NUM_CHANNELS, slot);
+        uint32_t got = analog_decimate(ring, ANALOG_RING_SAMPLES - 1, first, ANALOG_NUM_CHANNELS,
+                                       ANALOG_OVERSAMPLE, ANALOG_EXTRA_BITS);
+        // Soma de 4^n conversões: n bits a mais, os outros n descartados
+        check("media do canal", (long)done, got, sum >> ANALOG_EXTRA_BITS);
+    }
+}
+/**
+ * @brief Escala da sobreamostragem: 4^n conversões dão n bits a mais
+ */
+static void check_scaling(void) {
+    // Valor constante: a leitura é o valor de 12 bits deslocado dos bits extras
+    for (uint16_t v = 0; v <= 4095; v += 455) {
+        for (unsigned k = 0; k < ANALOG_RING_SAMPLES; k++) ring[k] = v;
+        check("constante", v, analog_decimate(ring, ANALOG_RING_SAMPLES - 1, 0, 1, ANALOG_OVERSAMPLE,
+                                              ANALOG_EXTRA_BITS), ANALOG_FROM_12BIT(v));
+    }
+
+    // Metade das conversões em 1000 e metade em 1001: o meio LSB aparece nos bits extras
+    for (unsigned k = 0; k < ANALOG_RING_SAMPLES; k++) ring[k] = (uint16_t)(1000 + (k & 1));
+    check("meio LSB, 2 bits", 2, analog_decimate(ring, ANALOG_RING_SAMPLES - 1, 0, 1, 16, 2), 4002);
+    check("meio LSB, 1 bit", 1, analog_decimate(ring, ANALOG_RING_SAMPLES - 1, 0, 1, 4, 1), 2001);
+    check("meio LSB, 0 bits", 0, analog_decimate(ring, ANALOG_RING_SAMPLES - 1, 0, 1, 4, 0), 1000);
+
+    // Janela que atravessa o fim do buffer
+    for (unsigned k = 0; k < ANALOG_RING_SAMPLES; k++) ring[k] = (uint16_t)k;
+    uint32_t sum = 0;
+    for (unsigned k = 0; k < 16; k++) sum += (ANALOG_RING_SAMPLES - 8 + k) & (ANALOG_RING_SAMPLES - 1);
+    check("volta do buffer", 0, analog_decimate(ring, ANALOG_RING_SAMPLES - 1, ANALOG_RING_SAMPLES - 8, 1,
+                                               16, ANALOG_EXTRA_BITS), sum >> ANALOG_EXTRA_BITS);
+}
+/**
+ * @brief Temperatura do canal 4 contra a fórmula do datasheet em double
+ */
+static void check_temperature(void) {
+    for (uint32_t raw = 2800; raw <= 4200; raw += 7) {
+        double volts = raw * 3.3 / (ANALOG_FULL_SCALE + 1);
+        double want = 27.0 - (volts - 0.706) / 0.001721;
+        fix_t got = analog_temperature(raw);
+        // Até 2 unidades Q (< 0,01 °C) de diferença pelos truncamentos inteiros
+        check("temperatura", (long)raw, llabs((long long)got - (long long)llround(want * FIX_ONE)) <= 2, 1);
+    }
+    // 0,706 V corresponde a 27 °C; cada 1,721 mV a menos, 1 °C a mais
+    uint32_t raw_27 = (uint32_t)lround(0.706 / 3.3 * (ANALOG_FULL_SCALE + 1));
+    check("27 graus", (long)raw_27, fix_to_scaled(analog_temperature(raw_27), 10), 270);
+    uint32_t raw_37 = (uint32_t)lround((0.706 - 10 * 0.001721) / 3.3 * (ANALOG_FULL_SCALE + 1));
+    check("37 graus", (long)raw_37, fix_to_scaled(analog_temperature(raw_37), 1), 37);
+}
+
+int main(void) {
+    // Início do bloco (janela ainda no bloco anterior), rodadas incompletas e fim do bloco
+    const uint32_t done[] = {0, 1, 2, 3, 4, 50, 51, 52, 53, 1000, ANALOG_BLOCK_SAMPLES - 1};
+    for (unsigned i = 0; i < sizeof(done) / sizeof(done[0]); i++) {
+        check_window(done[i]);
+    }
+    check_scaling();
+    check_temperature();
+    printf("analog: %s (%d falhas)\n", failures ? "FALHOU" : "ok", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file test_history.c
+ * @brief Teste do histórico (history.c) no host
+ *
+ * Compara média, mínimo, máximo e variância com o cálculo direto sobre a
+ * janela, para séries crescentes, decrescentes e alternadas, em janelas
+ * de 1 amostra até HISTORY_MAX_WINDOW. As séries monotônicas enchem as
+ * filas de mínimo e de máximo até o limite.
+ *
+ * Executado pelo ctest na compilação do host (MONITOR_HOST=ON).
+ */
+#include "history.h"
+#include <stdio.h>
+
+/** Mais que o dobro da maior janela: as filas enchem e dão a volta */
+#define SAMPLES (2 * HISTORY_MAX_WINDOW + 100)
+
+static int failures = 0;
+
+/**
+ * @brief Série de teste
+ */
+static fix_t series(int kind, int i) {
+    switch (kind) {
+        case 0: return FIX_FROM_INT(1000) + i * 64;              // crescente
+        case 1: return FIX_FROM_INT(1000) - i * 64;              // decrescente
+        default: return FIX_FROM_INT((i * 37) % 101 - 50) + i;   // alternada
+    }
+}
+static void check(const char *what, int kind, uint16_t window, int i, int64_t got, int64_t want) {
+    if (got == want) return;
+    if (failures++ < 10) {
+        printf("FALHA %s: serie %d, janela %u, amostra %d: %lld (esperado %lld)\n",
+               what, kind, window, i, (long long)got, (long long)want);
+    }
+}
+/**
+ * @brief Alimenta uma série e confere as estatísticas a cada amostra
+ */
+static void run(int kind, uint16_t window) {
+    static history_t h;
+    static uint32_t storage[HISTORY_WORDS(HISTORY_MAX_WINDOW) + 1];
+    static fix_t all[SAMPLES];
+    // Palavra de guarda logo após a memória da janela
+    storage[HISTORY_WORDS(window)] = 0xA5A5A5A5u;
+    history_init(&h, window, storage);
+
+    for (int i = 0; i < SAMPLES; i++) {
+        all[i] = series(kind, i);
+        history_push(&h, all[i]);
+
+        int first = (i + 1 > window) ? i + 1 - window : 0;
+        int64_t n = i + 1 - first, sum = 0, sum_sq = 0;
+        fix_t lo = all[first], hi = all[first];
+        for (int k = first; k <= i; k++) {
+            sum += all[k];
+            sum_sq += (int64_t)all[k] * all[k];
+            if (all[k] < lo) lo = all[k];
+            if (all[k] > hi) hi = all[k];
+        }
+        int64_t var = fix_div_round(n * sum_sq - sum * sum, n * n) >> FIX_FRAC_BITS;
+
+        check("minimo", kind, window, i, history_min(&h), lo);
+        check("maximo", kind, window, i, history_max(&h), hi);
+        check("media", kind, window, i, history_mean(&h), fix_div_round(sum, n));
+        check("variancia", kind, window, i, history_variance(&h), var);
+        check("fila de minimo", kind, window, i, h.min_q.size <= window, 1);
+        check("fila de maximo", kind, window, i, h.max_q.size <= window, 1);
+    }
+    check("guarda", kind, window, SAMPLES, storage[HISTORY_WORDS(window)], 0xA5A5A5A5u);
+}
+
+int main(void) {
+    const uint16_t windows[] = {1, 2, 10, HISTORY_MAX_WINDOW - 1, HISTORY_MAX_WINDOW};
+    for (unsigned w = 0; w < sizeof(windows) / sizeof(windows[0]); w++) {
+        for (int kind = 0; kind < 3; kind++) {
+            run(kind, windows[w]);
+        }
+    }
+    printf("historico: %s (%d falhas)\n", failures ? "FALHOU" : "ok", failures);
+    return failures ? 1 : 0;
+}
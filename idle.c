@@ -0,0 +1,112 @@
+/**
+ * @file idle.c
+ * @brief Espera ociosa sem tique: o núcleo dorme em WFI até o próximo evento
+ *
+ * A condição de saída é testada com as interrupções mascaradas e o WFI
+ * executado ainda mascarado: uma interrupção que chegue entre o teste e
+ * o WFI fica pendente e acorda o núcleo imediatamente, e só é atendida
+ * ao desmascarar. Assim o despertar nunca se perde.
+ */
+#include "idle.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#if MONITOR_IDLE_CLOCK_SCALING
+#include "hardware/clocks.h"
+#include "hardware/uart.h"
+#endif
+
+static volatile bool wake_pending = false;
+static volatile bool alarm_fired = false;
+static bool (*quiet_check)(void) = NULL;
+
+static idle_stats_t window;
+static uint64_t window_start_us = 0;
+
+#if MONITOR_IDLE_CLOCK_SCALING
+static uint32_t full_sys_hz = 0;
+
+/**
+ * @brief Reconfigura o clk_sys a partir do PLL do sistema
+ */
+static void set_sys_clock_div(uint32_t div) {
+    clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                    CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS, full_sys_hz, full_sys_hz / div);
+}
+#endif
+
+void idle_init(void) {
+#if MONITOR_IDLE_CLOCK_SCALING
+    full_sys_hz = clock_get_hz(clk_sys);
+    // UART independente do clk_sys: clk_peri a partir do PLL USB (48 MHz)
+    clock_configure(clk_peri, 0, CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB, 48 * MHZ, 48 * MHZ);
+#if defined(uart_default) && defined(PICO_DEFAULT_UART_BAUD_RATE)
+    uart_set_baudrate(uart_default, PICO_DEFAULT_UART_BAUD_RATE);
+#endif
+#endif
+}
+/**
+ * @brief Alarme de despertar da espera atual
+ */
+static int64_t idle_alarm_callback(alarm_id_t id, void *user_data) {
+    (void)id;
+    (void)user_data;
+    alarm_fired = true;
+    return 0;
+}
+void idle_wait_until(uint64_t target_us) {
+    uint64_t start = time_us_64();
+    if (window_start_us == 0) window_start_us = start;  // Primeira janela: início do escalonador
+    window.waits++;
+    if (wake_pending || target_us <= start) {
+        wake_pending = false;
+        return;
+    }
+
+    alarm_fired = false;
+    alarm_id_t alarm = add_alarm_in_us(target_us - start, idle_alarm_callback, NULL, true);
+    if (alarm < 0) {
+        // Sem alarme livre: espera do SDK, sem WFI
+        sleep_until(from_us_since_boot(target_us));
+        return;
+    }
+
+#if MONITOR_IDLE_CLOCK_SCALING
+    bool slow = target_us - start >= IDLE_SLOW_CLOCK_MIN_US && quiet_check != NULL && quiet_check();
+    if (slow) set_sys_clock_div(IDLE_SLOW_CLOCK_DIV);
+#endif
+
+    uint32_t status = save_and_disable_interrupts();
+    while (!alarm_fired && !wake_pending) {
+        __wfi();
+        window.wakeups++;
+        restore_interrupts(status);
+        status = save_and_disable_interrupts();
+    }
+    restore_interrupts(status);
+
+#if MONITOR_IDLE_CLOCK_SCALING
+    if (slow) set_sys_clock_div(1);
+#endif
+    if (!alarm_fired && alarm > 0) cancel_alarm(alarm);
+    wake_pending = false;
+
+    uint64_t slept = time_us_64() - start;
+    window.idle_us += slept;
+#if MONITOR_IDLE_CLOCK_SCALING
+    if (slow) window.slow_us += slept;
+#endif
+}
+void idle_wake(void) {
+    wake_pending = true;
+}
+void idle_set_quiet_check(bool (*quiet)(void)) {
+    quiet_check = quiet;
+}
+void idle_take_stats(idle_stats_t *stats) {
+    uint64_t now = time_us_64();
+    if (window_start_us == 0) window_start_us = now;
+    *stats = window;
+    stats->elapsed_us = now - window_start_us;
+    window = (idle_stats_t){0};
+    window_start_us = now;
+}
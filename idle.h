@@ -0,0 +1,72 @@
+/**
+ * @file idle.h
+ * @brief Espera ociosa sem tique: o núcleo dorme em WFI até o próximo evento
+ *
+ * O escalonador calcula a próxima liberação (amostragem, quadro da
+ * animação, borda do SOS, relatório serial) e chama idle_wait_until():
+ * um alarme de hardware é armado para esse instante e o núcleo executa
+ * WFI até ele disparar ou até uma interrupção pedir atenção com
+ * idle_wake() (ex.: botão). Outras interrupções (USB, DMA do ADC) são
+ * atendidas e o núcleo volta a dormir.
+ *
+ * Com MONITOR_IDLE_CLOCK_SCALING, esperas longas sem periféricos ativos
+ * dividem o clk_sys por IDLE_SLOW_CLOCK_DIV; clk_peri passa a vir do
+ * PLL USB para que a UART não dependa do clk_sys.
+ */
+#ifndef IDLE_H
+#define IDLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef MONITOR_IDLE_CLOCK_SCALING
+#define MONITOR_IDLE_CLOCK_SCALING 0  ///< 1 = reduz o clk_sys em esperas longas
+#endif
+
+#define IDLE_SLOW_CLOCK_DIV 8          ///< Divisor do clk_sys em espera longa
+#define IDLE_SLOW_CLOCK_MIN_US 20000   ///< Espera mínima para reduzir o clock
+
+/**
+ * @brief Estatísticas de ocupação de uma janela de tempo
+ */
+typedef struct {
+    uint64_t elapsed_us;   ///< Duração da janela
+    uint64_t idle_us;      ///< Tempo dormindo em idle_wait_until()
+    uint64_t slow_us;      ///< Parte do ocioso com o clock reduzido
+    uint32_t waits;        ///< Chamadas de espera
+    uint32_t wakeups;      ///< Interrupções que acordaram o núcleo
+} idle_stats_t;
+
+/**
+ * @brief Prepara a espera ociosa (e os relógios, com MONITOR_IDLE_CLOCK_SCALING)
+ */
+void idle_init(void);
+
+/**
+ * @brief Dorme até target_us, um idle_wake() ou o fim imediato se já passou
+ * @param target_us Instante de despertar (us desde o boot)
+ */
+void idle_wait_until(uint64_t target_us);
+
+/**
+ * @brief Encerra a espera atual (ou a próxima); seguro em interrupções
+ */
+void idle_wake(void);
+
+/**
+ * @brief Define quando o clock pode ser reduzido
+ *
+ * Sem efeito sem MONITOR_IDLE_CLOCK_SCALING. PWM, PIO e I2C usam o
+ * clk_sys: a função deve retornar false enquanto houver tom, quadro da
+ * matriz ou envio ao display em andamento.
+ * @param quiet Retorna true se nenhum periférico depende do clk_sys agora
+ */
+void idle_set_quiet_check(bool (*quiet)(void));
+
+/**
+ * @brief Retorna as estatísticas desde a chamada anterior e abre nova janela
+ * @param stats Estatísticas da janela encerrada
+ */
+void idle_take_stats(idle_stats_t *stats);
+
+#endif // IDLE_H
@@ -0,0 +1,103 @@
+/**
+ * @file logview.c
+ * @brief Tela de histórico de alertas com rolagem pela linha inicial do SSD1306
+ *
+ * Cada página guarda o número da entrada que está desenhada nela; a
+ * página é redesenhada só quando a entrada que deveria estar ali muda
+ * (rolagem ou entrada nova) ou quando deixa de ser uma linha vazia.
+ */
+#include "logview.h"
+#include "ssd1306.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LOGVIEW_ROWS SSD1306_PAGES   ///< Uma entrada por página
+
+static char entries[LOGVIEW_ENTRIES][LOGVIEW_TEXT_LEN];
+static uint32_t total = 0;            ///< Entradas desde a inicialização
+static uint32_t top = 0;              ///< Número da entrada na primeira linha
+static bool follow = true;            ///< Acompanha as entradas novas
+static bool open = false;
+static int32_t page_seq[LOGVIEW_ROWS];  ///< Entrada desenhada em cada página (-1: desconhecido)
+static bool page_filled[LOGVIEW_ROWS];  ///< false: linha vazia (entrada ainda não existia)
+static uint8_t shown_line = 0;          ///< Linha inicial agendada
+static ui_text_fn_t draw_text = NULL;
+
+void logview_init(ui_text_fn_t text_fn) {
+    draw_text = text_fn;
+}
+/**
+ * @brief Entrada mais antiga ainda guardada
+ */
+static uint32_t oldest(void) {
+    return total > LOGVIEW_ENTRIES ? total - LOGVIEW_ENTRIES : 0;
+}
+/**
+ * @brief Topo do fim do histórico (últimas LOGVIEW_ROWS entradas)
+ */
+static uint32_t tail_top(void) {
+    return total > LOGVIEW_ROWS ? total - LOGVIEW_ROWS : 0;
+}
+void logview_add(uint32_t now_ms, const char *text) {
+    uint32_t seconds = now_ms / 1000;
+    snprintf(entries[total % LOGVIEW_ENTRIES], LOGVIEW_TEXT_LEN, "%02lu:%02lu %s",
+             (unsigned long)(seconds / 60 % 100), (unsigned long)(seconds % 60), text);
+    total++;
+}
+void logview_open() {
+    open = true;
+    follow = true;
+    for (int page = 0; page < LOGVIEW_ROWS; page++) {
+        page_seq[page] = -1;
+    }
+}
+void logview_close() {
+    if (!open) return;
+    open = false;
+    shown_line = 0;
+    ssd1306_set_start_line(0);
+    ui_invalidate();
+}
+bool logview_is_open() {
+    return open;
+}
+bool logview_scroll(int lines) {
+    int64_t target = (int64_t)top + lines;
+    if (target > (int64_t)tail_top()) target = tail_top();
+    if (target < (int64_t)oldest()) target = oldest();
+    follow = (uint32_t)target == tail_top();
+    if ((uint32_t)target == top) return false;
+    top = (uint32_t)target;
+    return true;
+}
+int logview_render() {
+    if (!open) return 0;
+    if (follow) top = tail_top();
+    if (top < oldest()) top = oldest();
+
+    int changes = 0;
+    for (uint32_t seq = top; seq < top + LOGVIEW_ROWS; seq++) {
+        int page = (int)(seq % LOGVIEW_ROWS);
+        bool filled = seq < total;
+        if (page_seq[page] == (int32_t)seq && page_filled[page] == filled) continue;
+
+        memset(buffer[page], 0, sizeof(buffer[page]));
+        ssd1306_mark_dirty((uint8_t)page, 0, DISPLAY_WIDTH - 1);
+        if (filled && draw_text) draw_text(0, page * 8, entries[seq % LOGVIEW_ENTRIES], false);
+        page_seq[page] = (int32_t)seq;
+        page_filled[page] = filled;
+        changes++;
+    }
+
+    // A página da entrada do topo vai para a primeira linha da tela
+    uint8_t line = (uint8_t)((top % LOGVIEW_ROWS) * 8);
+    if (line != shown_line) {
+        shown_line = line;
+        ssd1306_set_start_line(line);
+        changes++;
+    }
+    return changes;
+}
+uint32_t logview_count() {
+    return total;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file logview.h
+ * @brief Tela de histórico de alertas com rolagem pela linha inicial do SSD1306
+ *
+ * As 8 páginas da GDDRAM formam um anel: a entrada de número n fica na
+ * página n % 8, e a linha inicial do display (comando 0x40-0x7F) aponta
+ * para a página da entrada do topo. Rolar uma linha, ou receber uma
+ * entrada nova com a tela no fim do histórico, reescreve só a página que
+ * entra em vista e troca a linha inicial, em vez de reenviar o quadro.
+ *
+ * A memória guarda as últimas LOGVIEW_ENTRIES entradas; o joystick rola
+ * por elas. Enquanto a tela estiver aberta as outras telas não desenham;
+ * ao fechar, a linha inicial volta a 0 e a interface é invalidada.
+ */
+#ifndef LOGVIEW_H
+#define LOGVIEW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ui.h"
+
+#define LOGVIEW_ENTRIES 32    ///< Entradas guardadas para rolagem
+#define LOGVIEW_TEXT_LEN 16   ///< Texto da entrada com terminador (15 colunas de 8 px)
+
+/**
+ * @brief Define a função que desenha texto
+ */
+void logview_init(ui_text_fn_t draw_text);
+
+/**
+ * @brief Acrescenta uma entrada com o instante "MM:SS" na frente
+ * @param now_ms Instante do evento (ms desde o boot)
+ * @param text Descrição (cortada no que couber na linha)
+ */
+void logview_add(uint32_t now_ms, const char *text);
+
+/**
+ * @brief Abre a tela no fim do histórico
+ *
+ * O primeiro logview_render() redesenha as 8 páginas.
+ */
+void logview_open(void);
+
+/**
+ * @brief Fecha a tela e volta a linha inicial para 0
+ */
+void logview_close(void);
+
+/**
+ * @brief Indica se a tela está aberta
+ */
+bool logview_is_open(void);
+
+/**
+ * @brief Rola o histórico
+ * @param lines Linhas (negativo: entradas mais antigas)
+ * @return true se a posição mudou
+ */
+bool logview_scroll(int lines);
+
+/**
+ * @brief Desenha no buffer as páginas que entraram em vista e agenda a
+ * nova linha inicial para o próximo envio
+ * @return Alterações (páginas redesenhadas mais a troca da linha inicial)
+ */
+int logview_render(void);
+
+/**
+ * @brief Total de entradas desde a inicialização
+ */
+uint32_t logview_count(void);
+
+#endif // LOGVIEW_H
@@ -17,55 +17,87 @@
 #include <math.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
-#include "hardware/adc.h"
 #include "pico/binary_info.h"
 #include "hardware/gpio.h"
-#include "hardware/pwm.h"
-#include "hardware/clocks.h"
-#include "hardware/pio.h"
-#include "monitor.pio.h"
 #include "font.h"
 #include "ssd1306.h"
-#include "hardware/sync.h"
+#include "scheduler.h"
+#include "outputs.h"
+#include "audio.h"
+#include "fixed.h"
+#include "history.h"
+#include "telemetry.h"
+#include "sensor.h"
+#include "sensor_sim.h"
+#include "flashlog.h"
+#include "analog.h"
+#include "sensor_adc.h"
+#include "profile.h"
+#include "buttons.h"
+#include "idle.h"
+#include "rules.h"
+#include "ui.h"
+#include "logview.h"
+#ifdef MONITOR_BENCHMARK
+#include "bench.h"
+#endif
 
 // Definições de pinos
 /**
  * @brief Definições de pinos para conexões de hardware
  */
-#define DISPLAY_SDA_PIN 14    ///< Pino SDA para display OLED
-#define DISPLAY_SCL_PIN 15    ///< Pino SCL para display OLED
-#define I2C_PORT i2c1         ///< Porta I2C utilizada
-#define LED_R_PIN 13          ///< Pino do LED vermelho
-#define LED_G_PIN 11          ///< Pino do LED verde
-#define LED_B_PIN 12          ///< Pino do LED azul
 #define BUTTON_A_PIN 5        ///< Pino do botão A
 #define BUTTON_B_PIN 6        ///< Pino do botão B
 #define JOY_BUTTON_PIN 22     ///< Pino do botão do joystick
-#define JOY_X_PIN 27          ///< Pino X do joystick (ADC)
-#define JOY_Y_PIN 26          ///< Pino Y do joystick (ADC)
-#define BUZZER_PIN 10         ///< Pino do buzzer
-#define NUM_PIXELS 25         ///< Número total de NeoPixels
-#define OUT_PIN 7             ///< Pino de dados dos NeoPixels
+
+// Períodos e prazos das tarefas do escalonador (ms)
+/**
+ * @brief Temporização das tarefas do laço principal
+ */
+#define TASK_SENSORS_PERIOD_MS 1000   ///< Amostragem dos sensores e detecções
+#define TASK_DISPLAY_PERIOD_MS 100    ///< Atualização do display
+#define TASK_DISPLAY_DEADLINE_MS 50
+#define TASK_SERIAL_PERIOD_MS 2000    ///< Relatório serial
+#define TASK_OUTPUTS_PERIOD_MS 50     ///< Animação e padrão SOS (núcleo único)
+#define TASK_OUTPUTS_DEADLINE_MS 10
+#define TASK_INPUT_PERIOD_MS 50       ///< Joystick e serial; botões acordam a tarefa
+#define TASK_INPUT_DEADLINE_MS 10
+#define TASK_LOGDUMP_PERIOD_MS 20     ///< Envio do log da flash, em lotes
+#define FLASHLOG_DUMP_BATCH 32        ///< Registros por execução do dump
+#define TASK_PROFILE_PERIOD_MS 5000   ///< Relatório dos histogramas de tempo (MONITOR_PROFILE)
+
+/**
+ * @brief Taxa máxima de quadros do display
+ *
+ * Pedidos de redesenho mais próximos que 1000/MONITOR_DISPLAY_MAX_FPS ms
+ * do quadro anterior são adiados e agrupados no próximo.
+ */
+#ifndef MONITOR_DISPLAY_MAX_FPS
+#define MONITOR_DISPLAY_MAX_FPS 20
+#endif
 
 // Protótipos de funções
 void display_sensor_data(void);
+void draw_string(int x, int y, const char *str, bool inverted);
 void detect_fire(void);
 void update_fire_alarm(void);
 void play_wildlife_alert(void);
 void check_buttons(void);
-void debounce_buttons(void);
-void play_tone(uint frequency, uint duration);
 void init_menu(void);
 void play_startup_music(void);
-void init_neopixels(void);
-void update_neopixel_bars(void);
-void display_sos_neopixel(void);
-static inline uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b); // Declaração movida para cá
+void request_display_refresh(void);
+void set_output_pattern(output_pattern_t pattern);
+void print_task_stats(void);
+void print_idle_stats(void);
+void print_display_stats(void);
+void send_serial_binary(void);
+void check_serial_commands(void);
+void log_event(uint32_t now_ms, uint16_t flags, int32_t value);
+void raise_fire_alert(uint32_t now_ms, const char *reason);
+void handle_rule(const rule_t *rule, uint32_t now_ms);
+void note_event(uint32_t now_ms, const char *text);
 
 // Variáveis de controle de recursos
-bool temp_enabled = false;
-bool flow_enabled = false;
-bool rain_enabled = false;
 bool fire_enabled = false;
 bool wildlife_enabled = false;
 
@@ -73,15 +105,6 @@ bool wildlife_enabled = false;
 bool fire_alert_active = false;
 uint32_t fire_alert_start = 0;
 
-// Variáveis para debounce
-bool button_a_last_state = true;
-bool button_b_last_state = true;
-bool joy_button_last_state = true;
-uint32_t last_debounce_time_a = 0;
-uint32_t last_debounce_time_b = 0;
-uint32_t last_debounce_time_joy = 0;
-const uint32_t debounce_delay = 50;
-
 // Estrutura para animais silvestres
 /**
  * @brief Estrutura para informações de vida silvestre
@@ -107,175 +130,165 @@ int last_detected_wildlife = -1;
 bool wildlife_alert_active = false;
 #define WILDLIFE_ALERT_DURATION_MS 10000
 
-// Estrutura para sensores
-/**
- * @brief Estrutura para configuração dos sensores
- */
-typedef struct {
-    char name[15];      ///< Nome do sensor
-    char unit[5];       ///< Unidade de medida
-    float min_val;      ///< Valor mínimo válido
-    float max_val;      ///< Valor máximo válido
-    float anomaly_min;  ///< Limite mínimo para detecção de anomalia
-    float anomaly_max;  ///< Limite máximo para detecção de anomalia
-    float variation;    ///< Variação permitida entre leituras
-    float value;        ///< Valor atual do sensor
-    float history[10];  ///< Histórico de valores para média móvel
-} SensorConfig;
-
-
-SensorConfig sensors[3];
 int current_sensor_index = 0;
 bool display_initialized = false;
+int display_task_id = -1;  ///< Tarefa de display, para redesenho imediato
+int input_task_id = -1;    ///< Tarefa de entrada, acordada pelos botões
+int outputs_task_id = -1;  ///< Tarefa de saídas, reagendada pelo próprio padrão
+int logdump_task_id = -1;  ///< Tarefa de dump do log, ativada pelo comando 'd'
+int profile_task_id = -1;  ///< Relatório periódico de tempos, ativado pelo comando 'p'
 
-// PIO para NeoPixels
-PIO pio = pio0;
-uint sm = 0;
+// Agrupamento de quadros do display
+bool display_stale = true;             ///< Conteúdo mudou desde o último quadro
+uint32_t display_last_frame_ms = 0;
+uint32_t display_requests = 0;         ///< Pedidos de redesenho
+uint32_t display_coalesced = 0;        ///< Pedidos absorvidos por um quadro já pendente
+uint32_t display_deferred = 0;         ///< Execuções adiadas pela taxa máxima
+uint32_t display_idle_ticks = 0;       ///< Ticks sem nada a redesenhar
+flashlog_cursor_t logdump_cursor;
 
-// Declaração da função put_pixel
-static inline void put_pixel(uint32_t pixel_grb) {
-    pio_sm_put_blocking(pio, sm, pixel_grb << 8u);
-}
-
-// Declaração do spin lock global
-static spin_lock_t *pixel_lock;
-static int pixel_lock_num;
-
-// Constantes para animação do gráfico
-const uint8_t graphic_frames[4][5][5] = {
-    {
-        {1, 2, 3, 2, 1}, 
-        {0, 1, 2, 1, 0},
-        {0, 0, 1, 0, 0},
-        {0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0}   
-    },
-    {
-        {1, 2, 3, 2, 1},
-        {1, 2, 3, 2, 1},
-        {0, 1, 2, 1, 0},
-        {0, 0, 1, 0, 0},
-        {0, 0, 0, 0, 0}
-    },
-    {
-        {1, 2, 3, 2, 1},
-        {1, 2, 3, 2, 1},
-        {1, 2, 3, 2, 1},
-        {0, 1, 2, 1, 0},
-        {0, 0, 1, 0, 0}
-    },
-    {
-        {1, 2, 3, 2, 1},
-        {1, 2, 3, 2, 1},
-        {1, 2, 3, 2, 1},
-        {1, 2, 3, 2, 0},
-        {0, 1, 0, 1, 0}
-    }
-};
 /**
- * @brief Inicializa os sensores do sistema
+ * @brief Registra os drivers dos sensores
  * 
- * Configura os parâmetros iniciais para:
+ * A ordem de registro define a ordem no menu, no display e na serial:
  * - Sensor de temperatura (15-35°C)
  * - Sensor de fluxo de água (0-30 L/min)
  * - Sensor de chuva (0-100 mm/h)
+ * - Temperatura interna do RP2040 (ADC, canal 4)
  */
 void init_sensors() {
-    strcpy(sensors[0].name, "Temperatura");
-    strcpy(sensors[0].unit, "C");
-    sensors[0].min_val = 15.0f;
-    sensors[0].max_val = 35.0f;
-    sensors[0].anomaly_min = 10.0f;
-    sensors[0].anomaly_max = 40.0f;
-    sensors[0].variation = 0.5f;
-    sensors[0].value = (sensors[0].min_val + sensors[0].max_val) / 2;
-
-    strcpy(sensors[1].name, "Fluxo Agua");
-    strcpy(sensors[1].unit, "L/min");
-    sensors[1].min_val = 0.0f;
-    sensors[1].max_val = 30.0f;
-    sensors[1].anomaly_min = 0.0f;
-    sensors[1].anomaly_max = 25.0f;
-    sensors[1].variation = 1.0f;
-    sensors[1].value = 0.0f;
-
-    strcpy(sensors[2].name, "Chuva");
-    strcpy(sensors[2].unit, "mm/h");
-    sensors[2].min_val = 0.0f;
-    sensors[2].max_val = 100.0f;
-    sensors[2].anomaly_min = 0.0f;
-    sensors[2].anomaly_max = 80.0f;
-    sensors[2].variation = 5.0f;
-    sensors[2].value = 0.0f;
-
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 10; j++) {
-            sensors[i].history[j] = sensors[i].value;
-        }
+    sensor_register(&sensor_sim_temperature);
+    sensor_register(&sensor_sim_flow);
+    sensor_register(&sensor_sim_rain);
+    sensor_register(&sensor_adc_chip_temperature);
+}
+/**
+ * @brief Regras de alerta do local, compiladas na inicialização (sintaxe em rules.h)
+ */
+static const char *const site_rules[] = {
+    "risco_fogo: [Temperatura].taxa > 0.3 e [Temperatura].media > 30 e [Chuva] == 0 por 3 -> incendio sev 3 espera 600",
+    "cheia: [Fluxo Agua].media > 12 e [Chuva].media > 30 por 3 -> alerta sev 2 espera 120",
+    "deriva_temp: [Temperatura].anomalia == 1 -> log sev 1 espera 30",
+    "chuva_forte: [Chuva] > 80 -> log sev 1 espera 30",
+    "chip_quente: [Temp. Interna] > 60 por 5 -> alerta sev 2 espera 300",
+};
+/**
+ * @brief Nova leitura: marca as regras que dependem do sensor
+ */
+static void on_sensor_sample(sensor_t *sensor, uint32_t now_ms) {
+    (void)now_ms;
+    rules_sensor_updated(sensor->id);
+}
+/**
+ * @brief Compila as regras do local e liga a avaliação às leituras
+ */
+void init_rules() {
+    int loaded = 0;
+    for (unsigned i = 0; i < sizeof(site_rules) / sizeof(site_rules[0]); i++) {
+        if (rules_add(site_rules[i]) >= 0) loaded++;
     }
+    rules_finalize(handle_rule);
+    sensor_set_listener(on_sensor_sample);
+    printf("Regras de alerta: %d carregadas\n", loaded);
+}
+/**
+ * @brief Nenhum periférico dependente do clk_sys em uso (tom, matriz, display)
+ */
+static bool outputs_quiet(void) {
+    return !audio_busy() && !neopixel_busy() && !ssd1306_flush_busy();
+}
+/**
+ * @brief Botão publicado: acorda a tarefa de entrada (contexto do alarme)
+ */
+static void buttons_notify(void) {
+    scheduler_trigger_from_isr(input_task_id);
 }
 /**
  * @brief Inicializa o hardware do sistema
  * 
  * Configura todos os componentes físicos:
- * - Display OLED via I2C
- * - Interface I2C
+ * - Display OLED via I2C (o driver configura o barramento)
  * - GPIOs para LEDs e botões
- * - ADC para joystick
+ * - ADC em aquisição contínua por DMA (joystick e temperatura interna)
  * - PWM para buzzer
  * - Matriz de NeoPixels
  */
 void init_hardware() {
     stdio_init_all();
     ssd1306_init();
-    ssd1306_clear();
-    ssd1306_update();
     display_initialized = true;
-    i2c_init(I2C_PORT, 400 * 1000);
-    gpio_set_function(DISPLAY_SDA_PIN, GPIO_FUNC_I2C);
-    gpio_set_function(DISPLAY_SCL_PIN, GPIO_FUNC_I2C);
-    gpio_pull_up(DISPLAY_SDA_PIN);
-    gpio_pull_up(DISPLAY_SCL_PIN);
-    gpio_init(LED_R_PIN);
-    gpio_init(LED_G_PIN);
-    gpio_init(LED_B_PIN);
-    gpio_set_dir(LED_R_PIN, GPIO_OUT);
-    gpio_set_dir(LED_G_PIN, GPIO_OUT);
-    gpio_set_dir(LED_B_PIN, GPIO_OUT);
-    gpio_init(BUTTON_A_PIN);
-    gpio_init(BUTTON_B_PIN);
-    gpio_init(JOY_BUTTON_PIN);
-    gpio_set_dir(BUTTON_A_PIN, GPIO_IN);
-    gpio_set_dir(BUTTON_B_PIN, GPIO_IN);
-    gpio_set_dir(JOY_BUTTON_PIN, GPIO_IN);
-    gpio_pull_up(BUTTON_A_PIN);
-    gpio_pull_up(BUTTON_B_PIN);
-    gpio_pull_up(JOY_BUTTON_PIN);
-    adc_init();
-    adc_gpio_init(JOY_X_PIN);
-    adc_gpio_init(JOY_Y_PIN);
-    gpio_set_function(BUZZER_PIN, GPIO_FUNC_PWM);
-    uint slice_num = pwm_gpio_to_slice_num(BUZZER_PIN);
-    pwm_set_wrap(slice_num, 255);
-    pwm_set_clkdiv(slice_num, 1.0f);
-    pwm_set_enabled(slice_num, true);
-    gpio_put(LED_R_PIN, 0);
-    gpio_put(LED_G_PIN, 0);
-    gpio_put(LED_B_PIN, 1);
-    init_neopixels();
+    ui_init(draw_string);
+    logview_init(draw_string);
+    static const uint button_pins[BUTTON_COUNT] = {BUTTON_A_PIN, BUTTON_B_PIN, JOY_BUTTON_PIN};
+    buttons_init(button_pins);
+    analog_init();
+    outputs_init();
+    idle_init();
+    idle_set_quiet_check(outputs_quiet);
 }
 
-// Definição de urgb_u32 movida para antes do primeiro uso
 /**
- * @brief Converte valores RGB para formato GRB dos NeoPixels
- * 
- * @param r Valor do componente vermelho (0-255)
- * @param g Valor do componente verde (0-255)
- * @param b Valor do componente azul (0-255)
- * @return uint32_t Valor formatado para NeoPixel (GRB)
+ * @brief Obtém as colunas de um glifo no formato de página
+ *
+ * A fonte já é transposta em tempo de compilação (font_columns); o glifo
+ * normal é usado direto da flash e o invertido é copiado com inversão.
+ *
+ * @param c Caractere
+ * @param inverted Se verdadeiro, inverte as cores do caractere
+ * @param scratch Área para as colunas invertidas
+ * @return Ponteiro para as 8 colunas do glifo
  */
-static inline uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b) {
-    return ((uint32_t)(r) << 16) | ((uint32_t)(g) << 8) | (uint32_t)(b); // GRB
+static inline const uint8_t *glyph_columns(char c, bool inverted, uint8_t scratch[8]) {
+    const uint8_t *columns = &font_columns[((unsigned char)c & 0x7F) * 8];
+    if (!inverted) return columns;
+    for (int j = 0; j < 8; j++) {
+        scratch[j] = (uint8_t)~columns[j];
+    }
+    return scratch;
+}
+/**
+ * @brief Copia colunas de um glifo para o buffer do display
+ *
+ * Com y múltiplo de 8 cada coluna é um byte inteiro de uma página; caso
+ * contrário a coluna é dividida entre duas páginas com deslocamento e
+ * máscara. O intervalo [first, last] já deve estar recortado à tela.
+ *
+ * @param x Posição X do glifo
+ * @param y Posição Y do glifo
+ * @param columns Colunas do glifo
+ * @param first Primeira coluna visível do glifo (0-7)
+ * @param last Última coluna visível do glifo (0-7)
+ */
+static void blit_glyph(int x, int y, const uint8_t columns[8], int first, int last) {
+    int page = (y >= 0) ? y / 8 : -((7 - y) / 8);
+    int shift = y & 7;
+
+    if (shift == 0) {
+        if (page < 0 || page >= SSD1306_PAGES) return;
+        ssd1306_cell_t *dst = &buffer[page][x];
+        for (int j = first; j <= last; j++) {
+            dst[j] = columns[j];
+        }
+        ssd1306_mark_dirty(page, x + first, x + last);
+        return;
+    }
+
+    if (page >= 0 && page < SSD1306_PAGES) {
+        uint8_t keep = (uint8_t)~(0xFF << shift);
+        ssd1306_cell_t *dst = &buffer[page][x];
+        for (int j = first; j <= last; j++) {
+            dst[j] = (dst[j] & keep) | (uint8_t)(columns[j] << shift);
+        }
+        ssd1306_mark_dirty(page, x + first, x + last);
+    }
+    if (page + 1 >= 0 && page + 1 < SSD1306_PAGES) {
+        uint8_t keep = (uint8_t)(0xFF << shift);
+        ssd1306_cell_t *dst = &buffer[page + 1][x];
+        for (int j = first; j <= last; j++) {
+            dst[j] = (dst[j] & keep) | (columns[j] >> (8 - shift));
+        }
+        ssd1306_mark_dirty(page + 1, x + first, x + last);
+    }
 }
 /**
  * @brief Desenha um caractere no display OLED
@@ -286,21 +299,20 @@ static inline uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b) {
  * @param inverted Se verdadeiro, inverte as cores do caractere
  */
 void draw_char(int x, int y, char c, bool inverted) {
-    int index = (unsigned char)c;
-    for (int i = 0; i < 8; i++) {
-        uint8_t line = font[index * 8 + i];
-        if (inverted) line = ~line;
-        for (int j = 0; j < 8; j++) {
-            if (line & (1 << j)) {
-                ssd1306_draw_pixel(x + j, y + i, true);
-            } else {
-                ssd1306_draw_pixel(x + j, y + i, false);
-            }
-        }
-    }
+    if (x <= -8 || x >= DISPLAY_WIDTH || y <= -8 || y >= DISPLAY_HEIGHT) return;
+
+    uint8_t scratch[8];
+    const uint8_t *columns = glyph_columns(c, inverted, scratch);
+    int first = (x < 0) ? -x : 0;
+    int last = (x > DISPLAY_WIDTH - 8) ? DISPLAY_WIDTH - 1 - x : 7;
+    blit_glyph(x, y, columns, first, last);
 }
 /**
  * @brief Desenha uma string no display OLED
+ *
+ * O recorte horizontal é decidido uma vez por string: com a quebra de
+ * linha em DISPLAY_WIDTH - 8, uma string iniciada em 0 <= x <= 120
+ * nunca ultrapassa a borda, e os glifos são copiados sem verificação.
  * 
  * @param x Posição X inicial no display
  * @param y Posição Y inicial no display
@@ -309,349 +321,327 @@ void draw_char(int x, int y, char c, bool inverted) {
  */
 void draw_string(int x, int y, const char *str, bool inverted) {
     int orig_x = x;
+    bool clip_x = (orig_x < 0 || orig_x > DISPLAY_WIDTH - 8);
+    bool line_visible = (y > -8 && y < DISPLAY_HEIGHT);
+    uint8_t scratch[8];
+
     for (int i = 0; str[i] != '\0'; i++) {
         if (str[i] == '\n') {
             x = orig_x;
             y += 9;
+            line_visible = (y > -8 && y < DISPLAY_HEIGHT);
             continue;
         }
-        draw_char(x, y, str[i], inverted);
+        if (line_visible) {
+            if (clip_x) {
+                draw_char(x, y, str[i], inverted);
+            } else {
+                blit_glyph(x, y, glyph_columns(str[i], inverted, scratch), 0, 7);
+            }
+        }
         x += 8;
         if (x >= DISPLAY_WIDTH - 8) {
             x = orig_x;
             y += 9;
+            line_visible = (y > -8 && y < DISPLAY_HEIGHT);
         }
     }
 }
+#ifdef MONITOR_BENCHMARK
+/** Fonte original por linhas, usada apenas pelo renderizador de referência */
+static const uint8_t font[] = {
+    FONT8X8_BASIC(FONT_GLYPH_ROWS)
+};
 /**
- * @brief Desenha uma linha horizontal no display
- * 
- * @param x0 Posição X inicial
- * @param y0 Posição Y
- * @param length Comprimento da linha em pixels
+ * @brief Renderizador de referência: um ssd1306_draw_pixel por pixel
+ *
+ * Implementação anterior de draw_char, mantida apenas para comparação.
  */
-void draw_horizontal_line(int x0, int y0, int length) {
-    for (int i = 0; i < length; i++) {
-        ssd1306_draw_pixel(x0 + i, y0, true);
+static void draw_char_pixelwise(int x, int y, char c, bool inverted) {
+    int index = (unsigned char)c & 0x7F;
+    for (int i = 0; i < 8; i++) {
+        uint8_t line = font[index * 8 + i];
+        if (inverted) line = ~line;
+        for (int j = 0; j < 8; j++) {
+            ssd1306_draw_pixel(x + j, y + i, line & (1 << j));
+        }
     }
 }
 /**
- * @brief Toca a música de inicialização
- * 
- * Reproduz uma sequência de notas musicais usando o buzzer
- * para indicar que o sistema foi iniciado
+ * @brief Renderizador de referência para strings (ver draw_char_pixelwise)
  */
-void play_startup_music() {
-    // Notas musicais (frequências em Hz)
-    uint notes[] = {
-        392,  // Sol4
-        494,  // Si4
-        587,  // Ré5
-        784,  // Sol5
-        587,  // Ré5
-        494,  // Si4
-        392   // Sol4
-    };
-    
-    // Durações das notas em ms (total: 7000ms)
-    uint durations[] = {
-        1000,  // 1.0s
-        1000,  // 1.0s
-        1000,  // 1.0s
-        1500,  // 1.5s
-        1000,  // 1.0s
-        750,   // 0.75s
-        750    // 0.75s
-    };
-    
-    for (int i = 0; i < 7; i++) {
-        play_tone(notes[i], durations[i]);
-        sleep_ms(50);  // Pequena pausa entre as notas
+static void draw_string_pixelwise(int x, int y, const char *str, bool inverted) {
+    int orig_x = x;
+    for (int i = 0; str[i] != '\0'; i++) {
+        if (str[i] == '\n') {
+            x = orig_x;
+            y += 9;
+            continue;
+        }
+        draw_char_pixelwise(x, y, str[i], inverted);
+        x += 8;
+        if (x >= DISPLAY_WIDTH - 8) {
+            x = orig_x;
+            y += 9;
+        }
     }
 }
 /**
- * @brief Inicializa a matriz de NeoPixels
- * 
- * Configura o PIO e inicializa o hardware para controle
- * da matriz 5x5 de LEDs RGB (WS2812B)
+ * @brief Desenha a tela de status típica com o renderizador indicado
  */
-void init_neopixels() {
-    // Inicializa o spin lock
-    pixel_lock_num = spin_lock_claim_unused(true);
-    pixel_lock = spin_lock_init(pixel_lock_num);
-    
-    uint offset = pio_add_program(pio, &monitor_program);
-    monitor_program_init(pio, sm, offset, OUT_PIN);
-    
-    // Limpa todos os pixels inicialmente
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        put_pixel(0);
-    }
-    
-    // Aguarda a conclusão da transmissão
-    sleep_ms(1);
+static void bench_render_screen(void (*render)(int, int, const char *, bool)) {
+    ssd1306_clear();
+    render(0, 0, "Mon Ambiental", false);
+    render(0, 15, "Temperatura", false);
+    render(0, 25, "25.3 C", false);
+    render(0, 35, "Media: 24.9 C", false);
+    render(0, 45, "ALERTA!", true);
+    render(100, 55, "1/3", false);
+    render(0, 56, "Pagina alinhada", false);
 }
-
-// Função auxiliar para mapear coordenadas x,y para o índice do LED na matriz
 /**
- * @brief Converte coordenadas x,y para índice do LED na matriz
- * 
- * @param x Coordenada X (0-4)
- * @param y Coordenada Y (0-4)
- * @return int Índice do LED na matriz
+ * @brief Tela de status com o renderizador por pixel
  */
-static int xy_to_pixel_index(int x, int y) {
-    if (y % 2 == 0) {
-        // Linhas pares: da esquerda para a direita
-        return y * 5 + x;
-    } else {
-        // Linhas ímpares: da direita para a esquerda
-        return y * 5 + (4 - x);
-    }
+static void bench_screen_pixelwise(void *ctx, uint32_t i) {
+    (void)ctx;
+    (void)i;
+    bench_render_screen(draw_string_pixelwise);
+}
+/**
+ * @brief Tela de status com o renderizador por bytes
+ */
+static void bench_screen(void *ctx, uint32_t i) {
+    (void)ctx;
+    (void)i;
+    bench_render_screen(draw_string);
+}
+/**
+ * @brief Um caractere, alinhado à página (y = 8) ou desalinhado (y = 13)
+ */
+static void bench_char(void *ctx, uint32_t i) {
+    int y = *(const int *)ctx;
+    draw_char((int)(i % 15) * 8, y, (char)('A' + i % 26), false);
+}
+/**
+ * @brief Uma linha de texto, como os valores da tela de sensores
+ */
+static void bench_string(void *ctx, uint32_t i) {
+    (void)ctx;
+    draw_string(0, 25, (i & 1) ? "Temp: 25.3 C" : "Temp: 25.4 C", false);
+}
+/**
+ * @brief Quadro completo: todas as páginas marcadas e enviadas
+ */
+static void bench_update_full(void *ctx, uint32_t i) {
+    (void)ctx;
+    (void)i;
+    ssd1306_invalidate();
+    ssd1306_update();
 }
+/**
+ * @brief Tela de status redesenhada e enviada, com o valor alternando
+ *
+ * O quadro inteiro é marcado por ssd1306_clear(); apenas as janelas que
+ * diferem do quadro anterior chegam ao barramento.
+ */
+static void bench_update_screen(void *ctx, uint32_t i) {
+    (void)ctx;
+    bench_render_screen(draw_string);
+    if (i & 1) draw_string(0, 25, "25.4 C", false);
+    ssd1306_update();
+}
+/**
+ * @brief Só o valor do sensor muda: envio das janelas alteradas
+ */
+static void bench_update_value(void *ctx, uint32_t i) {
+    bench_string(ctx, i);
+    ssd1306_update();
+}
+/** Tela de status da UI retida, para comparar com o redesenho completo */
+static ui_widget_t bench_widgets[] = {
+    UI_LABEL_AT(0, 0, "Mon Ambiental"),
+    UI_LINE_AT(0, 10, 128),
+    UI_LABEL_AT(0, 15, "Temperatura"),
+    UI_VALUE_AT(0, 25, 10),
+    UI_BAR_AT(88, 26, 40, 6),
+    UI_LABEL_AT(0, 35, "Media: 24.9 C"),
+    UI_VALUE_AT(100, 55, 3),
+};
+static ui_screen_t bench_ui_screen = UI_SCREEN(bench_widgets);
+/**
+ * @brief UI retida: só o valor e a barra mudam, só eles são redesenhados
+ */
+static void bench_update_ui(void *ctx, uint32_t i) {
+    (void)ctx;
+    ui_show(&bench_ui_screen);
+    ui_set_text(&bench_widgets[3], (i & 1) ? "25.4 C" : "25.3 C");
+    ui_set_bar(&bench_widgets[4], (i & 1) ? 254 : 253, 350);
+    ui_set_text(&bench_widgets[6], "1/3");
+    ui_render();
+    ssd1306_update();
+}
+/**
+ * @brief Casos de renderização de texto e de envio ao display
+ *
+ * Antes das medições, verifica se os renderizadores por bytes e por
+ * pixel produzem o mesmo buffer (posições alinhadas, desalinhadas e
+ * parcialmente fora da tela).
+ */
+static void run_text_benchmark(void) {
+    static ssd1306_cell_t reference[SSD1306_PAGES][DISPLAY_WIDTH];
+    const int positions[][2] = {{0, 0}, {3, 5}, {-5, 13}, {121, 60}, {40, -3}, {-9, 20}, {126, 7}};
+    const char *text = "WILDLIFE 0123\nabc xyz!";
 
-// Função melhorada para atualizar a animação de chamas
-void update_graphic_animation(PIO pio, uint sm, uint8_t frame) {
-    // Array para armazenar todos os pixels antes de enviá-los
-    uint32_t pixels[NUM_PIXELS] = {0};
-    
-    // Preenche o array com as cores da animação
-    for (int y = 0; y < 5; y++) {
-        for (int x = 0; x < 5; x++) {
-            int pixel_index = xy_to_pixel_index(x, y);
-            uint8_t intensity = graphic_frames[frame][y][x];
-            
-            uint8_t r = 0, g = 0, b = 0;
-            switch (intensity) {
-                case 0: // Desligado
-                    break;
-                case 1: // Vermelho escuro
-                    r = 6;
-                    break;
-                case 2: // Laranja
-                    g = 0;
-                    b = 10;
-                    break;
-                case 3: // Amarelo
-                    g = 0;
-                    b = 10;
-                    break;
+    for (size_t p = 0; p < count_of(positions); p++) {
+        for (int inv = 0; inv < 2; inv++) {
+            ssd1306_clear();
+            draw_string_pixelwise(positions[p][0], positions[p][1], text, inv);
+            memcpy(reference, buffer, sizeof(reference));
+            ssd1306_clear();
+            draw_string(positions[p][0], positions[p][1], text, inv);
+            if (memcmp(reference, buffer, sizeof(reference)) != 0) {
+                printf("AVISO bench: texto diverge em (%d,%d) inv=%d\n", positions[p][0], positions[p][1], inv);
             }
-            
-            // Formato GRB para NeoPixels
-            pixels[pixel_index] = ((uint32_t)g << 16) | ((uint32_t)r << 8) | b;
         }
     }
-    
-    // Desabilita interrupções durante o envio para timing preciso
-    uint32_t save = spin_lock_blocking(pixel_lock);
-    
-    // Envia todos os pixels de uma vez
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        put_pixel(pixels[i]);
-    }
-    
-    // Restaura interrupções
-    spin_unlock(pixel_lock, save);
-    
-    // Aguarda conclusão da transmissão
-    sleep_us(50);
-}
-
-// Função principal de atualização da matriz
-void update_neopixel_bars() {
-    static uint32_t last_animation_time = 0;
-    static int current_frame = 0;
-    uint32_t current_time = to_ms_since_boot(get_absolute_time());
 
-    // Atualiza a animação a cada 200ms
-    if (current_time - last_animation_time >= 200) {
-        current_frame = (current_frame + 1) % 4;
-        last_animation_time = current_time;
-        
-        // Atualiza a animação
-        update_graphic_animation(pio, sm, current_frame);
-    }
+    const int aligned_y = 8, unaligned_y = 13;
+    bench_case("tela_status_por_pixel", bench_screen_pixelwise, NULL);
+    bench_case("tela_status", bench_screen, NULL);
+    bench_case("draw_char", bench_char, (void *)&aligned_y);
+    bench_case("draw_char_desalinhado", bench_char, (void *)&unaligned_y);
+    bench_case("draw_string", bench_string, NULL);
+    bench_case("ssd1306_update_completo", bench_update_full, NULL);
+    bench_case("ssd1306_update_tela", bench_update_screen, NULL);
+    bench_case("ssd1306_update_valor", bench_update_value, NULL);
+    bench_case("ui_valor", bench_update_ui, NULL);
+    ui_invalidate();
+    ssd1306_clear();
 }
+#endif
 /**
- * @brief Exibe padrão SOS na matriz de LEDs
+ * @brief Desenha uma linha horizontal no display
  * 
- * Implementa o padrão Morse SOS (... --- ...) usando
- * os LEDs da matriz para sinalização de emergência
+ * @param x0 Posição X inicial
+ * @param y0 Posição Y
+ * @param length Comprimento da linha em pixels
  */
-void display_sos_neopixel() {
-    uint32_t current_time = to_ms_since_boot(get_absolute_time());
-    uint32_t t = current_time % 6000;
-    bool alarm_on = false;
-
-    if ((t < 200) || (t >= 400 && t < 600) || (t >= 800 && t < 1000) ||
-        (t >= 1600 && t < 2200) || (t >= 2400 && t < 3000) || (t >= 3200 && t < 3800) ||
-        (t >= 4400 && t < 4600) || (t >= 4800 && t < 5000) || (t >= 5200 && t < 5400)) {
-        alarm_on = true;
-    }
-
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        if (alarm_on) {
-            put_pixel(urgb_u32(255, 0, 0) << 8u);
-        } else {
-            put_pixel(0); // Apaga
-        }
+void draw_horizontal_line(int x0, int y0, int length) {
+    for (int i = 0; i < length; i++) {
+        ssd1306_draw_pixel(x0 + i, y0, true);
     }
 }
+/**
+ * @brief Toca a música de inicialização
+ * 
+ * Enfileira uma sequência de notas musicais no motor de áudio para
+ * indicar que o sistema foi iniciado. Retorna imediatamente: a música
+ * toca durante as telas de abertura, com a menor prioridade, e qualquer
+ * clique de menu a interrompe.
+ */
+void play_startup_music() {
+    // Notas musicais (frequência em Hz, duração em ms; total: 7000ms)
+    static const audio_note_t music[] = {
+        {392, 1000, AUDIO_DUTY_DEFAULT}, {0, 50, 0},  // Sol4
+        {494, 1000, AUDIO_DUTY_DEFAULT}, {0, 50, 0},  // Si4
+        {587, 1000, AUDIO_DUTY_DEFAULT}, {0, 50, 0},  // Ré5
+        {784, 1500, AUDIO_DUTY_DEFAULT}, {0, 50, 0},  // Sol5
+        {587, 1000, AUDIO_DUTY_DEFAULT}, {0, 50, 0},  // Ré5
+        {494,  750, AUDIO_DUTY_DEFAULT}, {0, 50, 0},  // Si4
+        {392,  750, AUDIO_DUTY_DEFAULT}, {0, 50, 0}   // Sol4
+    };
+    audio_play(music, sizeof(music) / sizeof(music[0]), AUDIO_PRIO_MUSIC);
+}
 /**
  * @brief Menu de configuração inicial
  * 
  * Permite habilitar/desabilitar os diferentes módulos:
- * - Temperatura
- * - Fluxo de água
- * - Chuva
+ * - Cada sensor registrado, na ordem de registro
  * - Detecção de incêndio
  * - Monitoramento de vida silvestre
  */
 void init_menu() {
-    const char *options[] = {"Temperatura", "Fluviometro", "Chuva", "Incendio", "Vida Silvestre"};
-    bool states[] = {temp_enabled, flow_enabled, rain_enabled, fire_enabled, wildlife_enabled};
+    const char *options[SENSOR_MAX + 2];
+    bool states[SENSOR_MAX + 2];
+    int num_sensors = sensor_count();
+    int num_options = num_sensors + 2;
+    for (int i = 0; i < num_sensors; i++) {
+        sensor_t *sensor = sensor_get(i);
+        options[i] = sensor_menu_name(sensor);
+        states[i] = sensor->enabled;
+    }
+    options[num_sensors] = "Incendio";
+    states[num_sensors] = fire_enabled;
+    options[num_sensors + 1] = "Vida Silvestre";
+    states[num_sensors + 1] = wildlife_enabled;
     int menu_index = 0;
     bool menu_active = true;
+    button_event_t event;
+
+    // Toques nas telas de abertura não valem para o menu
+    while (buttons_poll(&event)) {
+    }
 
     while (menu_active) {
         ssd1306_clear();
         draw_string(0, 0, "CONFIGURACAO", false);
         draw_horizontal_line(0, 10, 128);
         draw_string(0, 15, options[menu_index], false);
-        char state_str[10];
+        char state_str[16];
         sprintf(state_str, "Estado: %s", states[menu_index] ? "ON" : "OFF");
         draw_string(0, 25, state_str, false);
         draw_string(0, 40, "A: Alternar", false);
         draw_string(0, 50, "B: Iniciar", false);
         ssd1306_update();
 
-        bool button_a_pressed = !gpio_get(BUTTON_A_PIN);
-        bool button_b_pressed = !gpio_get(BUTTON_B_PIN);
-        adc_select_input(JOY_X_PIN - 26);
-        uint16_t joy_x_value = adc_read();
+        // Cada toque enfileirado conta, mesmo os que ocorreram durante o sleep
+        while (menu_active && buttons_poll(&event)) {
+            if (event.type != BUTTON_EVENT_PRESS) continue;
+            if (event.button == BUTTON_A) {
+                states[menu_index] = !states[menu_index];
+                play_tone(660, 50);
+            } else if (event.button == BUTTON_B) {
+                menu_active = false;
+                for (int i = 0; i < num_sensors; i++) {
+                    sensor_set_enabled(i, states[i]);
+                }
+                fire_enabled = states[num_sensors];
+                wildlife_enabled = states[num_sensors + 1];
+                play_tone(880, 100);
+            }
+        }
+        if (!menu_active) break;
 
+        // O joystick é analógico: uma ação a cada 200 ms enquanto inclinado
+        uint32_t joy_x_value = analog_get(ANALOG_JOY_X);
         static uint32_t last_action_time = 0;
         uint32_t current_time = to_ms_since_boot(get_absolute_time());
-        if (current_time - last_action_time < 200) {
-            sleep_ms(50);
-            continue;
-        }
-
-        if (joy_x_value < 1000) {
-            menu_index = (menu_index + 4) % 5;
-            last_action_time = current_time;
-            play_tone(440, 50);
-        }
-        else if (joy_x_value > 3000) {
-            menu_index = (menu_index + 1) % 5;
-            last_action_time = current_time;
-            play_tone(440, 50);
-        }
-
-        if (button_a_pressed) {
-            states[menu_index] = !states[menu_index];
-            last_action_time = current_time;
-            play_tone(660, 50);
-        }
-
-        if (button_b_pressed) {
-            menu_active = false;
-            temp_enabled = states[0];
-            flow_enabled = states[1];
-            rain_enabled = states[2];
-            fire_enabled = states[3];
-            wildlife_enabled = states[4];
-            last_action_time = current_time;
-            play_tone(880, 100);
+        if (current_time - last_action_time >= 200) {
+            if (joy_x_value < ANALOG_FROM_12BIT(1000)) {
+                menu_index = (menu_index + num_options - 1) % num_options;
+                last_action_time = current_time;
+                play_tone(440, 50);
+            } else if (joy_x_value > ANALOG_FROM_12BIT(3000)) {
+                menu_index = (menu_index + 1) % num_options;
+                last_action_time = current_time;
+                play_tone(440, 50);
+            }
         }
 
         sleep_ms(50);
     }
 }
 /**
- * @brief Reproduz alerta sonoro para detecção de animais
+ * @brief Enfileira o alerta sonoro para detecção de animais (não bloqueia)
  */
 void play_wildlife_alert() {
     if (!wildlife_enabled) return;
-    for (int i = 0; i < 3; i++) {
-        play_tone(440, 500);
-        sleep_ms(100);
-    }
-}
-/**
- * @brief Reproduz um tom no buzzer
- * 
- * @param frequency Frequência do tom em Hz
- * @param duration Duração em milissegundos
- */
-void play_tone(uint frequency, uint duration) {
-    uint slice_num = pwm_gpio_to_slice_num(BUZZER_PIN);
-    uint wrap_value = (uint)(clock_get_hz(clk_sys) / frequency) - 1;
-    pwm_set_wrap(slice_num, wrap_value);
-    pwm_set_clkdiv(slice_num, 1.0f);
-    pwm_set_enabled(slice_num, true);
-    pwm_set_gpio_level(BUZZER_PIN, wrap_value / 2);
-    sleep_ms(duration);
-    pwm_set_gpio_level(BUZZER_PIN, 0);
-}
-/**
- * @brief Atualiza o estado do alerta SOS
- * 
- * Controla LEDs, buzzer e matriz de NeoPixels durante
- * o alerta de incêndio
- */
-void update_sos_alert() {
-    if (!fire_enabled || !fire_alert_active) {
-        gpio_put(LED_R_PIN, 0);
-        pwm_set_gpio_level(BUZZER_PIN, 0);
-        for (int i = 0; i < NUM_PIXELS; i++) {
-            put_pixel(0); // Apaga NeoPixels
-        }
-        return;
-    }
-
-    static uint32_t last_update = 0;
-    static uint buzzer_wrap = 0; // Armazena o valor do wrap do PWM
-    uint32_t current_time = to_ms_since_boot(get_absolute_time());
-    uint32_t t = current_time % 5400; // Ciclo de 5400ms
-    bool led_on = false;
-    bool neopixel_on = false;
-    bool buzzer_on = false;
-
-    // Padrão SOS: tempos em ms
-    // S: 3 pontos (200ms ON, 200ms OFF) -> 0-1000
-    // O: 3 traços (600ms ON, 200ms OFF) -> 1600-3800
-    // S: 3 pontos (200ms ON, 200ms OFF) -> 4400-5400
-    if (t < 200 || (t >= 400 && t < 600) || (t >= 800 && t < 1000) ||           // S (pontos)
-        (t >= 1600 && t < 2200) || (t >= 2400 && t < 3000) || (t >= 3200 && t < 3800) || // O (traços)
-        (t >= 4400 && t < 4600) || (t >= 4800 && t < 5000) || (t >= 5200 && t < 5400)) { // S (pontos)
-        led_on = true;
-        neopixel_on = true;
-        buzzer_on = true;
-    }
-
-    // Atualiza LED
-    gpio_put(LED_R_PIN, led_on ? 1 : 0);
-
-    // Atualiza NeoPixels (vermelho corrigido: GRB = 0, 255, 0)
-    uint32_t save = spin_lock_blocking(pixel_lock);
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        put_pixel(neopixel_on ? urgb_u32(0, 255, 0) : 0); // Vermelho em GRB
-    }
-    spin_unlock(pixel_lock, save);
-
-    // Atualiza buzzer (não bloqueante)
-    uint slice_num = pwm_gpio_to_slice_num(BUZZER_PIN);
-    if (buzzer_on && last_update != current_time) {
-        buzzer_wrap = (uint)(clock_get_hz(clk_sys) / 650) - 1; // Calcula e armazena o wrap
-        pwm_set_wrap(slice_num, buzzer_wrap);
-        pwm_set_gpio_level(BUZZER_PIN, buzzer_wrap / 2); // Define nível como 50% do ciclo
-    } else {
-        pwm_set_gpio_level(BUZZER_PIN, 0);
-    }
-
-    last_update = current_time;
+    static const audio_note_t alert[] = {
+        {440, 500, AUDIO_DUTY_DEFAULT}, {0, 100, 0},
+        {440, 500, AUDIO_DUTY_DEFAULT}, {0, 100, 0},
+        {440, 500, AUDIO_DUTY_DEFAULT}, {0, 100, 0}
+    };
+    audio_play(alert, sizeof(alert) / sizeof(alert[0]), AUDIO_PRIO_ALERT);
 }
 /**
  * @brief Detecta condições de incêndio na área monitorada
@@ -665,7 +655,7 @@ void detect_fire() {
     if (!fire_enabled || fire_alert_active) return;
 
     // Verifica se apenas o incêndio está ativo
-    bool only_fire_enabled = fire_enabled && !temp_enabled && !flow_enabled && !rain_enabled && !wildlife_enabled;
+    bool only_fire_enabled = fire_enabled && sensor_enabled_count() == 0 && !wildlife_enabled;
 
     // Probabilidade base: 1% (10/1000)
     int base_chance = 10;
@@ -677,19 +667,59 @@ void detect_fire() {
 
     // Força um incêndio após 5 segundos se apenas incêndio estiver ativo
     if (only_fire_enabled && (current_time - last_check_time > 5000)) {
-        fire_alert_active = true;
-        fire_alert_start = current_time;
         last_check_time = current_time;
-        printf("\n*** ALERTA DE INCENDIO: Fogo detectado na floresta! (Forçado após 5s) ***\n");
+        raise_fire_alert(current_time, "Forçado após 5s");
     }
     // Detecção aleatória
     else if (rand() % 1000 < fire_chance) {
-        fire_alert_active = true;
-        fire_alert_start = current_time;
         last_check_time = current_time;
-        printf("\n*** ALERTA DE INCENDIO: Fogo detectado na floresta! ***\n");
+        raise_fire_alert(current_time, NULL);
+    }
+}
+/**
+ * @brief Ativa o alerta de incendio (SOS, display e log)
+ *
+ * @param reason Origem exibida na serial (ex.: regra), ou NULL
+ */
+void raise_fire_alert(uint32_t now_ms, const char *reason) {
+    if (!fire_enabled || fire_alert_active) return;
+    fire_alert_active = true;
+    fire_alert_start = now_ms;
+    if (reason) printf("\n*** ALERTA DE INCENDIO: Fogo detectado na floresta! (%s) ***\n", reason);
+    else printf("\n*** ALERTA DE INCENDIO: Fogo detectado na floresta! ***\n");
+
+    set_output_pattern(OUTPUT_PATTERN_SOS);
+    request_display_refresh();
+    note_event(now_ms, "Incendio");
+    log_event(now_ms, FLASHLOG_FLAG_FIRE, 0);
+    flashlog_flush();  // O alerta não pode depender do próximo setor completo
+}
+/**
+ * @brief Executa a ação de uma regra disparada
+ */
+void handle_rule(const rule_t *rule, uint32_t now_ms) {
+    printf("\n*** REGRA %s: %s (sev %u) ***\n", rule->name, rules_action_name(rule->action), rule->severity);
+    note_event(now_ms, rule->name);
+    log_event(now_ms, FLASHLOG_FLAG_RULE, rule->id);
+    switch (rule->action) {
+        case RULE_ACTION_FIRE:
+            raise_fire_alert(now_ms, rule->name);
+            break;
+        case RULE_ACTION_ALERT:
+            audio_tone(660, 300, AUDIO_DUTY_DEFAULT, AUDIO_PRIO_ALERT);
+            request_display_refresh();
+            break;
+        default:
+            break;
     }
 }
+/**
+ * @brief Acrescenta um alerta ou detecção à tela de histórico
+ */
+void note_event(uint32_t now_ms, const char *text) {
+    logview_add(now_ms, text);
+    if (logview_is_open()) request_display_refresh();
+}
 /**
  * @brief Detecta presença de animais silvestres
  * 
@@ -707,8 +737,12 @@ void detect_wildlife() {
         wildlife[animal_index].detection_time = to_ms_since_boot(get_absolute_time());
         last_detected_wildlife = animal_index;
         wildlife_alert_active = true;
-        display_sensor_data();
+        request_display_refresh();
         play_wildlife_alert();
+        char text[LOGVIEW_TEXT_LEN];
+        snprintf(text, sizeof(text), "Animal %d", animal_index + 1);
+        note_event(wildlife[animal_index].detection_time, text);
+        log_event(wildlife[animal_index].detection_time, FLASHLOG_FLAG_WILDLIFE, animal_index);
         printf("\n*** ALERTA: %s detectado! ***\n", wildlife[animal_index].name);
         printf("Imagem capturada: %s\n", wildlife[animal_index].link);
         printf("------------------------------\n");
@@ -731,168 +765,129 @@ void check_wildlife_alerts() {
         }
     }
 }
+/** Sino 8x8 em colunas, aceso enquanto algum sensor estiver em anomalia */
+static const uint8_t icon_bell[8] = {0x20, 0x38, 0x3C, 0xBE, 0xBE, 0x3C, 0x38, 0x20};
+
 /**
- * @brief Simula leitura de sensor
- * 
- * @param sensor Configuração do sensor
- * @return float Valor simulado da leitura
- */
-float simulate_reading(SensorConfig *sensor) {
-    float base = sensor->value;
-    
-    if (strcmp(sensor->name, "Temperatura") == 0 && temp_enabled) {
-        time_t t = time(NULL);
-        struct tm* tm_info = localtime(&t);
-        int hour = tm_info ? tm_info->tm_hour : 12;
-        float daily_variation = 5.0f * sinf((hour - 14) * 3.14159f / 12);
-        base = (sensor->min_val + sensor->max_val) / 2 + daily_variation;
-    }
-    else if (strcmp(sensor->name, "Chuva") == 0 && rain_enabled) {
-        if (rand() % 100 < 30) {
-            base = (float)(rand() % (int)(sensor->max_val));
-        } else {
-            base = 0.0f;
-        }
-    }
-    else if (strcmp(sensor->name, "Fluxo Agua") == 0 && flow_enabled) {
-        base = sensors[2].value > 0 ? (float)(rand() % 20) : 0.0f;
-    }
-    
-    float variation = ((float)rand() / RAND_MAX * 2 - 1) * sensor->variation;
-    float new_value = base + variation;
-    if (new_value < sensor->min_val) new_value = sensor->min_val;
-    if (new_value > sensor->max_val) new_value = sensor->max_val;
-    return new_value;
-}
-/**
- * @brief Atualiza o valor do sensor
- * 
- * @param sensor Sensor a ser atualizado
- */
-void update_sensor_value(SensorConfig *sensor) {
-    float new_value = simulate_reading(sensor);
-    for (int i = 0; i < 9; i++) {
-        sensor->history[i] = sensor->history[i + 1];
-    }
-    sensor->history[9] = new_value;
-    sensor->value = new_value;
-}
-/**
- * @brief Calcula média móvel das últimas 10 leituras
- * 
- * @param sensor Sensor para cálculo
- * @return float Média das leituras
- */
-float calculate_moving_average(SensorConfig *sensor) {
-    float sum = 0;
-    for (int i = 0; i < 10; i++) {
-        sum += sensor->history[i];
-    }
-    return sum / 10;
-}
-/**
- * @brief Verifica anomalias nas leituras
- * 
- * @param sensor Sensor a ser verificado
- * @return true Se houver anomalia
- * @return false Caso contrário
+ * @brief Telas do display (widgets retidos)
+ *
+ * Os rótulos são fixos; os valores e barras só são redesenhados quando o
+ * texto ou o comprimento em pixels mudam.
  */
-bool check_anomaly(SensorConfig *sensor) {
-    return (sensor->value < sensor->anomaly_min || sensor->value > sensor->anomaly_max);
-}
+static ui_widget_t fire_widgets[] = {
+    UI_LABEL_AT(0, 0, "** INCENDIO **"),
+    UI_LINE_AT(0, 10, 128),
+    UI_LABEL_AT(0, 15, "SOS Ativado!"),
+    UI_LABEL_AT(0, 25, "Pressione B"),
+    UI_LABEL_AT(0, 35, "para cancelar"),
+};
+static ui_screen_t fire_screen = UI_SCREEN(fire_widgets);
+
+enum { WILD_NAME = 3 };
+static ui_widget_t wildlife_widgets[] = {
+    UI_LABEL_AT(0, 0, "*** ALERTA ***"),
+    UI_LINE_AT(0, 10, 128),
+    UI_LABEL_AT(0, 15, "Animal visto:"),
+    UI_VALUE_AT(0, 25, 15),
+    UI_LABEL_AT(0, 40, "Pressione um"),
+    UI_LABEL_AT(0, 50, "botao"),
+};
+static ui_screen_t wildlife_screen = UI_SCREEN(wildlife_widgets);
+
+enum { MSG_LINE1 = 0, MSG_LINE2 };
+static ui_widget_t message_widgets[] = {
+    UI_VALUE_AT(0, 20, 15),
+    UI_VALUE_AT(0, 30, 15),
+};
+static ui_screen_t message_screen = UI_SCREEN(message_widgets);
+
+enum { SENS_ICON = 1, SENS_NAME = 3, SENS_VALUE, SENS_LEVEL, SENS_MEAN, SENS_ALERT, SENS_INDEX };
+static ui_widget_t sensor_widgets[] = {
+    UI_LABEL_AT(0, 0, "Mon Ambiental"),
+    UI_ICON_AT(120, 0, icon_bell),
+    UI_LINE_AT(0, 10, 128),
+    UI_VALUE_AT(0, 15, 15),
+    UI_VALUE_AT(0, 25, 10),
+    UI_BAR_AT(88, 26, 40, 6),    // Leitura dentro da faixa do sensor
+    UI_VALUE_AT(0, 35, 15),
+    UI_VALUE_AT(0, 45, 15),
+    UI_VALUE_AT(100, 55, 3),
+};
+static ui_screen_t sensor_screen = UI_SCREEN(sensor_widgets);
+
 /**
  * @brief Exibe dados dos sensores no display
  * 
- * Mostra valores atuais, médias e alertas no
- * display OLED
+ * Atualiza os widgets da tela atual com valores, médias e
+ * alertas. Não desenha nem envia nada: a tarefa de display
+ * redesenha os widgets alterados e faz o único envio do quadro.
  */
 void display_sensor_data() {
     if (!display_initialized) return;
-    ssd1306_clear();
 
     if (fire_enabled && fire_alert_active) {
-        draw_string(0, 0, "*** INCENDIO ***", false);
-        draw_horizontal_line(0, 10, 128);
-        draw_string(0, 15, "SOS Ativado!", false);
-        draw_string(0, 25, "Pressione B", false);
-        draw_string(0, 35, "para cancelar", false);
-        ssd1306_update();
-        return;
-    }
-
-    if (wildlife_enabled && wildlife_alert_active && last_detected_wildlife >= 0) {
-        draw_string(0, 0, "*** ALERTA ***", false);
-        draw_horizontal_line(0, 10, 128);
-        char animal_msg[30];
-        sprintf(animal_msg, "Animal detectado:");
-        draw_string(0, 15, animal_msg, false);
-        draw_string(0, 25, wildlife[last_detected_wildlife].name, false);
-        draw_string(0, 40, "Pressione qualquer", false);
-        draw_string(0, 50, "botao para continuar", false);
-        gpio_put(LED_R_PIN, 0);
-        gpio_put(LED_G_PIN, 0);
-        gpio_put(LED_B_PIN, 1);
-        sleep_ms(100);
-        gpio_put(LED_B_PIN, 0);
+        ui_show(&fire_screen);
+    } else if (wildlife_enabled && wildlife_alert_active && last_detected_wildlife >= 0) {
+        ui_set_text(&wildlife_widgets[WILD_NAME], wildlife[last_detected_wildlife].name);
+        ui_show(&wildlife_screen);
+        // LED azul pisca a cada 200 ms enquanto o alerta estiver ativo
+        uint32_t current_time = to_ms_since_boot(get_absolute_time());
+        outputs_set_rgb(false, false, (current_time / 200) % 2 == 0);
     } else {
         // Conta todos os recursos habilitados, não apenas os sensores ambientais
-        int active_features = (temp_enabled ? 1 : 0) + (flow_enabled ? 1 : 0) + 
-                             (rain_enabled ? 1 : 0) + (fire_enabled ? 1 : 0) + 
-                             (wildlife_enabled ? 1 : 0);
+        int active_sensors = sensor_enabled_count();
+        int active_features = active_sensors + (fire_enabled ? 1 : 0) + (wildlife_enabled ? 1 : 0);
         if (active_features == 0) {
-            draw_string(0, 20, "Nenhum sensor", false);
-            draw_string(0, 30, "ativo", false);
-            ssd1306_update();
-            update_neopixel_bars();
-            return;
-        }
-        
-        // Exibe sensores ambientais apenas se houver pelo menos um ativo
-        int active_sensors = (temp_enabled ? 1 : 0) + (flow_enabled ? 1 : 0) + (rain_enabled ? 1 : 0);
-        if (active_sensors == 0) {
-            draw_string(0, 20, "Monitorando:", false);
-            draw_string(0, 30, fire_enabled ? "Incendio" : "Animais", false);
-            ssd1306_update();
-            update_neopixel_bars();
-            return;
-        }
-        
-        draw_string(0, 0, "Mon Ambiental", false);
-        draw_horizontal_line(0, 10, 128);
-        SensorConfig *sensor = &sensors[current_sensor_index];
-        if ((strcmp(sensor->name, "Temperatura") == 0 && !temp_enabled) ||
-            (strcmp(sensor->name, "Fluxo Agua") == 0 && !flow_enabled) ||
-            (strcmp(sensor->name, "Chuva") == 0 && !rain_enabled)) {
-            current_sensor_index = (current_sensor_index + 1) % 3;
-            return;
-        }
-        
-        draw_string(0, 15, sensor->name, false);
-        char value_str[20];
-        sprintf(value_str, "%.1f %s", sensor->value, sensor->unit);
-        draw_string(0, 25, value_str, false);
-        
-        float avg = calculate_moving_average(sensor);
-        sprintf(value_str, "Media: %.1f %s", avg, sensor->unit);
-        draw_string(0, 35, value_str, false);
-        
-        if (check_anomaly(sensor)) {
-            draw_string(0, 45, "ALERTA!", false);
-            gpio_put(LED_R_PIN, 1);
-            gpio_put(LED_G_PIN, 0);
-            gpio_put(LED_B_PIN, 0);
-            play_tone(449, 500);
+            ui_set_text(&message_widgets[MSG_LINE1], "Nenhum sensor");
+            ui_set_text(&message_widgets[MSG_LINE2], "ativo");
+            ui_show(&message_screen);
+        } else if (active_sensors == 0) {
+            // Exibe sensores ambientais apenas se houver pelo menos um ativo
+            ui_set_text(&message_widgets[MSG_LINE1], "Monitorando:");
+            ui_set_text(&message_widgets[MSG_LINE2], fire_enabled ? "Incendio" : "Animais");
+            ui_show(&message_screen);
         } else {
-            gpio_put(LED_R_PIN, 0);
-            gpio_put(LED_G_PIN, 1);
-            gpio_put(LED_B_PIN, 0);
+            sensor_t *sensor = sensor_get(current_sensor_index);
+            if (sensor == NULL || !sensor->enabled) {
+                current_sensor_index = sensor_next_enabled(current_sensor_index, 1);
+                sensor = sensor_get(current_sensor_index);
+            }
+            const sensor_driver_t *driver = sensor->driver;
+
+            ui_set_text(&sensor_widgets[SENS_NAME], driver->name);
+            ui_set_textf(&sensor_widgets[SENS_VALUE], "%.1f %s", fix_to_float(sensor->value), driver->unit);
+            ui_set_bar(&sensor_widgets[SENS_LEVEL], sensor->value - driver->min_val, driver->max_val - driver->min_val);
+            ui_set_textf(&sensor_widgets[SENS_MEAN], "Media: %.1f %s", fix_to_float(sensor_mean(sensor)), driver->unit);
+
+            // Bipe apenas na entrada em anomalia, não a cada redesenho
+            static int last_anomaly_sensor = -1;
+            if (sensor_is_anomalous(sensor)) {
+                char rules[24];
+                ui_set_textf(&sensor_widgets[SENS_ALERT], "ALERTA! %s",
+                             anomaly_format_rules(sensor_anomaly_rules(sensor), rules, sizeof(rules)));
+                outputs_set_rgb(true, false, false);
+                if (last_anomaly_sensor != current_sensor_index) {
+                    last_anomaly_sensor = current_sensor_index;
+                    audio_tone(449, 500, AUDIO_DUTY_DEFAULT, AUDIO_PRIO_ALERT);
+                }
+            } else {
+                ui_set_text(&sensor_widgets[SENS_ALERT], "");
+                last_anomaly_sensor = -1;
+                outputs_set_rgb(false, true, false);
+            }
+
+            bool any_anomaly = false;
+            for (int i = 0; i < sensor_count(); i++) {
+                sensor_t *s = sensor_get(i);
+                if (s->enabled && sensor_is_anomalous(s)) any_anomaly = true;
+            }
+            ui_set_visible(&sensor_widgets[SENS_ICON], any_anomaly);
+            // Posição entre os habilitados, como a navegação pelo joystick e botões
+            ui_set_textf(&sensor_widgets[SENS_INDEX], "%d/%d", sensor_enabled_position(current_sensor_index) + 1,
+                         active_sensors);
+            ui_show(&sensor_screen);
         }
-        
-        sprintf(value_str, "%d/%d", current_sensor_index + 1, 3);
-        draw_string(100, 55, value_str, false);
     }
-    ssd1306_update();
-    update_neopixel_bars();
 }
 /**
  * @brief Envia dados para porta serial
@@ -902,155 +897,408 @@ void display_sensor_data() {
  */
 void send_serial_data() {
     printf("\n===== LEITURA DOS SENSORES =====\n");
-    if (temp_enabled) {
-        float avg = calculate_moving_average(&sensors[0]);
-        printf("%s: %.1f %s (Media: %.1f)\n", sensors[0].name, sensors[0].value, sensors[0].unit, avg);
-        sleep_ms(1000); // Atraso de 1 segundo
-    }
-    if (flow_enabled) {
-        float avg = calculate_moving_average(&sensors[1]);
-        printf("%s: %.1f %s (Media: %.1f)\n", sensors[1].name, sensors[1].value, sensors[1].unit, avg);
-        sleep_ms(1000); // Atraso de 1 segundo
-    }
-    if (rain_enabled) {
-        float avg = calculate_moving_average(&sensors[2]);
-        printf("%s: %.1f %s (Media: %.1f)\n", sensors[2].name, sensors[2].value, sensors[2].unit, avg);
-        sleep_ms(1000); // Atraso de 1 segundo
+    for (int i = 0; i < sensor_count(); i++) {
+        sensor_t *sensor = sensor_get(i);
+        if (!sensor->enabled) continue;
+        printf("%s: %.1f %s (Media: %.1f, Min: %.1f, Max: %.1f, Desvio: %.2f)\n",
+               sensor->driver->name, fix_to_float(sensor->value), sensor->driver->unit,
+               fix_to_float(sensor_mean(sensor)),
+               fix_to_float(history_min(&sensor->history)),
+               fix_to_float(history_max(&sensor->history)),
+               fix_to_float(history_stddev(&sensor->history)));
     }
     
     bool has_anomaly = false;
     printf("ALERTA: Anomalias detectadas em: ");
-    if (temp_enabled && check_anomaly(&sensors[0])) {
-        printf("%s ", sensors[0].name);
-        has_anomaly = true;
+    for (int i = 0; i < sensor_count(); i++) {
+        sensor_t *sensor = sensor_get(i);
+        if (sensor->enabled && sensor_is_anomalous(sensor)) {
+            char rules[32];
+            printf("%s(%s) ", sensor->driver->name,
+                   anomaly_format_rules(sensor_anomaly_rules(sensor), rules, sizeof(rules)));
+            has_anomaly = true;
+        }
     }
-    if (flow_enabled && check_anomaly(&sensors[1])) {
-        printf("%s ", sensors[1].name);
-        has_anomaly = true;
+    if (!has_anomaly) printf("Nenhuma");
+    printf("\nDisplay: %lu bytes no ultimo quadro (total %lu)\n",
+           (unsigned long)ssd1306_get_frame_bytes(), (unsigned long)ssd1306_get_total_bytes());
+    printf("Matriz: %lu quadros enviados, %lu repetidos descartados\n",
+           (unsigned long)neopixel_get_frames_sent(), (unsigned long)neopixel_get_frames_skipped());
+    print_task_stats();
+    print_display_stats();
+    print_idle_stats();
+    printf("------------------------------\n");
+}
+/**
+ * @brief Envia um registro de telemetria binária
+ *
+ * Alternativa compacta ao relatório de texto: valores em ponto fixo
+ * (décimos) e bitmaps de sensores e alertas, sem formatação de float.
+ */
+void send_serial_binary() {
+    telemetry_record_t record = {0};
+
+    record.timestamp_ms = to_ms_since_boot(get_absolute_time());
+    if (fire_enabled && fire_alert_active) record.alerts |= TELEMETRY_ALERT_FIRE;
+    if (wildlife_enabled && wildlife_alert_active) record.alerts |= TELEMETRY_ALERT_WILDLIFE;
+    for (int i = 0; i < sensor_count() && i < TELEMETRY_MAX_SENSORS; i++) {
+        sensor_t *sensor = sensor_get(i);
+        if (!sensor->enabled) continue;
+        record.sensor_mask |= 1u << i;
+        record.value[i] = telemetry_fixed(sensor->value);
+        record.mean[i] = telemetry_fixed(sensor_mean(sensor));
+        if (sensor_is_anomalous(sensor)) record.anomaly_mask |= 1u << i;
     }
-    if (rain_enabled && check_anomaly(&sensors[2])) {
-        printf("%s ", sensors[2].name);
-        has_anomaly = true;
+    telemetry_send(&record);
+}
+/**
+ * @brief Registra as leituras dos sensores habilitados no log da flash
+ */
+void log_sensor_readings(uint32_t now_ms) {
+    for (int i = 0; i < sensor_count(); i++) {
+        sensor_t *sensor = sensor_get(i);
+        if (!sensor->enabled) continue;
+        flashlog_record_t record = {
+            .timestamp_ms = now_ms,
+            .value = sensor->value,
+            .sensor = (uint8_t)i,
+            .type = FLASHLOG_READING,
+            .flags = (uint16_t)((sensor_is_anomalous(sensor) ? FLASHLOG_FLAG_ANOMALY : 0) |
+                                (sensor_anomaly_rules(sensor) << FLASHLOG_ANOMALY_RULES_SHIFT))
+        };
+        flashlog_append(&record);
     }
-    if (!has_anomaly) printf("Nenhuma");
-    printf("\n------------------------------\n");
-    sleep_ms(1000); // Atraso de 1 segundo
 }
 /**
- * @brief Verifica estado dos botões
- * 
- * Processa entradas do usuário via botões
- * e joystick
+ * @brief Registra um alerta no log da flash
+ *
+ * @param flags FLASHLOG_FLAG_* do alerta
+ * @param value Dado do evento (ex.: índice do animal)
  */
-void check_buttons() {
-    debounce_buttons();
-    
-    if (fire_enabled && fire_alert_active) {
-        bool button_b_pressed = !gpio_get(BUTTON_B_PIN);
-        static uint32_t last_cancel_time = 0;
-        uint32_t current_time = to_ms_since_boot(get_absolute_time());
-        
-        if (button_b_pressed && (current_time - last_cancel_time > 200)) {
-            fire_alert_active = false;
-            gpio_put(LED_R_PIN, 0);
-            printf("\nAlerta de incendio cancelado pelo usuario.\n");
-            play_tone(880, 100);
-            last_cancel_time = current_time;
-            sleep_ms(200);
-            display_sensor_data();
-            return;
+void log_event(uint32_t now_ms, uint16_t flags, int32_t value) {
+    flashlog_record_t record = {
+        .timestamp_ms = now_ms,
+        .value = value,
+        .sensor = FLASHLOG_NO_SENSOR,
+        .type = FLASHLOG_EVENT,
+        .flags = flags
+    };
+    flashlog_append(&record);
+}
+/**
+ * @brief Troca o formato da saída serial por comandos recebidos
+ *
+ * 'b' seleciona a telemetria binária, 't' o relatório de texto, 'd'
+ * envia o log da flash em CSV e 'r' lista as regras de alerta.
+ */
+void check_serial_commands() {
+    int c = getchar_timeout_us(0);
+    if (c == 'd') {
+        flashlog_flush();
+        flashlog_cursor_begin(&logdump_cursor);
+        printf("\nLOG,boot,timestamp_ms,tipo,sensor,valor,alertas\n");
+        scheduler_set_enabled(logdump_task_id, true);
+    } else if (c == 'b') {
+        telemetry_set_mode(TELEMETRY_MODE_BINARY);
+    } else if (c == 't') {
+        telemetry_set_mode(TELEMETRY_MODE_TEXT);
+        printf("\nTelemetria em texto (%lu bytes binarios enviados)\n",
+               (unsigned long)telemetry_get_bytes_sent());
+    } else if (c == 'r') {
+        printf("\nREGRA,nome,acao,sev,avaliacoes,disparos\n");
+        for (int i = 0; i < rules_count(); i++) {
+            const rule_t *rule = rules_get(i);
+            printf("REGRA,%s,%s,%u,%lu,%lu\n", rule->name, rules_action_name(rule->action), rule->severity,
+                   (unsigned long)rule->evaluations, (unsigned long)rule->fired);
         }
     }
-    
-    if (wildlife_enabled && wildlife_alert_active) {
-        if (!button_a_last_state || !button_b_last_state || !joy_button_last_state) {
-            wildlife_alert_active = false;
-            printf("\nAlerta de animal silvestre cancelado pelo usuario.\n");
-            sleep_ms(200);
-            display_sensor_data();
-            return;
+#if MONITOR_PROFILE
+    else if (c == 'p') {
+        bool enable = !scheduler_get_task(profile_task_id)->enabled;
+        if (enable) {
+            profile_reset();
+            printf("\nPERF,fase,n,min_us,p50_us,p99_us,max_us\n");
         }
+        scheduler_set_enabled(profile_task_id, enable);
+    }
+#endif
+}
+/**
+ * @brief Trata um evento de botão durante o monitoramento
+ *
+ * B cancela o alerta de incêndio; qualquer botão cancela o alerta de
+ * vida silvestre. Fora dos alertas, A e B navegam entre os sensores.
+ * @param event Evento retirado da fila
+ */
+static void handle_button_event(const button_event_t *event) {
+    if (event->type != BUTTON_EVENT_PRESS) return;
+
+    if (fire_enabled && fire_alert_active && event->button == BUTTON_B) {
+        fire_alert_active = false;
+        set_output_pattern(OUTPUT_PATTERN_ANIMATION);
+        printf("\nAlerta de incendio cancelado pelo usuario (%lu ms apos o toque).\n",
+               (unsigned long)(to_ms_since_boot(get_absolute_time()) - event->time_ms));
+        play_tone(880, 100);
+        request_display_refresh();
+        return;
+    }
+
+    if (wildlife_enabled && wildlife_alert_active) {
+        wildlife_alert_active = false;
+        printf("\nAlerta de animal silvestre cancelado pelo usuario.\n");
+        request_display_refresh();
+        return;
     }
 
-    int active_sensors = (temp_enabled ? 1 : 0) + (flow_enabled ? 1 : 0) + (rain_enabled ? 1 : 0);
-    if (active_sensors == 0) return;
+    // Joystick: abre e fecha o histórico de alertas
+    if (event->button == BUTTON_JOY && !(fire_enabled && fire_alert_active)) {
+        if (logview_is_open()) logview_close();
+        else logview_open();
+        request_display_refresh();
+        return;
+    }
+
+    if (sensor_enabled_count() == 0) return;
+    if (event->button == BUTTON_A) {
+        current_sensor_index = sensor_next_enabled(current_sensor_index, -1);
+        request_display_refresh();
+    } else if (event->button == BUTTON_B && !fire_alert_active) {
+        current_sensor_index = sensor_next_enabled(current_sensor_index, 1);
+        request_display_refresh();
+    }
+}
+/**
+ * @brief Processa os botões e o joystick
+ *
+ * Os botões chegam como eventos já filtrados (buttons.c), inclusive os
+ * ocorridos enquanto o laço estava ocupado; o joystick é lido do ADC.
+ */
+void check_buttons() {
+    button_event_t event;
+    while (buttons_poll(&event)) {
+        handle_button_event(&event);
+    }
 
     static uint32_t last_joy_time = 0;
     uint32_t current_time = to_ms_since_boot(get_absolute_time());
+
+    // No histórico o eixo Y rola uma linha por vez (para cima: mais antigas)
+    if (logview_is_open()) {
+        uint32_t joy_y_value = analog_get(ANALOG_JOY_Y);
+        int lines = joy_y_value > ANALOG_FROM_12BIT(3000) ? -1 : joy_y_value < ANALOG_FROM_12BIT(1000) ? 1 : 0;
+        if (lines != 0 && current_time - last_joy_time > 200) {
+            last_joy_time = current_time;
+            if (logview_scroll(lines)) request_display_refresh();
+        }
+        return;
+    }
+
+    if (sensor_enabled_count() == 0) return;
     
-    adc_select_input(JOY_X_PIN - 26);
-    uint16_t joy_x_value = adc_read();
-    if (joy_x_value < 1000 && (current_time - last_joy_time > 200)) {
-        do {
-            current_sensor_index = (current_sensor_index + 2) % 3;
-        } while ((!temp_enabled && current_sensor_index == 0) ||
-                 (!flow_enabled && current_sensor_index == 1) ||
-                 (!rain_enabled && current_sensor_index == 2));
+    uint32_t joy_x_value = analog_get(ANALOG_JOY_X);
+    if (joy_x_value < ANALOG_FROM_12BIT(1000) && (current_time - last_joy_time > 200)) {
+        current_sensor_index = sensor_next_enabled(current_sensor_index, -1);
         last_joy_time = current_time;
         play_tone(440, 50);
-        display_sensor_data();
-    } else if (joy_x_value > 3000 && (current_time - last_joy_time > 200)) {
-        do {
-            current_sensor_index = (current_sensor_index + 1) % 3;
-        } while ((!temp_enabled && current_sensor_index == 0) ||
-                 (!flow_enabled && current_sensor_index == 1) ||
-                 (!rain_enabled && current_sensor_index == 2));
+        request_display_refresh();
+    } else if (joy_x_value > ANALOG_FROM_12BIT(3000) && (current_time - last_joy_time > 200)) {
+        current_sensor_index = sensor_next_enabled(current_sensor_index, 1);
         last_joy_time = current_time;
         play_tone(440, 50);
-        display_sensor_data();
+        request_display_refresh();
     }
-
-    if (!button_a_last_state && (current_time - last_joy_time > 200)) {
-        do {
-            current_sensor_index = (current_sensor_index + 2) % 3;
-        } while ((!temp_enabled && current_sensor_index == 0) ||
-                 (!flow_enabled && current_sensor_index == 1) ||
-                 (!rain_enabled && current_sensor_index == 2));
-        last_joy_time = current_time;
-        display_sensor_data();
-    }
-    if (!button_b_last_state && !fire_alert_active && (current_time - last_joy_time > 200)) {
-        do {
-            current_sensor_index = (current_sensor_index + 1) % 3;
-        } while ((!temp_enabled && current_sensor_index == 0) ||
-                 (!flow_enabled && current_sensor_index == 1) ||
-                 (!rain_enabled && current_sensor_index == 2));
-        last_joy_time = current_time;
-        display_sensor_data();
+}
+/**
+ * @brief Solicita redesenho imediato do display
+ *
+ * Marca o display como desatualizado e antecipa a tarefa de display em
+ * vez de desenhar fora dela; as solicitações feitas até o próximo quadro
+ * resultam em um único redesenho e envio.
+ */
+void request_display_refresh() {
+    display_requests++;
+    if (display_stale) display_coalesced++;
+    display_stale = true;
+    scheduler_trigger(display_task_id);
+}
+/**
+ * @brief Troca o padrão da matriz e antecipa a tarefa de saídas
+ *
+ * A tarefa dorme até o próximo evento do padrão atual; o novo padrão
+ * precisa ser aplicado já.
+ */
+void set_output_pattern(output_pattern_t pattern) {
+    outputs_set_pattern(pattern);
+    scheduler_trigger(outputs_task_id);
+}
+/**
+ * @brief Imprime quadros enviados e evitados e o tempo de barramento poupado
+ *
+ * A referência é um quadro completo por pedido ou tick, como no envio
+ * sem retenção nem comparação.
+ */
+void print_display_stats() {
+    uint32_t frames = ssd1306_get_frames();
+    uint32_t unchanged = ssd1306_get_unchanged_flushes();
+    uint64_t used_us = ssd1306_bus_time_us(ssd1306_get_total_bytes());
+    uint64_t naive_us = (uint64_t)(frames + unchanged + display_coalesced + display_idle_ticks) *
+                        ssd1306_bus_time_us(SSD1306_FULL_FRAME_BYTES);
+    printf("Quadros: %lu enviados, %lu sem alteracao, %lu ticks ociosos; pedidos %lu (%lu agrupados, %lu adiados)\n",
+           (unsigned long)frames, (unsigned long)unchanged, (unsigned long)display_idle_ticks,
+           (unsigned long)display_requests, (unsigned long)display_coalesced, (unsigned long)display_deferred);
+    printf("Barramento do display: %lu ms usados, %lu ms poupados\n", (unsigned long)(used_us / 1000),
+           (unsigned long)(naive_us > used_us ? (naive_us - used_us) / 1000 : 0));
+}
+/**
+ * @brief Imprime a ocupação do núcleo desde o relatório anterior
+ */
+void print_idle_stats() {
+    idle_stats_t stats;
+    idle_take_stats(&stats);
+    if (stats.elapsed_us == 0) return;
+    printf("CPU: %.1f%% ativa, %lu esperas, %lu despertares", 100.0 - 100.0 * (double)stats.idle_us / (double)stats.elapsed_us,
+           (unsigned long)stats.waits, (unsigned long)stats.wakeups);
+#if MONITOR_IDLE_CLOCK_SCALING
+    printf(", %.1f%% em clock reduzido", 100.0 * (double)stats.slow_us / (double)stats.elapsed_us);
+#endif
+    printf(" em %.1f s\n", (double)stats.elapsed_us / 1e6);
+}
+/**
+ * @brief Imprime execuções e prazos perdidos de cada tarefa
+ */
+void print_task_stats() {
+    printf("Tarefas:");
+    for (int i = 0; i < scheduler_task_count(); i++) {
+        const sched_task_t *task = scheduler_get_task(i);
+        printf(" %s=%lu/%lu(%lums)", task->name, (unsigned long)task->runs,
+               (unsigned long)task->missed, (unsigned long)task->max_lateness_ms);
     }
+    printf("\n");
 }
 /**
- * @brief Implementa debounce dos botões
- * 
- * Elimina ruídos e bouncing nas leituras
- * dos botões
+ * @brief Tarefa: amostragem dos sensores e detecções simuladas
  */
-void debounce_buttons() {
-    uint32_t current_time = to_ms_since_boot(get_absolute_time());
-    bool button_a_state = gpio_get(BUTTON_A_PIN);
-    if (button_a_state != button_a_last_state) {
-        last_debounce_time_a = current_time;
+static void task_sensors(uint32_t now_ms) {
+    (void)now_ms;
+    uint32_t sample_ms = to_ms_since_boot(get_absolute_time());
+    sensor_sample_all(sample_ms);
+    log_sensor_readings(sample_ms);
+    rules_evaluate(sample_ms);
+
+    detect_wildlife();
+    detect_fire();
+    check_wildlife_alerts();
+    request_display_refresh();
+}
+/**
+ * @brief Tarefa: quadro do display
+ *
+ * Único ponto de desenho e envio, para a tela atual ou para o histórico.
+ * Sem pedido pendente o tick não faz nada (exceto com o LED do alerta de
+ * animal piscando), e um pedido que não altera a tela não gera envio.
+ * Um pedido antes do intervalo mínimo entre quadros é adiado para o fim
+ * do intervalo; se o envio anterior ainda estiver saindo, o quadro
+ * continua pendente.
+ */
+static void task_display(uint32_t now_ms) {
+    static bool flush_retry = false;
+    bool blinking = wildlife_enabled && wildlife_alert_active && !(fire_enabled && fire_alert_active);
+    if (!display_stale && !blinking) {
+        display_idle_ticks++;
+        return;
     }
-    if ((current_time - last_debounce_time_a) > debounce_delay) {
-        button_a_last_state = button_a_state;
+    const uint32_t min_interval_ms = 1000 / MONITOR_DISPLAY_MAX_FPS;
+    uint32_t elapsed = now_ms - display_last_frame_ms;
+    if (display_stale && elapsed < min_interval_ms) {
+        display_deferred++;
+        scheduler_defer(display_task_id, min_interval_ms - elapsed);
+        return;
     }
-    
-    bool button_b_state = gpio_get(BUTTON_B_PIN);
-    if (button_b_state != button_b_last_state) {
-        last_debounce_time_b = current_time;
+
+    // Alertas têm prioridade sobre o histórico
+    if (logview_is_open() && ((fire_enabled && fire_alert_active) || (wildlife_enabled && wildlife_alert_active))) {
+        logview_close();
     }
-    if ((current_time - last_debounce_time_b) > debounce_delay) {
-        button_b_last_state = button_b_state;
+
+    display_stale = false;
+    int changes;
+    if (logview_is_open()) {
+        changes = logview_render();
+    } else {
+        display_sensor_data();
+        changes = ui_render();
     }
-    
-    bool joy_button_state = gpio_get(JOY_BUTTON_PIN);
-    if (joy_button_state != joy_button_last_state) {
-        last_debounce_time_joy = current_time;
+    if (changes == 0 && !flush_retry) {
+        display_idle_ticks++;  // Pedido sem efeito na tela: nada a enviar
+        return;
     }
-    if ((current_time - last_debounce_time_joy) > debounce_delay) {
-        joy_button_last_state = joy_button_state;
+    display_last_frame_ms = now_ms;
+    flush_retry = !ssd1306_flush_async();
+    display_stale = flush_retry;
+}
+/**
+ * @brief Tarefa: relatório serial
+ */
+static void task_serial(uint32_t now_ms) {
+    (void)now_ms;
+    if (telemetry_get_mode() == TELEMETRY_MODE_BINARY) {
+        send_serial_binary();
+    } else {
+        PROFILE_BEGIN(start_us);
+        send_serial_data();
+        PROFILE_END(PROFILE_SERIAL, start_us);
     }
 }
+#if !MONITOR_DUAL_CORE
+/**
+ * @brief Tarefa: animação da matriz e padrão SOS (núcleo único)
+ *
+ * Com MONITOR_DUAL_CORE essas saídas são executadas pelo núcleo 1. A
+ * próxima execução é marcada para o próximo quadro ou borda do padrão,
+ * de modo que com a matriz parada o núcleo não acorda à toa.
+ */
+static void task_outputs(uint32_t now_ms) {
+    scheduler_defer(outputs_task_id, outputs_poll(now_ms));
+}
+#endif
+/**
+ * @brief Tarefa: envia o log da flash em lotes, sem travar as demais tarefas
+ *
+ * Desativa-se ao chegar ao fim do log.
+ */
+static void task_logdump(uint32_t now_ms) {
+    (void)now_ms;
+    flashlog_record_t record;
+    uint16_t boot;
+    for (int i = 0; i < FLASHLOG_DUMP_BATCH; i++) {
+        if (!flashlog_cursor_next(&logdump_cursor, &record, &boot)) {
+            printf("LOG,fim,%lu registros\n", (unsigned long)flashlog_record_count());
+            scheduler_set_enabled(logdump_task_id, false);
+            return;
+        }
+        printf("LOG,%u,%lu,%s,%d,%.2f,%u\n", boot, (unsigned long)record.timestamp_ms,
+               record.type == FLASHLOG_EVENT ? "evento" : "leitura",
+               record.sensor == FLASHLOG_NO_SENSOR ? -1 : record.sensor,
+               fix_to_float(record.value), record.flags);
+    }
+}
+#if MONITOR_PROFILE
+/**
+ * @brief Tarefa: relatório dos histogramas de tempo, ativada pelo comando 'p'
+ */
+static void task_profile(uint32_t now_ms) {
+    printf("PERF,t,%lu\n", (unsigned long)now_ms);
+    profile_dump();
+}
+#endif
+/**
+ * @brief Tarefa: leitura de botões, joystick e comandos seriais
+ */
+static void task_input(uint32_t now_ms) {
+    (void)now_ms;
+    check_buttons();
+    check_serial_commands();
+}
 /**
  * @brief Função principal do sistema
  * 
@@ -1062,6 +1310,17 @@ void debounce_buttons() {
 int main() {
     init_hardware();
     init_sensors();
+
+#ifdef MONITOR_BENCHMARK
+    // Antes das regras: sem ouvinte, as amostras medidas não marcam regras
+    // dos sensores reais nem entram no tempo medido
+    bench_header();
+    run_text_benchmark();
+    bench_run_modules();
+#endif
+
+    init_rules();
+    uint32_t log_sectors = flashlog_init(flashlog_flash_storage());
     
     ssd1306_clear();
     draw_string(10, 20, "INICIANDO", false);
@@ -1094,33 +1353,39 @@ int main() {
     draw_string(20, 20, "WILDLIFE", false);
     ssd1306_update();
     sleep_ms(5000);
+    ui_invalidate();  // Telas de abertura desenhadas fora da UI
 
     srand(time(NULL));
     printf("Iniciando Simulador de Monitoramento Ambiental BitDogLab...\n");
     if (wildlife_enabled) printf("Módulo de detecção de animais silvestres ativado\n");
     if (fire_enabled) printf("Módulo de detecção de incendio ativado\n");
+    ssd1306_bus_info_t bus;
+    ssd1306_get_bus_info(&bus);
+    printf("Display: I2C a %lu kHz%s, inicializado em %lu us (%lu transacoes, %lu bytes, ~%lu us no barramento)\n",
+           (unsigned long)(bus.bus_hz / 1000), bus.fallbacks ? " (recuo de 1 MHz)" : "",
+           (unsigned long)bus.init_us, (unsigned long)bus.init_transactions, (unsigned long)bus.init_bytes,
+           (unsigned long)ssd1306_bus_time_us(bus.init_bytes));
+    printf("Log na flash: %lu setores, %lu registros (boot %u)\n", (unsigned long)log_sectors,
+           (unsigned long)flashlog_record_count(), flashlog_boot_id());
 
-    while (true) {
-        if (temp_enabled) update_sensor_value(&sensors[0]);
-        if (flow_enabled) update_sensor_value(&sensors[1]);
-        if (rain_enabled) update_sensor_value(&sensors[2]);
-        
-        detect_wildlife();
-        detect_fire();
-        
-        check_wildlife_alerts();
-        check_buttons();
-        
-        if (fire_enabled && fire_alert_active) {
-            update_sos_alert();
-        } else {
-            update_neopixel_bars();
-        }
-        
-        display_sensor_data();
-        send_serial_data();
-        sleep_ms(100);
-    }
+    // Cada atividade do antigo laço vira uma tarefa com período e prazo próprios
+    input_task_id = scheduler_add_task("entrada", task_input, TASK_INPUT_PERIOD_MS, TASK_INPUT_DEADLINE_MS);
+    buttons_set_notify(buttons_notify);
+#if !MONITOR_DUAL_CORE
+    outputs_task_id = scheduler_add_task("saidas", task_outputs, TASK_OUTPUTS_PERIOD_MS, TASK_OUTPUTS_DEADLINE_MS);
+#endif
+    scheduler_add_task("sensores", task_sensors, TASK_SENSORS_PERIOD_MS, 0);
+    display_task_id = scheduler_add_task("display", task_display, TASK_DISPLAY_PERIOD_MS, TASK_DISPLAY_DEADLINE_MS);
+    scheduler_add_task("serial", task_serial, TASK_SERIAL_PERIOD_MS, 0);
+    logdump_task_id = scheduler_add_task("logdump", task_logdump, TASK_LOGDUMP_PERIOD_MS, 0);
+    scheduler_set_enabled(logdump_task_id, false);
+#if MONITOR_PROFILE
+    profile_task_id = scheduler_add_task("perfil", task_profile, TASK_PROFILE_PERIOD_MS, 0);
+    scheduler_set_enabled(profile_task_id, false);
+#endif
+
+    set_output_pattern(OUTPUT_PATTERN_ANIMATION);
+    scheduler_run();
     
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+/**
+ * @file neopixel.c
+ * @brief Driver da matriz de NeoPixels (WS2812B) com envio por DMA
+ *
+ * O programa PIO consome os 24 bits mais altos de cada palavra, então o
+ * envio converte o buffer de trás (GRB nos bits 0-23) para um buffer de
+ * transmissão deslocado, que é lido pela DMA. O buffer de transmissão é
+ * também o registro do que a matriz exibe e serve para descartar quadros
+ * repetidos. A duração do quadro no fio é determinística, e o fim do
+ * latch é calculado a partir do instante de início da transferência.
+ */
+#include "neopixel.h"
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/pio.h"
+#include "monitor.pio.h"
+#include "profile.h"
+
+static int dma_channel = -1;
+
+static uint32_t back[NUM_PIXELS];          ///< Quadro em desenho (GRB)
+static uint32_t wire[NUM_PIXELS];          ///< Quadro enviado (GRB << 8), lido pela DMA
+static bool wire_valid = false;            ///< false: conteúdo da matriz desconhecido
+static uint64_t ready_at_us = 0;           ///< Fim da transmissão + latch do último quadro
+
+static uint32_t frames_sent = 0;
+static uint32_t frames_skipped = 0;
+
+/**
+ * @brief Inicializa o programa PIO e o canal DMA da matriz
+ */
+void neopixel_init(PIO pio, uint sm, uint pin) {
+    uint offset = pio_add_program(pio, &monitor_program);
+    monitor_program_init(pio, sm, offset, pin);
+
+    dma_channel = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dma_channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(dma_channel, &c, &pio->txf[sm], wire, NUM_PIXELS, false);
+
+    // Limpa todos os pixels inicialmente
+    neopixel_fill(0);
+    neopixel_present();
+    neopixel_wait();
+}
+/**
+ * @brief Buffer de trás, em que o próximo quadro é desenhado
+ */
+uint32_t *neopixel_frame() {
+    return back;
+}
+/**
+ * @brief Preenche o buffer de trás com uma única cor
+ */
+void neopixel_fill(uint32_t color) {
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        back[i] = color;
+    }
+}
+/**
+ * @brief Verifica se um quadro está em transmissão ou aguardando latch
+ */
+bool neopixel_busy() {
+    return dma_channel_is_busy(dma_channel) || time_us_64() < ready_at_us;
+}
+/**
+ * @brief Aguarda o fim da transmissão e do latch do quadro atual
+ */
+void neopixel_wait() {
+    while (neopixel_busy()) {
+        tight_loop_contents();
+    }
+}
+/**
+ * @brief Inicia o envio assíncrono do buffer de trás
+ *
+ * A comparação com o último quadro é feita antes da verificação de
+ * ocupado, para que um quadro repetido nunca precise ser reenviado.
+ */
+bool neopixel_present() {
+    if (wire_valid) {
+        bool changed = false;
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            if ((back[i] << 8u) != wire[i]) {
+                changed = true;
+                break;
+            }
+        }
+        if (!changed) {
+            frames_skipped++;
+            return true;
+        }
+    }
+    if (neopixel_busy()) return false;
+
+    PROFILE_BEGIN(start_us);
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        wire[i] = back[i] << 8u;
+    }
+    wire_valid = true;
+    ready_at_us = time_us_64() + NUM_PIXELS * NEOPIXEL_PIXEL_US + NEOPIXEL_RESET_US;
+    dma_channel_transfer_from_buffer_now(dma_channel, wire, NUM_PIXELS);
+    frames_sent++;
+    PROFILE_END(PROFILE_NEOPIXEL, start_us);
+    return true;
+}
+/**
+ * @brief Quantidade de quadros enviados à matriz
+ */
+uint32_t neopixel_get_frames_sent() {
+    return frames_sent;
+}
+/**
+ * @brief Quantidade de quadros descartados por serem iguais ao anterior
+ */
+uint32_t neopixel_get_frames_skipped() {
+    return frames_skipped;
+}
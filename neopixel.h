@@ -0,0 +1,85 @@
+/**
+ * @file neopixel.h
+ * @brief Driver da matriz de NeoPixels (WS2812B) com envio por DMA
+ *
+ * O quadro é desenhado em um buffer de trás (cores GRB, uma palavra por
+ * LED) e neopixel_present() dispara uma transferência DMA para a FIFO de
+ * TX da máquina de estados do programa monitor.pio, retornando em
+ * seguida. O driver respeita sozinho o intervalo de reset (latch) entre
+ * quadros e não reenvia quadros idênticos ao último enviado.
+ */
+#ifndef NEOPIXEL_H
+#define NEOPIXEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+#define NUM_PIXELS 25         ///< Número total de NeoPixels
+
+/**
+ * @brief Tempo de transmissão de um LED (us)
+ *
+ * 24 bits a 1,25 us (PIO a 8 MHz, 10 ciclos por bit).
+ */
+#define NEOPIXEL_PIXEL_US 30
+
+/** Tempo mínimo em nível baixo para travar o quadro (us) */
+#define NEOPIXEL_RESET_US 300
+
+/**
+ * @brief Inicializa o programa PIO e o canal DMA da matriz
+ *
+ * Envia um quadro apagado e aguarda o seu latch.
+ * @param pio Bloco PIO
+ * @param sm Máquina de estados
+ * @param pin Pino de dados
+ */
+void neopixel_init(PIO pio, uint sm, uint pin);
+
+/**
+ * @brief Buffer de trás, em que o próximo quadro é desenhado
+ *
+ * Mantém o conteúdo entre envios; cores no formato GRB (bits 0-23).
+ * @return Vetor de NUM_PIXELS cores
+ */
+uint32_t *neopixel_frame(void);
+
+/**
+ * @brief Preenche o buffer de trás com uma única cor
+ * @param color Cor GRB
+ */
+void neopixel_fill(uint32_t color);
+
+/**
+ * @brief Inicia o envio assíncrono do buffer de trás
+ *
+ * Retorna imediatamente. Quadros iguais ao último enviado são
+ * descartados e contam como sucesso.
+ * @return false se o quadro anterior ainda estiver em transmissão ou
+ *         dentro do intervalo de latch (tente de novo mais tarde)
+ */
+bool neopixel_present(void);
+
+/**
+ * @brief Verifica se um quadro está em transmissão ou aguardando latch
+ */
+bool neopixel_busy(void);
+
+/**
+ * @brief Aguarda o fim da transmissão e do latch do quadro atual
+ */
+void neopixel_wait(void);
+
+/**
+ * @brief Quantidade de quadros enviados à matriz
+ */
+uint32_t neopixel_get_frames_sent(void);
+
+/**
+ * @brief Quantidade de quadros descartados por serem iguais ao anterior
+ */
+uint32_t neopixel_get_frames_skipped(void);
+
+#endif // NEOPIXEL_H
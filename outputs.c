@@ -0,0 +1,420 @@
+/**
+ * @file outputs.c
+ * @brief Saídas de sinalização: matriz de NeoPixels, buzzer e LED RGB
+ *
+ * As rotinas de execução (exec_*) são as mesmas nos dois modos. No modo
+ * de núcleo único elas são chamadas diretamente pelo núcleo 0; com
+ * MONITOR_DUAL_CORE o núcleo 0 codifica cada chamada em uma palavra de
+ * 32 bits, coloca-a numa fila SPSC em RAM compartilhada e acorda o
+ * núcleo 1 com __sev(). A fila não usa a FIFO do SIO, que fica livre para
+ * o bloqueio do núcleo 1 durante gravações na flash.
+ *
+ * O buzzer é controlado pelo motor de áudio (audio.c), cujo alarme é
+ * criado no núcleo dono das saídas; o SOS apenas enfileira um tom com
+ * prioridade máxima a cada trecho aceso.
+ */
+#include "outputs.h"
+#include "audio.h"
+#include "neopixel.h"
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/pio.h"
+#include "hardware/sync.h"
+#if MONITOR_DUAL_CORE
+#include "pico/multicore.h"
+#include "pico/flash.h"
+#endif
+
+// PIO para NeoPixels
+static PIO pio = pio0;
+static uint sm = 0;
+
+// Constantes para animação do gráfico
+static const uint8_t graphic_frames[4][5][5] = {
+    {
+        {1, 2, 3, 2, 1},
+        {0, 1, 2, 1, 0},
+        {0, 0, 1, 0, 0},
+        {0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0}
+    },
+    {
+        {1, 2, 3, 2, 1},
+        {1, 2, 3, 2, 1},
+        {0, 1, 2, 1, 0},
+        {0, 0, 1, 0, 0},
+        {0, 0, 0, 0, 0}
+    },
+    {
+        {1, 2, 3, 2, 1},
+        {1, 2, 3, 2, 1},
+        {1, 2, 3, 2, 1},
+        {0, 1, 2, 1, 0},
+        {0, 0, 1, 0, 0}
+    },
+    {
+        {1, 2, 3, 2, 1},
+        {1, 2, 3, 2, 1},
+        {1, 2, 3, 2, 1},
+        {1, 2, 3, 2, 0},
+        {0, 1, 0, 1, 0}
+    }
+};
+
+/**
+ * @brief Trechos acesos do SOS no ciclo de SOS_CYCLE_MS
+ *
+ * S: 3 pontos (200ms ON, 200ms OFF) -> 0-1000
+ * O: 3 traços (600ms ON, 200ms OFF) -> 1600-3800
+ * S: 3 pontos (200ms ON, 200ms OFF) -> 4400-5400
+ */
+static const uint16_t sos_on_intervals[][2] = {
+    {0, 200}, {400, 600}, {800, 1000},
+    {1600, 2200}, {2400, 3000}, {3200, 3800},
+    {4400, 4600}, {4800, 5000}, {5200, 5400}
+};
+#define SOS_CYCLE_MS 5400
+#define SOS_NUM_INTERVALS (sizeof(sos_on_intervals) / sizeof(sos_on_intervals[0]))
+
+/** Espera máxima do núcleo 1 sem eventos pendentes (ms) */
+#define OUTPUT_IDLE_WAIT_MS 1000
+
+// Estado do executor (pertence a quem controla as saídas)
+static output_pattern_t pattern = OUTPUT_PATTERN_OFF;
+static bool pattern_changed = false;
+static uint32_t last_animation_ms = 0;
+static int animation_frame = 0;
+static int sos_state = -1;          ///< -1 força a reaplicação das saídas
+static bool pixels_pending = false; ///< Quadro aguardando o fim do envio anterior
+
+/**
+ * @brief Converte valores RGB para formato GRB dos NeoPixels
+ *
+ * @param r Valor do componente vermelho (0-255)
+ * @param g Valor do componente verde (0-255)
+ * @param b Valor do componente azul (0-255)
+ * @return uint32_t Valor formatado para NeoPixel (GRB)
+ */
+static inline uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)(r) << 16) | ((uint32_t)(g) << 8) | (uint32_t)(b); // GRB
+}
+/**
+ * @brief Envia o buffer de trás da matriz
+ *
+ * Se o quadro anterior ainda estiver em transmissão, o envio fica
+ * pendente e é repetido na próxima execução de exec_pattern().
+ */
+static void present_frame(void) {
+    pixels_pending = !neopixel_present();
+}
+/**
+ * @brief Preenche a matriz com uma única cor
+ * @param color Cor GRB
+ */
+static void fill_frame(uint32_t color) {
+    neopixel_fill(color);
+    present_frame();
+}
+
+// Função auxiliar para mapear coordenadas x,y para o índice do LED na matriz
+/**
+ * @brief Converte coordenadas x,y para índice do LED na matriz
+ *
+ * @param x Coordenada X (0-4)
+ * @param y Coordenada Y (0-4)
+ * @return int Índice do LED na matriz
+ */
+static int xy_to_pixel_index(int x, int y) {
+    if (y % 2 == 0) {
+        // Linhas pares: da esquerda para a direita
+        return y * 5 + x;
+    } else {
+        // Linhas ímpares: da direita para a esquerda
+        return y * 5 + (4 - x);
+    }
+}
+/**
+ * @brief Desenha um quadro da animação de chamas
+ * @param frame Índice do quadro (0-3)
+ */
+static void update_graphic_animation(uint8_t frame) {
+    // Desenha direto no buffer de trás do driver
+    uint32_t *pixels = neopixel_frame();
+
+    // Preenche o array com as cores da animação
+    for (int y = 0; y < 5; y++) {
+        for (int x = 0; x < 5; x++) {
+            int pixel_index = xy_to_pixel_index(x, y);
+            uint8_t intensity = graphic_frames[frame][y][x];
+
+            uint8_t r = 0, g = 0, b = 0;
+            switch (intensity) {
+                case 0: // Desligado
+                    break;
+                case 1: // Vermelho escuro
+                    r = 6;
+                    break;
+                case 2: // Laranja
+                    g = 0;
+                    b = 10;
+                    break;
+                case 3: // Amarelo
+                    g = 0;
+                    b = 10;
+                    break;
+            }
+
+            // Formato GRB para NeoPixels
+            pixels[pixel_index] = ((uint32_t)g << 16) | ((uint32_t)r << 8) | b;
+        }
+    }
+
+    present_frame();
+}
+/**
+ * @brief Verifica se o SOS está aceso em um instante do ciclo
+ * @param t Instante dentro do ciclo (0 a SOS_CYCLE_MS - 1)
+ */
+static bool sos_is_on(uint32_t t) {
+    for (uint i = 0; i < SOS_NUM_INTERVALS; i++) {
+        if (t >= sos_on_intervals[i][0] && t < sos_on_intervals[i][1]) return true;
+    }
+    return false;
+}
+/**
+ * @brief Tempo até a próxima borda do padrão SOS
+ * @param t Instante dentro do ciclo
+ * @return ms até a próxima troca de estado (ou fim do ciclo)
+ */
+static uint32_t sos_time_to_edge(uint32_t t) {
+    for (uint i = 0; i < SOS_NUM_INTERVALS; i++) {
+        if (t < sos_on_intervals[i][0]) return sos_on_intervals[i][0] - t;
+        if (t < sos_on_intervals[i][1]) return sos_on_intervals[i][1] - t;
+    }
+    return SOS_CYCLE_MS - t;
+}
+/**
+ * @brief Avança o padrão atual da matriz
+ *
+ * A animação avança um quadro a cada OUTPUT_ANIMATION_PERIOD_MS; o SOS
+ * atualiza LED vermelho e matriz apenas nas bordas do padrão e, em cada
+ * trecho aceso, enfileira um tom que dura até a próxima borda.
+ *
+ * @param now Instante atual (ms desde o boot)
+ * @return ms até o próximo evento do padrão
+ */
+static uint32_t exec_pattern_step(uint32_t now) {
+    if (pixels_pending) present_frame();
+
+    if (pattern_changed) {
+        pattern_changed = false;
+        // Saída do SOS ou matriz desligada: apaga LED vermelho, buzzer e matriz
+        if (pattern != OUTPUT_PATTERN_SOS) {
+            gpio_put(LED_R_PIN, 0);
+            audio_cancel(AUDIO_PRIO_SOS);
+            fill_frame(0);
+        }
+        sos_state = -1;
+        last_animation_ms = now - OUTPUT_ANIMATION_PERIOD_MS;
+    }
+
+    switch (pattern) {
+        case OUTPUT_PATTERN_ANIMATION: {
+            uint32_t elapsed = now - last_animation_ms;
+            if (elapsed >= OUTPUT_ANIMATION_PERIOD_MS) {
+                animation_frame = (animation_frame + 1) % 4;
+                update_graphic_animation(animation_frame);
+                last_animation_ms = now;
+                return OUTPUT_ANIMATION_PERIOD_MS;
+            }
+            return OUTPUT_ANIMATION_PERIOD_MS - elapsed;
+        }
+        case OUTPUT_PATTERN_SOS: {
+            uint32_t t = now % SOS_CYCLE_MS;
+            int on = sos_is_on(t) ? 1 : 0;
+            if (on != sos_state) {
+                sos_state = on;
+                gpio_put(LED_R_PIN, on);
+                fill_frame(on ? urgb_u32(0, 255, 0) : 0); // Vermelho em GRB
+                if (on) {
+                    audio_tone(OUTPUT_SOS_TONE_HZ, sos_time_to_edge(t),
+                               AUDIO_DUTY_DEFAULT, AUDIO_PRIO_SOS);
+                }
+            }
+            return sos_time_to_edge(t);
+        }
+        default:
+            return OUTPUT_IDLE_WAIT_MS;
+    }
+}
+/**
+ * @brief Executa o padrão atual da matriz
+ *
+ * @param now Instante atual (ms desde o boot)
+ * @return ms até o próximo evento do padrão
+ */
+static uint32_t exec_pattern(uint32_t now) {
+    uint32_t wait = exec_pattern_step(now);
+    // Quadro recusado pelo driver: tenta de novo após o latch
+    if (pixels_pending && wait > 1) wait = 1;
+    return wait;
+}
+/**
+ * @brief Aplica o estado do LED RGB
+ */
+static void exec_rgb(bool r, bool g, bool b) {
+    gpio_put(LED_R_PIN, r);
+    gpio_put(LED_G_PIN, g);
+    gpio_put(LED_B_PIN, b);
+}
+#if MONITOR_DUAL_CORE
+/**
+ * @brief Comandos enviados ao núcleo 1 (bits 31-28 de cada palavra)
+ */
+enum {
+    OUTPUT_CMD_PATTERN = 1,  ///< bits 0-3: output_pattern_t
+    OUTPUT_CMD_RGB = 2       ///< bit 2: R, bit 1: G, bit 0: B
+};
+#define OUTPUT_CMD(op, arg) (((uint32_t)(op) << 28) | ((arg) & 0x0FFFFFFFu))
+
+/** Fila SPSC núcleo 0 -> núcleo 1 (tamanho potência de 2) */
+#define OUTPUT_QUEUE_SIZE 32
+static volatile uint32_t cmd_queue[OUTPUT_QUEUE_SIZE];
+static volatile uint32_t cmd_head = 0;  ///< Escrito apenas pelo núcleo 0
+static volatile uint32_t cmd_tail = 0;  ///< Escrito apenas pelo núcleo 1
+
+/** Sinalizado pelo núcleo 1 após criar o alarme do motor de áudio */
+static volatile bool core1_ready = false;
+
+/**
+ * @brief Envia um comando ao núcleo 1
+ *
+ * Se a fila estiver cheia, aguarda o núcleo 1 consumir (ele drena a fila
+ * a cada despertar, então a espera é curta).
+ */
+static void queue_push(uint32_t cmd) {
+    uint32_t head = cmd_head;
+    uint32_t next = (head + 1) % OUTPUT_QUEUE_SIZE;
+    while (next == cmd_tail) {
+        tight_loop_contents();
+    }
+    cmd_queue[head] = cmd;
+    __dmb();
+    cmd_head = next;
+    __sev();
+}
+/**
+ * @brief Retira um comando da fila (núcleo 1)
+ * @return false se a fila estiver vazia
+ */
+static bool queue_pop(uint32_t *cmd) {
+    uint32_t tail = cmd_tail;
+    if (tail == cmd_head) return false;
+    __dmb();
+    *cmd = cmd_queue[tail];
+    __dmb();
+    cmd_tail = (tail + 1) % OUTPUT_QUEUE_SIZE;
+    return true;
+}
+/**
+ * @brief Executa um comando recebido do núcleo 0
+ */
+static void execute_command(uint32_t cmd) {
+    uint32_t arg = cmd & 0x0FFFFFFFu;
+    switch (cmd >> 28) {
+        case OUTPUT_CMD_PATTERN:
+            if ((output_pattern_t)arg != pattern) {
+                pattern = (output_pattern_t)arg;
+                pattern_changed = true;
+            }
+            break;
+        case OUTPUT_CMD_RGB:
+            exec_rgb(arg & 4, arg & 2, arg & 1);
+            break;
+    }
+}
+/**
+ * @brief Laço do núcleo 1: comandos e padrão da matriz
+ *
+ * Dorme em WFE até o próximo evento; um comando novo acorda o núcleo
+ * pelo __sev() de queue_push. Os tons são tocados pelo alarme do motor
+ * de áudio, cujo IRQ fica habilitado neste núcleo.
+ */
+static void core1_main(void) {
+    audio_init(BUZZER_PIN);
+    flash_safe_execute_core_init();  // Permite ao núcleo 0 pausar este núcleo ao gravar o log
+    core1_ready = true;
+    __sev();
+
+    while (true) {
+        uint32_t cmd;
+        while (queue_pop(&cmd)) {
+            execute_command(cmd);
+        }
+
+        uint32_t now = to_ms_since_boot(get_absolute_time());
+        uint32_t wait = exec_pattern(now);
+
+        if (wait > 0 && cmd_tail == cmd_head) {
+            best_effort_wfe_or_timeout(make_timeout_time_ms(wait));
+        }
+    }
+}
+#endif
+/**
+ * @brief Inicializa LED RGB, motor de áudio e PIO dos NeoPixels
+ */
+void outputs_init() {
+    gpio_init(LED_R_PIN);
+    gpio_init(LED_G_PIN);
+    gpio_init(LED_B_PIN);
+    gpio_set_dir(LED_R_PIN, GPIO_OUT);
+    gpio_set_dir(LED_G_PIN, GPIO_OUT);
+    gpio_set_dir(LED_B_PIN, GPIO_OUT);
+    exec_rgb(false, false, true);
+    neopixel_init(pio, sm, OUT_PIN);
+
+#if MONITOR_DUAL_CORE
+    // A partir daqui PIO, PWM e LED RGB pertencem ao núcleo 1
+    multicore_launch_core1(core1_main);
+    while (!core1_ready) {
+        __wfe();
+    }
+#else
+    audio_init(BUZZER_PIN);
+#endif
+}
+/**
+ * @brief Seleciona o padrão da matriz
+ */
+void outputs_set_pattern(output_pattern_t new_pattern) {
+#if MONITOR_DUAL_CORE
+    queue_push(OUTPUT_CMD(OUTPUT_CMD_PATTERN, new_pattern));
+#else
+    if (new_pattern != pattern) {
+        pattern = new_pattern;
+        pattern_changed = true;
+    }
+#endif
+}
+/**
+ * @brief Define o estado do LED RGB
+ */
+void outputs_set_rgb(bool r, bool g, bool b) {
+#if MONITOR_DUAL_CORE
+    queue_push(OUTPUT_CMD(OUTPUT_CMD_RGB, (r ? 4 : 0) | (g ? 2 : 0) | (b ? 1 : 0)));
+#else
+    exec_rgb(r, g, b);
+#endif
+}
+/**
+ * @brief Avança o padrão da matriz (modo de núcleo único)
+ */
+uint32_t outputs_poll(uint32_t now_ms) {
+#if !MONITOR_DUAL_CORE
+    return exec_pattern(now_ms);
+#else
+    (void)now_ms;
+    return OUTPUT_IDLE_WAIT_MS;
+#endif
+}
@@ -0,0 +1,81 @@
+/**
+ * @file outputs.h
+ * @brief Saídas de sinalização: matriz de NeoPixels, buzzer e LED RGB
+ *
+ * Concentra o acesso ao PIO dos NeoPixels, ao buzzer (via motor de áudio)
+ * e ao LED RGB.
+ * Com MONITOR_DUAL_CORE as saídas pertencem ao núcleo 1: o núcleo 0 apenas
+ * envia comandos curtos (padrão, cor) por uma fila SPSC sem travas,
+ * e a temporização do SOS não depende do que o núcleo 0 estiver fazendo.
+ * Sem a opção, as mesmas rotinas executam no núcleo 0 via outputs_poll().
+ */
+#ifndef OUTPUTS_H
+#define OUTPUTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "neopixel.h"
+
+/**
+ * @brief Definições de pinos das saídas
+ */
+#define LED_R_PIN 13          ///< Pino do LED vermelho
+#define LED_G_PIN 11          ///< Pino do LED verde
+#define LED_B_PIN 12          ///< Pino do LED azul
+#define BUZZER_PIN 10         ///< Pino do buzzer
+#define OUT_PIN 7             ///< Pino de dados dos NeoPixels
+
+#ifndef MONITOR_DUAL_CORE
+#define MONITOR_DUAL_CORE 0   ///< 1 = saídas executadas no núcleo 1
+#endif
+
+/** Intervalo entre quadros da animação da matriz (ms) */
+#define OUTPUT_ANIMATION_PERIOD_MS 200
+
+/** Frequência do buzzer durante o SOS (Hz) */
+#define OUTPUT_SOS_TONE_HZ 650
+
+/**
+ * @brief Padrões exibidos na matriz de NeoPixels
+ */
+typedef enum {
+    OUTPUT_PATTERN_OFF = 0,     ///< Matriz apagada
+    OUTPUT_PATTERN_ANIMATION,   ///< Animação de chamas/barras
+    OUTPUT_PATTERN_SOS          ///< SOS em Morse na matriz, LED vermelho e buzzer
+} output_pattern_t;
+
+/**
+ * @brief Inicializa LED RGB, motor de áudio e PIO dos NeoPixels
+ *
+ * Com MONITOR_DUAL_CORE, inicia também o núcleo 1, que passa a hospedar
+ * o alarme do motor de áudio.
+ */
+void outputs_init(void);
+
+/**
+ * @brief Seleciona o padrão da matriz
+ * @param pattern Novo padrão
+ */
+void outputs_set_pattern(output_pattern_t pattern);
+
+/**
+ * @brief Define o estado do LED RGB
+ * @param r LED vermelho aceso
+ * @param g LED verde aceso
+ * @param b LED azul aceso
+ */
+void outputs_set_rgb(bool r, bool g, bool b);
+
+/**
+ * @brief Avança o padrão da matriz (modo de núcleo único)
+ *
+ * Chamada pelo escalonador; sem efeito com MONITOR_DUAL_CORE, em que o
+ * núcleo 1 faz esse trabalho. Após outputs_set_pattern() deve ser
+ * chamada de novo sem esperar o intervalo retornado.
+ * @param now_ms Instante atual (ms desde o boot)
+ * @return ms até o próximo quadro ou borda do padrão
+ */
+uint32_t outputs_poll(uint32_t now_ms);
+
+#endif // OUTPUTS_H
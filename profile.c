@@ -0,0 +1,97 @@
+/**
+ * @file profile.c
+ * @brief Histogramas de tempo das fases do laço principal (MONITOR_PROFILE)
+ *
+ * O balde de uma duração v sai dos dois bits seguintes ao bit mais
+ * significativo: índice = 4 + 4·(oitava − 2) + sub, sem divisões nem
+ * laços. Os percentis são o limite superior do balde que contém a
+ * posição pedida, recortado ao mínimo e ao máximo exatos.
+ */
+#include "profile.h"
+#include <stdio.h>
+
+/**
+ * @brief Histograma de uma fase
+ */
+typedef struct {
+    uint32_t count;                     ///< Amostras registradas
+    uint32_t min_us;                    ///< Menor duração
+    uint32_t max_us;                    ///< Maior duração
+    uint32_t buckets[PROFILE_BUCKETS];  ///< Amostras por balde
+} profile_hist_t;
+
+static profile_hist_t hists[PROFILE_NUM_PHASES];
+
+static const char *const phase_names[PROFILE_TASK_BASE] = {
+    [PROFILE_IDLE] = "ocioso",
+    [PROFILE_DISPLAY_UPDATE] = "ssd1306_update",
+    [PROFILE_DISPLAY_FLUSH] = "ssd1306_flush",
+    [PROFILE_NEOPIXEL] = "neopixel",
+    [PROFILE_AUDIO_QUEUE] = "audio_fila",
+    [PROFILE_AUDIO_IRQ] = "audio_irq",
+    [PROFILE_SERIAL] = "serial",
+    [PROFILE_FLASH] = "flash",
+};
+
+static inline uint32_t bucket_of(uint32_t us) {
+    if (us < 4) return us;
+    uint32_t octave = 31u - (uint32_t)__builtin_clz(us);
+    uint32_t index = 4 + (octave - 2) * 4 + ((us >> (octave - 2)) & 3);
+    return index < PROFILE_BUCKETS ? index : PROFILE_BUCKETS - 1;
+}
+/**
+ * @brief Maior duração que cai no balde
+ */
+static uint32_t bucket_upper(uint32_t index) {
+    if (index < 4) return index;
+    uint32_t octave = (index - 4) / 4 + 2;
+    uint32_t sub = (index - 4) % 4;
+    return ((5 + sub) << (octave - 2)) - 1;
+}
+/**
+ * @brief Percentil a partir dos baldes
+ * @param permille Posição em milésimos (500 = mediana)
+ */
+static uint32_t percentile(const profile_hist_t *h, uint32_t permille) {
+    uint32_t rank = (uint32_t)(((uint64_t)h->count * permille + 999) / 1000);
+    if (rank == 0) rank = 1;
+    uint32_t seen = 0;
+    for (uint32_t i = 0; i < PROFILE_BUCKETS; i++) {
+        seen += h->buckets[i];
+        if (seen >= rank) {
+            uint32_t value = bucket_upper(i);
+            if (value > h->max_us) value = h->max_us;
+            if (value < h->min_us) value = h->min_us;
+            return value;
+        }
+    }
+    return h->max_us;
+}
+void profile_record(int phase, uint32_t us) {
+    if (phase < 0 || phase >= PROFILE_NUM_PHASES) return;
+    profile_hist_t *h = &hists[phase];
+    if (h->count == 0 || us < h->min_us) h->min_us = us;
+    if (us > h->max_us) h->max_us = us;
+    h->buckets[bucket_of(us)]++;
+    h->count++;
+}
+void profile_dump(void) {
+    for (int phase = 0; phase < PROFILE_NUM_PHASES; phase++) {
+        const profile_hist_t *h = &hists[phase];
+        if (h->count == 0) continue;
+        if (phase < PROFILE_TASK_BASE) {
+            printf("PERF,%s", phase_names[phase]);
+        } else {
+            const sched_task_t *task = scheduler_get_task(phase - PROFILE_TASK_BASE);
+            printf("PERF,tarefa:%s", task ? task->name : "?");
+        }
+        printf(",%lu,%lu,%lu,%lu,%lu\n", (unsigned long)h->count, (unsigned long)h->min_us,
+               (unsigned long)percentile(h, 500), (unsigned long)percentile(h, 990),
+               (unsigned long)h->max_us);
+    }
+}
+void profile_reset(void) {
+    for (int phase = 0; phase < PROFILE_NUM_PHASES; phase++) {
+        hists[phase] = (profile_hist_t){0};
+    }
+}
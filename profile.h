@@ -0,0 +1,93 @@
+/**
+ * @file profile.h
+ * @brief Histogramas de tempo das fases do laço principal (MONITOR_PROFILE)
+ *
+ * Cada fase (tarefa do escalonador ou ponto de entrada de driver) tem um
+ * histograma de memória fixa com resolução de 1 us: baldes logarítmicos
+ * com 4 subdivisões por oitava (erro relativo abaixo de 25%), além de
+ * contagem, mínimo e máximo exatos. Sem MONITOR_PROFILE as macros não
+ * geram código e profile.c não é compilado.
+ *
+ * Um histograma é escrito por um único contexto (tarefa, núcleo ou
+ * interrupção); o relatório lê sem travas e pode ver uma amostra pela
+ * metade, o que é aceitável para estatísticas. A exceção é audio_fila
+ * com MONITOR_DUAL_CORE, alimentada pelos dois núcleos: uma contagem
+ * pode se perder em escritas simultâneas.
+ */
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "scheduler.h"
+
+#ifndef MONITOR_PROFILE
+#define MONITOR_PROFILE 0   ///< 1 = instrumentação de tempo compilada
+#endif
+
+/**
+ * @brief Fases medidas
+ *
+ * As tarefas do escalonador ocupam PROFILE_TASK_BASE + id.
+ */
+typedef enum {
+    PROFILE_IDLE = 0,        ///< Espera do escalonador sem tarefas prontas
+    PROFILE_DISPLAY_UPDATE,  ///< ssd1306_update (bloqueante)
+    PROFILE_DISPLAY_FLUSH,   ///< ssd1306_flush_async (montagem das janelas)
+    PROFILE_NEOPIXEL,        ///< neopixel_present (quadro da matriz)
+    PROFILE_AUDIO_QUEUE,     ///< audio_play/audio_tone (enfileiramento)
+    PROFILE_AUDIO_IRQ,       ///< Alarme do motor de áudio (troca de nota)
+    PROFILE_SERIAL,          ///< Relatório serial (printf ou telemetria binária)
+    PROFILE_FLASH,           ///< Gravação de um setor do log na flash
+    PROFILE_TASK_BASE,
+    PROFILE_NUM_PHASES = PROFILE_TASK_BASE + SCHED_MAX_TASKS
+} profile_phase_t;
+
+/** Baldes por histograma: 0-3 us diretos, depois 4 por oitava até 2^22 us */
+#define PROFILE_BUCKETS 84
+
+#if MONITOR_PROFILE
+
+#include "pico/stdlib.h"
+
+/**
+ * @brief Início de um trecho medido
+ * @param var Variável local que guarda o instante inicial
+ */
+#define PROFILE_BEGIN(var) uint32_t var = time_us_32()
+
+/**
+ * @brief Fim de um trecho medido
+ * @param phase Fase (profile_phase_t)
+ * @param var Variável criada por PROFILE_BEGIN
+ */
+#define PROFILE_END(phase, var) profile_record((phase), time_us_32() - (var))
+
+/**
+ * @brief Registra uma duração
+ * @param phase Fase
+ * @param us Duração em microssegundos
+ */
+void profile_record(int phase, uint32_t us);
+
+/**
+ * @brief Imprime uma linha por fase com amostras
+ *
+ * Formato: PERF,fase,n,min,p50,p99,max (us). Tarefas aparecem como
+ * tarefa:nome.
+ */
+void profile_dump(void);
+
+/**
+ * @brief Zera todos os histogramas
+ */
+void profile_reset(void);
+
+#else
+
+#define PROFILE_BEGIN(var) do { } while (0)
+#define PROFILE_END(phase, var) do { } while (0)
+
+#endif // MONITOR_PROFILE
+
+#endif // PROFILE_H
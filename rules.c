@@ -0,0 +1,346 @@
+/**
+ * @file rules.c
+ * @brief Motor de regras de alerta avaliado apenas nas entradas alteradas
+ *
+ * O índice sensor → regras é uma lista compacta (início por sensor e um
+ * vetor único de regras), montada por contagem em rules_finalize(). A
+ * fila de pendentes evita avaliar duas vezes uma regra que lê vários
+ * sensores amostrados na mesma rodada.
+ */
+#include "rules.h"
+#include "sensor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+/** Campos de um sensor lidos pelos termos */
+typedef enum {
+    FIELD_VALUE = 0,
+    FIELD_MEAN,
+    FIELD_STDDEV,
+    FIELD_RATE,
+    FIELD_ANOMALY
+} rule_field_t;
+
+typedef enum { OP_GT = 0, OP_LT, OP_GE, OP_LE, OP_EQ, OP_NE } rule_op_t;
+
+/**
+ * @brief Condição compilada: campo do sensor comparado a uma constante
+ */
+typedef struct {
+    uint8_t sensor;
+    uint8_t field;   ///< rule_field_t
+    uint8_t op;      ///< rule_op_t
+    fix_t constant;
+} rule_term_t;
+
+static const char *const field_names[] = {"valor", "media", "desvio", "taxa", "anomalia"};
+static const char *const op_names[] = {">", "<", ">=", "<=", "==", "!="};
+static const char *const action_names[] = {"log", "alerta", "incendio"};
+
+static rule_t rules[RULES_MAX];
+static int rule_count = 0;
+static rule_term_t terms[RULES_MAX_TERMS];
+static int term_count = 0;
+
+static uint16_t dep_start[SENSOR_MAX + 1];    ///< Regras do sensor s: dep_rules[dep_start[s]..dep_start[s+1])
+static uint16_t dep_rules[RULES_MAX_TERMS];
+static uint16_t pending[RULES_MAX];
+static int pending_count = 0;
+static rule_handler_t handler = NULL;
+
+/**
+ * @brief Cursor do compilador
+ */
+typedef struct {
+    const char *p;
+    const char *error;
+} parser_t;
+
+static void skip_spaces(parser_t *ps) {
+    while (*ps->p == ' ' || *ps->p == '\t') ps->p++;
+}
+/**
+ * @brief Consome uma palavra-chave inteira (não um prefixo)
+ */
+static bool accept_word(parser_t *ps, const char *word) {
+    skip_spaces(ps);
+    size_t len = strlen(word);
+    if (strncmp(ps->p, word, len) != 0 || isalnum((unsigned char)ps->p[len]) || ps->p[len] == '_') return false;
+    ps->p += len;
+    return true;
+}
+/**
+ * @brief Consome um símbolo (->, :, [ ...)
+ */
+static bool accept(parser_t *ps, const char *symbol) {
+    skip_spaces(ps);
+    size_t len = strlen(symbol);
+    if (strncmp(ps->p, symbol, len) != 0) return false;
+    ps->p += len;
+    return true;
+}
+/**
+ * @brief Lê um número decimal para ponto fixo
+ */
+static bool parse_number(parser_t *ps, fix_t *value) {
+    skip_spaces(ps);
+    char *end;
+    double v = strtod(ps->p, &end);
+    if (end == ps->p) return false;
+    ps->p = end;
+    *value = (fix_t)(v * FIX_ONE + (v >= 0 ? 0.5 : -0.5));
+    return true;
+}
+/**
+ * @brief Lê um inteiro não negativo limitado a max
+ */
+static bool parse_uint(parser_t *ps, uint32_t max, uint32_t *value) {
+    skip_spaces(ps);
+    char *end;
+    unsigned long v = strtoul(ps->p, &end, 10);
+    if (end == ps->p || v > max) return false;
+    ps->p = end;
+    *value = (uint32_t)v;
+    return true;
+}
+/**
+ * @brief Lê uma palavra de uma tabela de nomes
+ * @return Índice na tabela, ou -1
+ */
+static int parse_keyword(parser_t *ps, const char *const names[], int count) {
+    for (int i = 0; i < count; i++) {
+        if (accept_word(ps, names[i])) return i;
+    }
+    return -1;
+}
+/**
+ * @brief Lê [Sensor] e devolve o índice no registro
+ */
+static int parse_sensor(parser_t *ps) {
+    if (!accept(ps, "[")) return -1;
+    const char *end = strchr(ps->p, ']');
+    if (end == NULL) return -1;
+    size_t len = (size_t)(end - ps->p);
+    for (int i = 0; i < sensor_count(); i++) {
+        const char *name = sensor_get(i)->driver->name;
+        if (strlen(name) == len && strncmp(name, ps->p, len) == 0) {
+            ps->p = end + 1;
+            return i;
+        }
+    }
+    return -1;
+}
+/**
+ * @brief Lê um termo: [Sensor][.campo] op número
+ */
+static bool parse_term(parser_t *ps, rule_term_t *term) {
+    int sensor = parse_sensor(ps);
+    if (sensor < 0) {
+        ps->error = "sensor desconhecido";
+        return false;
+    }
+    int field = FIELD_VALUE;
+    if (*ps->p == '.') {
+        ps->p++;
+        field = parse_keyword(ps, field_names, (int)(sizeof(field_names) / sizeof(field_names[0])));
+        if (field < 0) {
+            ps->error = "campo desconhecido";
+            return false;
+        }
+    }
+    // Operadores de dois caracteres primeiro
+    static const uint8_t op_order[] = {OP_GE, OP_LE, OP_EQ, OP_NE, OP_GT, OP_LT};
+    int op = -1;
+    for (unsigned i = 0; i < sizeof(op_order) && op < 0; i++) {
+        if (accept(ps, op_names[op_order[i]])) op = op_order[i];
+    }
+    if (op < 0) {
+        ps->error = "operador esperado";
+        return false;
+    }
+    fix_t constant;
+    if (!parse_number(ps, &constant)) {
+        ps->error = "numero esperado";
+        return false;
+    }
+    *term = (rule_term_t){(uint8_t)sensor, (uint8_t)field, (uint8_t)op, constant};
+    return true;
+}
+/**
+ * @brief Compila e acrescenta uma regra
+ */
+int rules_add(const char *text) {
+    if (rule_count >= RULES_MAX) {
+        printf("REGRA ignorada (tabela cheia): %s\n", text);
+        return -1;
+    }
+    parser_t ps = {text, NULL};
+    rule_t rule = {.first_term = (uint16_t)term_count, .severity = 1, .hold = 1, .cooldown_ms = 60000};
+
+    skip_spaces(&ps);
+    size_t len = 0;
+    while (isalnum((unsigned char)ps.p[len]) || ps.p[len] == '_') len++;
+    if (len == 0 || len >= RULES_NAME_LEN) {
+        ps.error = "nome invalido";
+    } else {
+        memcpy(rule.name, ps.p, len);
+        ps.p += len;
+        if (!accept(&ps, ":")) ps.error = "':' esperado";
+    }
+
+    int terms_used = 0;
+    while (ps.error == NULL) {
+        if (term_count + terms_used >= RULES_MAX_TERMS || terms_used == UINT8_MAX) {
+            ps.error = "termos demais";
+            break;
+        }
+        if (!parse_term(&ps, &terms[term_count + terms_used])) break;
+        terms_used++;
+        if (!accept_word(&ps, "e")) break;
+    }
+
+    uint32_t number;
+    if (ps.error == NULL && accept_word(&ps, "por")) {
+        if (parse_uint(&ps, UINT16_MAX, &number) && number > 0) rule.hold = (uint16_t)number;
+        else ps.error = "'por' sem contagem";
+    }
+    if (ps.error == NULL && !accept(&ps, "->")) ps.error = "'->' esperado";
+    int action = -1;
+    if (ps.error == NULL) {
+        action = parse_keyword(&ps, action_names, (int)(sizeof(action_names) / sizeof(action_names[0])));
+        if (action < 0) ps.error = "acao desconhecida";
+    }
+    while (ps.error == NULL) {
+        if (accept_word(&ps, "sev")) {
+            if (parse_uint(&ps, 3, &number) && number > 0) rule.severity = (uint8_t)number;
+            else ps.error = "severidade de 1 a 3";
+        } else if (accept_word(&ps, "espera")) {
+            if (parse_uint(&ps, UINT32_MAX / 1000, &number)) rule.cooldown_ms = number * 1000;
+            else ps.error = "espera em segundos";
+        } else {
+            skip_spaces(&ps);
+            if (*ps.p != '\0') ps.error = "texto inesperado";
+            break;
+        }
+    }
+
+    if (ps.error != NULL) {
+        printf("REGRA invalida (%s, coluna %d): %s\n", ps.error, (int)(ps.p - text) + 1, text);
+        return -1;
+    }
+    rule.term_count = (uint8_t)terms_used;
+    rule.action = (uint8_t)action;
+    rule.id = (uint16_t)rule_count;
+    term_count += terms_used;
+    rules[rule_count] = rule;
+    return rule_count++;
+}
+/**
+ * @brief Monta o índice de regras por sensor
+ */
+void rules_finalize(rule_handler_t on_fire) {
+    handler = on_fire;
+    uint16_t count[SENSOR_MAX] = {0};
+    // Máscara de sensores de cada regra: um sensor lido por vários termos conta uma vez
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            dep_start[0] = 0;
+            for (int s = 0; s < SENSOR_MAX; s++) {
+                dep_start[s + 1] = (uint16_t)(dep_start[s] + count[s]);
+                count[s] = 0;
+            }
+        }
+        for (int r = 0; r < rule_count; r++) {
+            uint32_t seen = 0;
+            for (int t = 0; t < rules[r].term_count; t++) {
+                uint8_t s = terms[rules[r].first_term + t].sensor;
+                if (seen & (1u << s)) continue;
+                seen |= 1u << s;
+                if (pass == 1) dep_rules[dep_start[s] + count[s]] = (uint16_t)r;
+                count[s]++;
+            }
+        }
+    }
+}
+/**
+ * @brief Marca as regras que leem o sensor
+ */
+void rules_sensor_updated(int sensor_id) {
+    if (sensor_id < 0 || sensor_id >= SENSOR_MAX) return;
+    for (int k = dep_start[sensor_id]; k < dep_start[sensor_id + 1]; k++) {
+        rule_t *rule = &rules[dep_rules[k]];
+        if (rule->pending) continue;
+        rule->pending = true;
+        pending[pending_count++] = dep_rules[k];
+    }
+}
+/**
+ * @brief Valor atual do campo de um termo
+ * @return false se o sensor estiver desabilitado
+ */
+static bool term_operand(const rule_term_t *term, fix_t *value) {
+    const sensor_t *sensor = sensor_get(term->sensor);
+    if (sensor == NULL || !sensor->enabled) return false;
+    switch (term->field) {
+        case FIELD_MEAN: *value = sensor_mean(sensor); break;
+        case FIELD_STDDEV: *value = history_stddev(&sensor->history); break;
+        case FIELD_RATE: *value = sensor->rate; break;
+        case FIELD_ANOMALY: *value = sensor_is_anomalous(sensor) ? FIX_ONE : 0; break;
+        default: *value = sensor->value; break;
+    }
+    return true;
+}
+static bool term_holds(const rule_term_t *term) {
+    fix_t v;
+    if (!term_operand(term, &v)) return false;
+    switch (term->op) {
+        case OP_GT: return v > term->constant;
+        case OP_LT: return v < term->constant;
+        case OP_GE: return v >= term->constant;
+        case OP_LE: return v <= term->constant;
+        case OP_EQ: return v == term->constant;
+        default: return v != term->constant;
+    }
+}
+/**
+ * @brief Avalia as regras marcadas e executa as que dispararem
+ */
+int rules_evaluate(uint32_t now_ms) {
+    int evaluated = 0;
+    for (int i = 0; i < pending_count; i++) {
+        rule_t *rule = &rules[pending[i]];
+        rule->pending = false;
+        rule->evaluations++;
+        evaluated++;
+
+        bool holds = true;
+        for (int t = 0; t < rule->term_count && holds; t++) {
+            holds = term_holds(&terms[rule->first_term + t]);
+        }
+        if (!holds) {
+            rule->streak = 0;
+            continue;
+        }
+        if (rule->streak < UINT16_MAX) rule->streak++;
+        if (rule->streak < rule->hold) continue;
+        if (rule->fired > 0 && now_ms - rule->last_fired_ms < rule->cooldown_ms) continue;
+
+        rule->fired++;
+        rule->last_fired_ms = now_ms;
+        if (handler) handler(rule, now_ms);
+    }
+    pending_count = 0;
+    return evaluated;
+}
+int rules_count() {
+    return rule_count;
+}
+const rule_t *rules_get(int id) {
+    if (id < 0 || id >= rule_count) return NULL;
+    return &rules[id];
+}
+const char *rules_action_name(rule_action_t action) {
+    return (unsigned)action < sizeof(action_names) / sizeof(action_names[0]) ? action_names[action] : "?";
+}
@@ -0,0 +1,119 @@
+/**
+ * @file rules.h
+ * @brief Motor de regras de alerta avaliado apenas nas entradas alteradas
+ *
+ * As regras são escritas em texto e compiladas na inicialização para uma
+ * tabela compacta: cada condição vira um termo (sensor, campo, operador,
+ * constante em ponto fixo) e cada sensor guarda a lista das regras que o
+ * leem. Uma amostra nova marca só essas regras; rules_evaluate() avalia
+ * as marcadas, de modo que o custo por amostra é proporcional às regras
+ * afetadas, não ao total carregado.
+ *
+ * Sintaxe (uma regra por texto):
+ *
+ *   nome: termo [e termo ...] [por N] -> ação [sev S] [espera T]
+ *   termo: [Sensor][.campo] op número
+ *
+ * - campo: valor (padrão), media (janela do histórico), desvio, taxa
+ *   (unidades por segundo entre as duas últimas amostras) ou anomalia
+ *   (1 se alguma regra de anomalia.h disparou, 0 caso contrário);
+ * - op: > < >= <= == !=
+ * - por N: a condição precisa valer em N avaliações seguidas (padrão 1);
+ * - ação: log, alerta ou incendio;
+ * - sev: severidade de 1 a 3 (padrão 1);
+ * - espera T: intervalo mínimo entre disparos, em segundos (padrão 60).
+ *
+ * Exemplo: risco_fogo: [Temperatura].taxa > 0.05 e [Chuva] == 0 por 5 -> incendio sev 3
+ *
+ * Termos de sensores desabilitados são falsos.
+ */
+#ifndef RULES_H
+#define RULES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fixed.h"
+
+#define RULES_MAX 256         ///< Regras carregadas
+#define RULES_MAX_TERMS 512   ///< Termos somados de todas as regras
+#define RULES_NAME_LEN 16     ///< Nome com terminador
+
+/**
+ * @brief Ação executada quando a regra dispara
+ */
+typedef enum {
+    RULE_ACTION_LOG = 0,   ///< Apenas registra (serial e log da flash)
+    RULE_ACTION_ALERT,     ///< Alerta sonoro e na serial
+    RULE_ACTION_FIRE       ///< Alerta de incêndio (SOS)
+} rule_action_t;
+
+/**
+ * @brief Regra compilada
+ */
+typedef struct {
+    char name[RULES_NAME_LEN];
+    uint16_t id;              ///< Índice na tabela
+    uint16_t first_term;      ///< Índice do primeiro termo
+    uint8_t term_count;
+    uint8_t action;           ///< rule_action_t
+    uint8_t severity;         ///< 1 a 3
+    bool pending;             ///< Marcada para a próxima avaliação
+    uint16_t hold;            ///< Avaliações seguidas exigidas
+    uint16_t streak;          ///< Avaliações seguidas verdadeiras
+    uint32_t cooldown_ms;     ///< Intervalo mínimo entre disparos
+    uint32_t last_fired_ms;
+    uint32_t fired;           ///< Disparos
+    uint32_t evaluations;     ///< Avaliações
+} rule_t;
+
+/**
+ * @brief Função chamada a cada disparo
+ */
+typedef void (*rule_handler_t)(const rule_t *rule, uint32_t now_ms);
+
+/**
+ * @brief Compila e acrescenta uma regra
+ *
+ * Os sensores precisam estar registrados. Deve ser chamada antes de
+ * rules_finalize().
+ * @param text Regra na sintaxe acima
+ * @return Índice da regra, ou -1 (o motivo é impresso na serial)
+ */
+int rules_add(const char *text);
+
+/**
+ * @brief Monta o índice de regras por sensor; fim da carga
+ * @param handler Função chamada nos disparos
+ */
+void rules_finalize(rule_handler_t handler);
+
+/**
+ * @brief Marca as regras que leem o sensor (nova amostra)
+ * @param sensor_id Índice do sensor
+ */
+void rules_sensor_updated(int sensor_id);
+
+/**
+ * @brief Avalia as regras marcadas e executa as que dispararem
+ * @param now_ms Instante atual (ms desde o boot)
+ * @return Regras avaliadas
+ */
+int rules_evaluate(uint32_t now_ms);
+
+/**
+ * @brief Quantidade de regras carregadas
+ */
+int rules_count(void);
+
+/**
+ * @brief Acesso a uma regra pelo índice
+ * @return Ponteiro para a regra, ou NULL se inválido
+ */
+const rule_t *rules_get(int id);
+
+/**
+ * @brief Nome da ação
+ */
+const char *rules_action_name(rule_action_t action);
+
+#endif // RULES_H
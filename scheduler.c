@@ -0,0 +1,208 @@
+/**
+ * @file scheduler.c
+ * @brief Escalonador cooperativo de tarefas periódicas com prazos
+ *
+ * Implementa liberação periódica sem deriva (a próxima liberação é
+ * calculada a partir da anterior, não do fim da execução) e seleção
+ * EDF entre as tarefas prontas. Tempos em ms desde o boot, com
+ * comparações seguras contra o estouro do contador de 32 bits.
+ */
+#include "scheduler.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "profile.h"
+#include "idle.h"
+#include <stddef.h>
+
+static sched_task_t tasks[SCHED_MAX_TASKS];
+static int task_count = 0;
+
+static volatile uint32_t isr_triggers = 0;  ///< Tarefas antecipadas por interrupções (bits)
+static int running_id = -1;                 ///< Tarefa em execução
+static bool running_deferred = false;       ///< scheduler_defer() chamado por ela
+static uint32_t running_next_ms = 0;
+
+/**
+ * @brief Compara instantes considerando o estouro do contador
+ * @return true se a ocorre antes de b
+ */
+static inline bool time_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+/**
+ * @brief Tempo atual em ms desde o boot
+ */
+static inline uint32_t now_ms(void) {
+    return to_ms_since_boot(get_absolute_time());
+}
+/**
+ * @brief Registra uma tarefa periódica
+ *
+ * A primeira liberação ocorre imediatamente.
+ */
+int scheduler_add_task(const char *name, sched_task_fn_t run, uint32_t period_ms, uint32_t deadline_ms) {
+    if (task_count >= SCHED_MAX_TASKS || run == NULL || period_ms == 0) return -1;
+
+    sched_task_t *task = &tasks[task_count];
+    task->name = name;
+    task->run = run;
+    task->period_ms = period_ms;
+    task->deadline_ms = deadline_ms ? deadline_ms : period_ms;
+    task->next_release_ms = now_ms();
+    task->enabled = true;
+    task->runs = 0;
+    task->missed = 0;
+    task->max_lateness_ms = 0;
+    return task_count++;
+}
+/**
+ * @brief Ativa ou desativa uma tarefa
+ *
+ * Ao ser reativada, a tarefa é liberada imediatamente.
+ */
+void scheduler_set_enabled(int id, bool enabled) {
+    if (id < 0 || id >= task_count) return;
+    if (enabled && !tasks[id].enabled) {
+        tasks[id].next_release_ms = now_ms();
+    }
+    tasks[id].enabled = enabled;
+}
+/**
+ * @brief Antecipa a liberação de uma tarefa para agora
+ */
+void scheduler_trigger(int id) {
+    if (id < 0 || id >= task_count) return;
+    uint32_t now = now_ms();
+    if (time_before(now, tasks[id].next_release_ms)) {
+        tasks[id].next_release_ms = now;
+    }
+}
+/**
+ * @brief Antecipa a liberação de uma tarefa a partir de uma interrupção
+ */
+void scheduler_trigger_from_isr(int id) {
+    if (id < 0 || id >= SCHED_MAX_TASKS) return;
+    isr_triggers |= 1u << id;
+    idle_wake();
+}
+/**
+ * @brief Define a próxima liberação de uma tarefa
+ */
+void scheduler_defer(int id, uint32_t delay_ms) {
+    if (id < 0 || id >= task_count) return;
+    uint32_t next = now_ms() + delay_ms;
+    if (id == running_id) {
+        running_deferred = true;
+        running_next_ms = next;
+    } else {
+        tasks[id].next_release_ms = next;
+    }
+}
+/**
+ * @brief Aplica as antecipações pedidas por interrupções
+ */
+static void apply_isr_triggers(void) {
+    if (isr_triggers == 0) return;
+    uint32_t status = save_and_disable_interrupts();
+    uint32_t pending = isr_triggers;
+    isr_triggers = 0;
+    restore_interrupts(status);
+    for (int id = 0; id < task_count; id++) {
+        if (pending & (1u << id)) scheduler_trigger(id);
+    }
+}
+/**
+ * @brief Executa a tarefa liberada de prazo mais próximo, se houver
+ *
+ * Após a execução a próxima liberação avança um período; se a tarefa
+ * ficou mais de um período atrasada, ela é realinhada ao instante atual
+ * em vez de executar rajadas para recuperar as liberações perdidas.
+ */
+bool scheduler_run_once() {
+    apply_isr_triggers();
+    uint32_t now = now_ms();
+    sched_task_t *selected = NULL;
+    uint32_t selected_deadline = 0;
+
+    for (int i = 0; i < task_count; i++) {
+        sched_task_t *task = &tasks[i];
+        if (!task->enabled || time_before(now, task->next_release_ms)) continue;
+
+        uint32_t deadline = task->next_release_ms + task->deadline_ms;
+        if (selected == NULL || time_before(deadline, selected_deadline)) {
+            selected = task;
+            selected_deadline = deadline;
+        }
+    }
+    if (selected == NULL) return false;
+
+    uint32_t release = selected->next_release_ms;
+    uint32_t lateness = now - release;
+    if (lateness > selected->max_lateness_ms) selected->max_lateness_ms = lateness;
+    if (time_before(selected_deadline, now)) selected->missed++;
+
+    running_id = (int)(selected - tasks);
+    running_deferred = false;
+    PROFILE_BEGIN(start_us);
+    selected->run(now);
+    PROFILE_END(PROFILE_TASK_BASE + running_id, start_us);
+    running_id = -1;
+    selected->runs++;
+
+    if (running_deferred) {
+        selected->next_release_ms = running_next_ms;
+        return true;
+    }
+    selected->next_release_ms = release + selected->period_ms;
+    if (time_before(selected->next_release_ms, now)) {
+        selected->next_release_ms = now + selected->period_ms;
+    }
+    return true;
+}
+/**
+ * @brief Instante da próxima liberação entre as tarefas ativas
+ *
+ * Sem tarefas ativas, retorna um instante 1 s à frente.
+ */
+uint32_t scheduler_next_release() {
+    uint32_t now = now_ms();
+    uint32_t next = now + 1000;
+
+    for (int i = 0; i < task_count; i++) {
+        if (tasks[i].enabled && time_before(tasks[i].next_release_ms, next)) {
+            next = tasks[i].next_release_ms;
+        }
+    }
+    return next;
+}
+/**
+ * @brief Laço principal do escalonador (não retorna)
+ *
+ * Executa as tarefas prontas e, quando não há nenhuma, dorme até a
+ * próxima liberação; scheduler_trigger_from_isr() encerra a espera.
+ */
+void scheduler_run() {
+    while (true) {
+        if (scheduler_run_once()) continue;
+
+        uint32_t next = scheduler_next_release();
+        if (time_before(now_ms(), next) && isr_triggers == 0) {
+            PROFILE_BEGIN(idle_us);
+            idle_wait_until((uint64_t)next * 1000);
+            PROFILE_END(PROFILE_IDLE, idle_us);
+        }
+    }
+}
+/**
+ * @brief Acesso às estatísticas de uma tarefa
+ */
+const sched_task_t *scheduler_get_task(int id) {
+    if (id < 0 || id >= task_count) return NULL;
+    return &tasks[id];
+}
+/**
+ * @brief Quantidade de tarefas registradas
+ */
+int scheduler_task_count() {
+    return task_count;
+}
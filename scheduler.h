@@ -0,0 +1,117 @@
+/**
+ * @file scheduler.h
+ * @brief Escalonador cooperativo de tarefas periódicas com prazos
+ *
+ * Cada tarefa tem período e prazo relativo próprios. Entre as tarefas
+ * liberadas, executa primeiro a de prazo absoluto mais próximo (EDF);
+ * sem tarefas prontas, o núcleo dorme em WFI até a próxima liberação
+ * (idle.h) ou até uma interrupção antecipar uma tarefa.
+ * As tarefas nunca devem bloquear (sleep_ms) — devem retornar e aguardar
+ * a próxima liberação.
+ */
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Número máximo de tarefas registradas */
+#define SCHED_MAX_TASKS 12
+
+/**
+ * @brief Função de uma tarefa
+ * @param now_ms Instante da execução (ms desde o boot)
+ */
+typedef void (*sched_task_fn_t)(uint32_t now_ms);
+
+/**
+ * @brief Estado e estatísticas de uma tarefa
+ */
+typedef struct {
+    const char *name;          ///< Nome para relatórios
+    sched_task_fn_t run;       ///< Função executada a cada liberação
+    uint32_t period_ms;        ///< Intervalo entre liberações
+    uint32_t deadline_ms;      ///< Prazo relativo à liberação
+    uint32_t next_release_ms;  ///< Próxima liberação (ms desde o boot)
+    bool enabled;              ///< Tarefa ativa
+    uint32_t runs;             ///< Execuções realizadas
+    uint32_t missed;           ///< Execuções iniciadas após o prazo
+    uint32_t max_lateness_ms;  ///< Maior atraso em relação à liberação
+} sched_task_t;
+
+/**
+ * @brief Registra uma tarefa periódica
+ *
+ * @param name Nome da tarefa
+ * @param run Função da tarefa
+ * @param period_ms Período em ms
+ * @param deadline_ms Prazo relativo à liberação (0 = igual ao período)
+ * @return Identificador da tarefa, ou -1 se a tabela estiver cheia
+ */
+int scheduler_add_task(const char *name, sched_task_fn_t run, uint32_t period_ms, uint32_t deadline_ms);
+
+/**
+ * @brief Ativa ou desativa uma tarefa
+ * @param id Identificador da tarefa
+ * @param enabled Novo estado
+ */
+void scheduler_set_enabled(int id, bool enabled);
+
+/**
+ * @brief Antecipa a liberação de uma tarefa para agora
+ *
+ * Usado quando um evento exige resposta imediata (ex.: botão pressionado
+ * pede redesenho do display). Pode ser chamado de dentro de tarefas.
+ * @param id Identificador da tarefa
+ */
+void scheduler_trigger(int id);
+
+/**
+ * @brief Antecipa a liberação de uma tarefa a partir de uma interrupção
+ *
+ * Apenas marca a tarefa e acorda o núcleo; a liberação é aplicada pelo
+ * laço do escalonador.
+ * @param id Identificador da tarefa
+ */
+void scheduler_trigger_from_isr(int id);
+
+/**
+ * @brief Define a próxima liberação de uma tarefa
+ *
+ * Chamada de dentro da própria tarefa, substitui o período apenas nesta
+ * execução; permite a tarefas sem trabalho dormir até o próximo evento.
+ * @param id Identificador da tarefa
+ * @param delay_ms Atraso a partir de agora
+ */
+void scheduler_defer(int id, uint32_t delay_ms);
+
+/**
+ * @brief Executa a tarefa liberada de prazo mais próximo, se houver
+ * @return true se alguma tarefa foi executada
+ */
+bool scheduler_run_once(void);
+
+/**
+ * @brief Instante da próxima liberação entre as tarefas ativas
+ * @return ms desde o boot
+ */
+uint32_t scheduler_next_release(void);
+
+/**
+ * @brief Laço principal do escalonador (não retorna)
+ */
+void scheduler_run(void);
+
+/**
+ * @brief Acesso às estatísticas de uma tarefa
+ * @param id Identificador da tarefa
+ * @return Ponteiro para a tarefa, ou NULL se inválido
+ */
+const sched_task_t *scheduler_get_task(int id);
+
+/**
+ * @brief Quantidade de tarefas registradas
+ */
+int scheduler_task_count(void);
+
+#endif // SCHEDULER_H
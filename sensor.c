@@ -0,0 +1,154 @@
+/**
+ * @file sensor.c
+ * @brief Registro de sensores com drivers intercambiáveis
+ */
+#include "sensor.h"
+#include <stddef.h>
+
+static sensor_t sensors[SENSOR_MAX];
+static int count = 0;
+static void (*listener)(sensor_t *sensor, uint32_t now_ms) = NULL;
+
+/**
+ * @brief Registra um sensor e executa o init() do driver
+ */
+int sensor_register(const sensor_driver_t *driver) {
+    if (count >= SENSOR_MAX || driver == NULL || driver->read == NULL) return -1;
+
+    sensor_t *sensor = &sensors[count];
+    sensor->driver = driver;
+    sensor->id = (uint8_t)count;
+    sensor->enabled = false;
+    sensor->value = 0;
+    sensor->read_errors = 0;
+    sensor->rate = 0;
+    sensor->sample_ms = 0;
+    sensor->samples = 0;
+    sensor->anomaly_rules = 0;
+    history_init(&sensor->history, SENSOR_HISTORY_WINDOW, sensor->history_storage);
+    anomaly_init(&sensor->detector);
+    sensor->available = driver->init ? driver->init(sensor) : true;
+    return count++;
+}
+/**
+ * @brief Quantidade de sensores registrados
+ */
+int sensor_count() {
+    return count;
+}
+/**
+ * @brief Acesso a um sensor pelo índice
+ */
+sensor_t *sensor_get(int id) {
+    if (id < 0 || id >= count) return NULL;
+    return &sensors[id];
+}
+/**
+ * @brief Habilita ou desabilita um sensor
+ */
+void sensor_set_enabled(int id, bool enabled) {
+    sensor_t *sensor = sensor_get(id);
+    if (sensor == NULL) return;
+    sensor->enabled = enabled && sensor->available;
+}
+/**
+ * @brief Quantidade de sensores habilitados
+ */
+int sensor_enabled_count() {
+    int enabled = 0;
+    for (int i = 0; i < count; i++) {
+        if (sensors[i].enabled) enabled++;
+    }
+    return enabled;
+}
+/**
+ * @brief Posição de um sensor entre os habilitados
+ */
+int sensor_enabled_position(int id) {
+    sensor_t *sensor = sensor_get(id);
+    if (sensor == NULL || !sensor->enabled) return -1;
+    int position = 0;
+    for (int i = 0; i < id; i++) {
+        if (sensors[i].enabled) position++;
+    }
+    return position;
+}
+/**
+ * @brief Próximo sensor habilitado a partir de um índice (circular)
+ */
+int sensor_next_enabled(int from, int step) {
+    if (count == 0) return -1;
+    int id = from;
+    for (int i = 0; i < count; i++) {
+        id = ((id + step) % count + count) % count;
+        if (sensors[id].enabled) return id;
+    }
+    return -1;
+}
+/**
+ * @brief Lê um sensor e atualiza valor e histórico
+ */
+bool sensor_sample(sensor_t *sensor, uint32_t now_ms) {
+    fix_t value;
+    if (!sensor->driver->read(sensor, now_ms, &value)) {
+        sensor->read_errors++;
+        return false;
+    }
+    sensor_feed(sensor, now_ms, value);
+    return true;
+}
+/**
+ * @brief Registra uma leitura já obtida: valor, histórico e detectores
+ */
+void sensor_feed(sensor_t *sensor, uint32_t now_ms, fix_t value) {
+    const sensor_driver_t *driver = sensor->driver;
+    history_push(&sensor->history, value);
+    uint32_t dt_ms = now_ms - sensor->sample_ms;
+    sensor->rate = (sensor->samples > 0 && dt_ms > 0)
+        ? (fix_t)(((int64_t)value - sensor->value) * 1000 / dt_ms) : 0;
+    sensor->value = value;
+    sensor->sample_ms = now_ms;
+    sensor->samples++;
+    uint8_t rules = anomaly_update(&sensor->detector, driver->detect, value, now_ms);
+    if (value < driver->anomaly_min || value > driver->anomaly_max) rules |= ANOMALY_RANGE;
+    sensor->anomaly_rules = rules;
+    if (listener) listener(sensor, now_ms);
+}
+/**
+ * @brief Define a função chamada após cada leitura registrada
+ */
+void sensor_set_listener(void (*callback)(sensor_t *sensor, uint32_t now_ms)) {
+    listener = callback;
+}
+/**
+ * @brief Amostra todos os sensores habilitados
+ */
+void sensor_sample_all(uint32_t now_ms) {
+    for (int i = 0; i < count; i++) {
+        if (sensors[i].enabled) sensor_sample(&sensors[i], now_ms);
+    }
+}
+/**
+ * @brief Média móvel das últimas SENSOR_HISTORY_WINDOW leituras
+ */
+fix_t sensor_mean(const sensor_t *sensor) {
+    return history_mean(&sensor->history);
+}
+/**
+ * @brief Verifica se a última leitura disparou alguma regra de anomalia
+ */
+bool sensor_is_anomalous(const sensor_t *sensor) {
+    return sensor->anomaly_rules != 0;
+}
+/**
+ * @brief Regras disparadas pela última leitura
+ */
+uint8_t sensor_anomaly_rules(const sensor_t *sensor) {
+    return sensor->anomaly_rules;
+}
+/**
+ * @brief Rótulo do sensor no menu
+ */
+const char *sensor_menu_name(const sensor_t *sensor) {
+    return sensor->driver->menu_name ? sensor->driver->menu_name : sensor->driver->name;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file sensor.h
+ * @brief Registro de sensores com drivers intercambiáveis
+ *
+ * Cada sensor é descrito por um driver (nome, unidade, limites, limiares
+ * e detectores de anomalia, callbacks de inicialização e leitura) e
+ * registrado em uma tabela. A amostragem, o display, a serial e o menu
+ * percorrem a tabela por índice, sem comparar nomes. Drivers reais (I2C,
+ * ADC, 1-Wire) e o simulador (sensor_sim.h) têm a mesma interface.
+ */
+#ifndef SENSOR_H
+#define SENSOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fixed.h"
+#include "history.h"
+#include "anomaly.h"
+
+/** Número máximo de sensores registrados */
+#define SENSOR_MAX 12
+
+/**
+ * Leituras na janela de estatísticas de cada sensor (até
+ * HISTORY_MAX_WINDOW). Cada leitura da janela ocupa 12 bytes de RAM por
+ * sensor registrável: com SENSOR_MAX = 12, cerca de 1,4 KB para 10
+ * leituras e 37 KB para 256. Definida pelo CMake (MONITOR_HISTORY_WINDOW).
+ */
+#ifndef SENSOR_HISTORY_WINDOW
+#define SENSOR_HISTORY_WINDOW 10
+#endif
+_Static_assert(SENSOR_HISTORY_WINDOW >= 1 && SENSOR_HISTORY_WINDOW <= HISTORY_MAX_WINDOW,
+               "SENSOR_HISTORY_WINDOW fora de 1..HISTORY_MAX_WINDOW");
+
+typedef struct sensor sensor_t;
+
+/**
+ * @brief Descrição e operações de um tipo de sensor
+ */
+typedef struct {
+    const char *name;        ///< Nome exibido no display e na serial
+    const char *menu_name;   ///< Rótulo no menu (NULL = name)
+    const char *unit;        ///< Unidade de medida
+    fix_t min_val;           ///< Menor leitura válida
+    fix_t max_val;           ///< Maior leitura válida
+    fix_t anomaly_min;       ///< Abaixo disso a leitura é anômala
+    fix_t anomaly_max;       ///< Acima disso a leitura é anômala
+    const anomaly_config_t *detect;  ///< Detectores estatísticos (NULL = só limiares)
+
+    /**
+     * @brief Prepara o hardware (opcional)
+     * @return false se o sensor não responder; ele fica indisponível
+     */
+    bool (*init)(sensor_t *sensor);
+
+    /**
+     * @brief Obtém uma leitura
+     * @param now_ms Instante da amostragem (ms desde o boot)
+     * @param value Leitura na unidade do sensor
+     * @return false se a leitura falhar (a amostra é descartada)
+     */
+    bool (*read)(sensor_t *sensor, uint32_t now_ms, fix_t *value);
+
+    const void *config;      ///< Parâmetros próprios do driver
+} sensor_driver_t;
+
+/**
+ * @brief Estado de um sensor registrado
+ */
+struct sensor {
+    const sensor_driver_t *driver;  ///< Driver do sensor
+    uint8_t id;                     ///< Índice na tabela
+    bool available;                 ///< init() teve sucesso
+    bool enabled;                   ///< Habilitado no menu
+    fix_t value;                    ///< Última leitura
+    fix_t rate;                     ///< Variação por segundo desde a leitura anterior
+    uint32_t sample_ms;             ///< Instante da última leitura
+    uint32_t samples;               ///< Leituras registradas
+    uint32_t read_errors;           ///< Leituras que falharam
+    history_t history;              ///< Janela de leituras
+    uint32_t history_storage[HISTORY_WORDS(SENSOR_HISTORY_WINDOW)];  ///< Memória da janela
+    anomaly_state_t detector;       ///< Estado dos detectores de anomalia
+    uint8_t anomaly_rules;          ///< Regras disparadas na última leitura (ANOMALY_*)
+};
+
+/**
+ * @brief Registra um sensor e executa o init() do driver
+ * @param driver Driver do sensor
+ * @return Índice do sensor, ou -1 se a tabela estiver cheia
+ */
+int sensor_register(const sensor_driver_t *driver);
+
+/**
+ * @brief Quantidade de sensores registrados
+ */
+int sensor_count(void);
+
+/**
+ * @brief Acesso a um sensor pelo índice
+ * @return Ponteiro para o sensor, ou NULL se inválido
+ */
+sensor_t *sensor_get(int id);
+
+/**
+ * @brief Habilita ou desabilita um sensor
+ *
+ * Sensores indisponíveis (init() falhou) permanecem desabilitados.
+ */
+void sensor_set_enabled(int id, bool enabled);
+
+/**
+ * @brief Quantidade de sensores habilitados
+ */
+int sensor_enabled_count(void);
+
+/**
+ * @brief Posição de um sensor entre os habilitados, na ordem da tabela
+ *
+ * É a ordem percorrida por sensor_next_enabled(), usada no contador
+ * "i/n" do display junto com sensor_enabled_count().
+ * @return Posição a partir de 0, ou -1 se o sensor não estiver habilitado
+ */
+int sensor_enabled_position(int id);
+
+/**
+ * @brief Próximo sensor habilitado a partir de um índice
+ *
+ * @param from Índice de partida (não incluído)
+ * @param step +1 para avançar, -1 para voltar (circular)
+ * @return Índice encontrado, ou -1 se nenhum estiver habilitado
+ */
+int sensor_next_enabled(int from, int step);
+
+/**
+ * @brief Amostra todos os sensores habilitados
+ * @param now_ms Instante atual (ms desde o boot)
+ */
+void sensor_sample_all(uint32_t now_ms);
+
+/**
+ * @brief Lê um sensor e atualiza valor e histórico
+ * @return false se a leitura falhar
+ */
+bool sensor_sample(sensor_t *sensor, uint32_t now_ms);
+
+/**
+ * @brief Registra uma leitura já obtida: valor, histórico e detectores
+ *
+ * Usada por sensor_sample() e para reprocessar leituras gravadas.
+ */
+void sensor_feed(sensor_t *sensor, uint32_t now_ms, fix_t value);
+
+/**
+ * @brief Define a função chamada após cada leitura registrada
+ * @param listener Função (ex.: marca as regras de alerta do sensor), ou NULL
+ */
+void sensor_set_listener(void (*listener)(sensor_t *sensor, uint32_t now_ms));
+
+/**
+ * @brief Média móvel das últimas SENSOR_HISTORY_WINDOW leituras (O(1))
+ */
+fix_t sensor_mean(const sensor_t *sensor);
+
+/**
+ * @brief Verifica se a última leitura disparou alguma regra de anomalia
+ */
+bool sensor_is_anomalous(const sensor_t *sensor);
+
+/**
+ * @brief Regras disparadas pela última leitura (ANOMALY_*)
+ */
+uint8_t sensor_anomaly_rules(const sensor_t *sensor);
+
+/**
+ * @brief Rótulo do sensor no menu
+ */
+const char *sensor_menu_name(const sensor_t *sensor);
+
+#endif // SENSOR_H
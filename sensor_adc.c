@@ -0,0 +1,37 @@
+/**
+ * @file sensor_adc.c
+ * @brief Drivers de sensores lidos pela aquisição contínua do ADC
+ *
+ * A leitura apenas consulta a média mais recente mantida por analog.c;
+ * não há conversão nem espera no caminho da amostragem.
+ */
+#include "sensor_adc.h"
+#include "analog.h"
+
+/**
+ * @brief Temperatura do chip a partir da média sobreamostrada do canal 4
+ */
+static bool chip_temperature_read(sensor_t *sensor, uint32_t now_ms, fix_t *value) {
+    (void)now_ms;
+    *value = fix_clamp(analog_temperature(analog_get(ANALOG_TEMPERATURE)),
+                       sensor->driver->min_val, sensor->driver->max_val);
+    return true;
+}
+
+static const anomaly_config_t chip_temperature_detect = {
+    .ewma_shift = 4, .warmup = 16,
+    .z_limit = FIX_CONST(5.0), .sigma_min = FIX_CONST(0.5),
+    .cusum_k = FIX_CONST(1.0), .cusum_h = FIX_CONST(8.0),
+    .rate_max = FIX_CONST(2.0)
+};
+
+const sensor_driver_t sensor_adc_chip_temperature = {
+    .name = "Temp. Interna",
+    .unit = "C",
+    .min_val = FIX_CONST(-20.0),
+    .max_val = FIX_CONST(85.0),
+    .anomaly_min = FIX_CONST(0.0),
+    .anomaly_max = FIX_CONST(70.0),
+    .detect = &chip_temperature_detect,
+    .read = chip_temperature_read
+};
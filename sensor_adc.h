@@ -0,0 +1,12 @@
+/**
+ * @file sensor_adc.h
+ * @brief Drivers de sensores lidos pela aquisição contínua do ADC (analog.h)
+ */
+#ifndef SENSOR_ADC_H
+#define SENSOR_ADC_H
+
+#include "sensor.h"
+
+extern const sensor_driver_t sensor_adc_chip_temperature;  ///< Sensor interno do RP2040 (canal 4)
+
+#endif // SENSOR_ADC_H
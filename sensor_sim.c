@@ -0,0 +1,139 @@
+/**
+ * @file sensor_sim.c
+ * @brief Drivers simulados de temperatura, fluxo de água e chuva
+ */
+#include "sensor_sim.h"
+#include <stdlib.h>
+#include <stddef.h>
+
+/** Sensor de chuva registrado, consultado pelo fluxo de água */
+static const sensor_t *rain_sensor = NULL;
+
+/**
+ * @brief Variação diária da temperatura por hora: 5·sen((h − 14)·π/12)
+ *
+ * Tabelada para evitar sinf() em software a cada amostra.
+ */
+static const fix_t daily_variation[24] = {
+    FIX_CONST(2.500), FIX_CONST(1.294), FIX_CONST(0.000), FIX_CONST(-1.294),
+    FIX_CONST(-2.500), FIX_CONST(-3.536), FIX_CONST(-4.330), FIX_CONST(-4.830),
+    FIX_CONST(-5.000), FIX_CONST(-4.830), FIX_CONST(-4.330), FIX_CONST(-3.536),
+    FIX_CONST(-2.500), FIX_CONST(-1.294), FIX_CONST(0.000), FIX_CONST(1.294),
+    FIX_CONST(2.500), FIX_CONST(3.536), FIX_CONST(4.330), FIX_CONST(4.830),
+    FIX_CONST(5.000), FIX_CONST(4.830), FIX_CONST(4.330), FIX_CONST(3.536)
+};
+/**
+ * @brief Acrescenta o ruído do driver e limita ao intervalo válido
+ *
+ * A variação é sorteada diretamente em unidades Q dentro de ±variation.
+ */
+static fix_t sim_finish(const sensor_t *sensor, fix_t base) {
+    const sensor_sim_config_t *config = sensor->driver->config;
+    fix_t variation = (fix_t)(rand() % (2 * config->variation + 1)) - config->variation;
+    return fix_clamp(base + variation, sensor->driver->min_val, sensor->driver->max_val);
+}
+/**
+ * @brief Valor inicial do sensor, também semeado no histórico
+ */
+static bool sim_init(sensor_t *sensor) {
+    const sensor_sim_config_t *config = sensor->driver->config;
+    sensor->value = config->initial;
+    history_push(&sensor->history, sensor->value);
+    return true;
+}
+/**
+ * @brief Temperatura: ponto médio do intervalo mais o ciclo diário
+ *
+ * A hora vem do relógio desde o boot, como time() sem RTC ajustado.
+ */
+static bool sim_temperature_read(sensor_t *sensor, uint32_t now_ms, fix_t *value) {
+    int hour = (int)((now_ms / 3600000u) % 24);
+    fix_t base = (sensor->driver->min_val + sensor->driver->max_val) / 2 + daily_variation[hour];
+    *value = sim_finish(sensor, base);
+    return true;
+}
+/**
+ * @brief Fluxo de água: só corre enquanto chove
+ */
+static bool sim_flow_read(sensor_t *sensor, uint32_t now_ms, fix_t *value) {
+    (void)now_ms;
+    bool raining = rain_sensor && rain_sensor->value > 0;
+    *value = sim_finish(sensor, raining ? FIX_FROM_INT(rand() % 20) : 0);
+    return true;
+}
+/**
+ * @brief Chuva: registra o sensor para o driver de fluxo
+ */
+static bool sim_rain_init(sensor_t *sensor) {
+    rain_sensor = sensor;
+    return sim_init(sensor);
+}
+/**
+ * @brief Chuva: 30% de chance de precipitação a cada leitura
+ */
+static bool sim_rain_read(sensor_t *sensor, uint32_t now_ms, fix_t *value) {
+    (void)now_ms;
+    fix_t base = 0;
+    if (rand() % 100 < 30) {
+        base = FIX_FROM_INT(rand() % (sensor->driver->max_val >> FIX_FRAC_BITS));
+    }
+    *value = sim_finish(sensor, base);
+    return true;
+}
+
+static const sensor_sim_config_t temperature_config = {FIX_CONST(25.0), FIX_CONST(0.5)};
+static const sensor_sim_config_t flow_config = {FIX_CONST(0.0), FIX_CONST(1.0)};
+static const sensor_sim_config_t rain_config = {FIX_CONST(0.0), FIX_CONST(5.0)};
+
+/** Pico de temperatura (z), aquecimento persistente (CUSUM) e subida rápida */
+static const anomaly_config_t temperature_detect = {
+    .ewma_shift = 4, .warmup = 16,
+    .z_limit = FIX_CONST(4.0), .sigma_min = FIX_CONST(0.25),
+    .cusum_k = FIX_CONST(0.5), .cusum_h = FIX_CONST(5.0),
+    .rate_max = FIX_CONST(2.0)
+};
+/** Fluxo bimodal (seco ou com chuva): sem z-score; cheia persistente e enxurrada */
+static const anomaly_config_t flow_detect = {
+    .ewma_shift = 3, .warmup = 8,
+    .cusum_k = FIX_CONST(5.0), .cusum_h = FIX_CONST(40.0),
+    .rate_max = FIX_CONST(18.0)
+};
+
+const sensor_driver_t sensor_sim_temperature = {
+    .name = "Temperatura",
+    .unit = "C",
+    .min_val = FIX_CONST(15.0),
+    .max_val = FIX_CONST(35.0),
+    .anomaly_min = FIX_CONST(10.0),
+    .anomaly_max = FIX_CONST(40.0),
+    .init = sim_init,
+    .detect = &temperature_detect,
+    .read = sim_temperature_read,
+    .config = &temperature_config
+};
+
+const sensor_driver_t sensor_sim_flow = {
+    .name = "Fluxo Agua",
+    .menu_name = "Fluviometro",
+    .unit = "L/min",
+    .min_val = FIX_CONST(0.0),
+    .max_val = FIX_CONST(30.0),
+    .anomaly_min = FIX_CONST(0.0),
+    .anomaly_max = FIX_CONST(25.0),
+    .init = sim_init,
+    .detect = &flow_detect,
+    .read = sim_flow_read,
+    .config = &flow_config
+};
+
+const sensor_driver_t sensor_sim_rain = {
+    .name = "Chuva",
+    .unit = "mm/h",
+    .min_val = FIX_CONST(0.0),
+    .max_val = FIX_CONST(100.0),
+    .anomaly_min = FIX_CONST(0.0),
+    .anomaly_max = FIX_CONST(80.0),
+    .init = sim_rain_init,
+    .read = sim_rain_read,
+    .config = &rain_config
+};
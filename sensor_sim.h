@@ -0,0 +1,26 @@
+/**
+ * @file sensor_sim.h
+ * @brief Drivers simulados de temperatura, fluxo de água e chuva
+ *
+ * Substituem sensores físicos durante o desenvolvimento. Cada driver
+ * gera um valor base próprio e acrescenta ruído uniforme de ±variation,
+ * limitado ao intervalo válido do sensor.
+ */
+#ifndef SENSOR_SIM_H
+#define SENSOR_SIM_H
+
+#include "sensor.h"
+
+/**
+ * @brief Parâmetros de um sensor simulado
+ */
+typedef struct {
+    fix_t initial;     ///< Valor antes da primeira amostra
+    fix_t variation;   ///< Amplitude do ruído por leitura
+} sensor_sim_config_t;
+
+extern const sensor_driver_t sensor_sim_temperature;  ///< 15-35 °C com ciclo diário
+extern const sensor_driver_t sensor_sim_flow;         ///< 0-30 L/min, só com chuva
+extern const sensor_driver_t sensor_sim_rain;         ///< 0-100 mm/h, 30% de chance
+
+#endif // SENSOR_SIM_H
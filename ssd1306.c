@@ -8,92 +8,358 @@
 #include "ssd1306.h"
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "profile.h"
 #include <string.h>
-#include <stdlib.h>
 
-// Display buffer reorganizado para páginas
-uint8_t buffer[DISPLAY_HEIGHT/8][DISPLAY_WIDTH];
+#define SSD1306_CONTROL_CMD  0x00  ///< Byte de controle: sequência de comandos
+#define SSD1306_CONTROL_DATA 0x40  ///< Byte de controle: dados para a GDDRAM
 
-/** Buffer do display organizado em páginas */
-uint8_t buffer[DISPLAY_HEIGHT/8][DISPLAY_WIDTH];
+/**
+ * @brief Quadro do display com o byte de controle adjacente aos dados
+ *
+ * O byte 0x40 fica imediatamente antes da página 0, de modo que o quadro
+ * completo (controle + 1024 bytes) sai da memória em uma única transferência
+ * DMA, sem cópia nem alocação.
+ */
+typedef struct {
+    ssd1306_cell_t control;                             ///< Sempre SSD1306_CONTROL_DATA
+    ssd1306_cell_t pages[SSD1306_PAGES][DISPLAY_WIDTH]; ///< Conteúdo em páginas
+} ssd1306_frame_t;
+
+/** Quadros duplos: um em desenho (back) e outro enviado/exibido (front) */
+static ssd1306_frame_t frames[2] = {
+    {.control = SSD1306_CONTROL_DATA},
+    {.control = SSD1306_CONTROL_DATA},
+};
+static int back_index = 0;
+
+/** Buffer do display organizado em páginas (aponta para o quadro em desenho) */
+ssd1306_cell_t (*buffer)[DISPLAY_WIDTH] = frames[0].pages;
+
+/** Indica se o quadro front reflete de fato o conteúdo do display */
+static bool display_ram_valid = false;
+
+/** Faixa de colunas alteradas por página (first > last indica página limpa) */
+static uint8_t dirty_first[SSD1306_PAGES];
+static uint8_t dirty_last[SSD1306_PAGES];
+
+/** Contadores de tráfego I2C */
+static uint32_t total_bytes = 0;
+static uint32_t frame_bytes = 0;
+static uint32_t bus_errors = 0;
+static uint32_t frames_sent = 0;
+static uint32_t unchanged_flushes = 0;
+
+/** Estado do barramento: clock atual, erros em Fast-mode Plus e recuo pendente */
+static ssd1306_bus_info_t bus_info = {.bus_hz = SSD1306_I2C_HZ};
+static uint32_t fast_errors = 0;
+static bool fallback_pending = false;
+
+/** Linha inicial do display e se ela ainda precisa ser enviada */
+static uint8_t start_line = 0;
+static bool start_line_pending = false;
+
+/** Sequência de inicialização, enviada em uma única transação */
+static const uint8_t init_sequence[] = {
+    0xAE,        // Display off
+    0xD5, 0x80,  // Set display clock
+    0xA8, 0x3F,  // Set multiplex: 1/64 duty
+    0xD3, 0x00,  // Set display offset: no offset
+    0x40,        // Start line address
+    0x8D, 0x14,  // Charge pump: enable
+    0x20, 0x00,  // Memory mode: horizontal addressing
+    0xA1,        // Segment remap
+    0xC8,        // COM scan direction
+    0xDA, 0x12,  // COM pins
+    0x81, 0xCF,  // Contrast: maximum
+    0xD9, 0xF1,  // Pre-charge period
+    0xDB, 0x30,  // VCOMH deselect level
+    0xA4,        // Display all on resume
+    0xA6,        // Normal display
+    0xAF,        // Display on
+};
+
+/**
+ * @brief Bloco de controle da DMA (formato dos registradores alias 3)
+ *
+ * O canal de controle escreve cada bloco em TRANS_COUNT e READ_ADDR_TRIG
+ * do canal de dados; um bloco nulo encerra a cadeia. A origem é guardada
+ * como endereço de barramento (32 bits), o formato do registrador, para
+ * que o bloco tenha 8 bytes também fora do RP2040 (compilação no host).
+ */
+typedef struct {
+    uint32_t count;      ///< Palavras de 16 bits a transferir
+    uint32_t read_addr;  ///< Endereço de origem das palavras (0 encerra)
+} ssd1306_dma_block_t;
+
+/** Endereço de barramento de um ponteiro */
+#define SSD1306_BUS_ADDR(p) ((uint32_t)(uintptr_t)(p))
+
+/** Comandos de endereçamento de uma janela + byte de controle de dados */
+#define SSD1306_WINDOW_CMD_WORDS 8
+
+static ssd1306_cell_t window_cmds[SSD1306_MAX_WINDOWS][SSD1306_WINDOW_CMD_WORDS];
+static ssd1306_cell_t window_tails[SSD1306_MAX_WINDOWS];
+static ssd1306_cell_t start_line_cmd[2];  ///< Controle + 0x40|linha com STOP
+static ssd1306_dma_block_t dma_blocks[SSD1306_MAX_WINDOWS * 3 + 2];
+static int dma_data_chan = -1;
+static int dma_ctrl_chan = -1;
+static bool dma_active = false;
+
+/**
+ * @brief Índice do quadro front (último enviado ao display)
+ */
+static inline int front_index(void) {
+    return back_index ^ 1;
+}
+/**
+ * @brief Contabiliza um erro de barramento
+ *
+ * Acima de 400 kHz, SSD1306_FAST_MAX_ERRORS erros agendam o recuo para
+ * SSD1306_I2C_HZ, aplicado com o barramento livre.
+ */
+static void ssd1306_bus_error(void) {
+    bus_errors++;
+    display_ram_valid = false;
+    start_line_pending = start_line != 0;
+    if (bus_info.bus_hz > SSD1306_I2C_HZ && ++fast_errors >= SSD1306_FAST_MAX_ERRORS) {
+        fallback_pending = true;
+    }
+}
+/**
+ * @brief Reconfigura o I2C em SSD1306_I2C_HZ
+ *
+ * i2c_init() reinicia o controlador; o endereço do display é regravado
+ * em IC_TAR a cada envio.
+ */
+static void ssd1306_fall_back(void) {
+    bus_info.bus_hz = i2c_init(I2C_PORT, SSD1306_I2C_HZ);
+    bus_info.fallbacks++;
+    fallback_pending = false;
+    fast_errors = 0;
+}
+/**
+ * @brief Verifica e limpa abortos de transmissão no barramento I2C
+ *
+ * Um NACK ou perda de arbitragem descarta o restante da FIFO; o conteúdo
+ * do display passa a ser desconhecido e o próximo envio será completo.
+ */
+static void ssd1306_check_abort(void) {
+    i2c_hw_t *hw = i2c_get_hw(I2C_PORT);
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        (void)hw->clr_tx_abrt;
+        ssd1306_bus_error();
+    }
+}
+/**
+ * @brief Verifica se ainda há transferência para o display em andamento
+ *
+ * @return true enquanto a DMA ou a FIFO do I2C estiverem ocupadas
+ */
+bool ssd1306_flush_busy() {
+    if (!dma_active) return false;
+
+    if (dma_channel_is_busy(dma_data_chan) || dma_channel_is_busy(dma_ctrl_chan)) return true;
+
+    i2c_hw_t *hw = i2c_get_hw(I2C_PORT);
+    if (!(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS)) {
+        return true;
+    }
 
+    dma_active = false;
+    ssd1306_check_abort();
+    return false;
+}
+/**
+ * @brief Aguarda o término da transferência em andamento
+ */
+void ssd1306_flush_wait() {
+    while (ssd1306_flush_busy()) {
+        tight_loop_contents();
+    }
+}
+/**
+ * @brief Envia uma sequência de comandos em uma transação
+ *
+ * Um único byte de controle 0x00 precede todos os comandos; sequências
+ * maiores que SSD1306_MAX_COMMANDS são divididas em transações.
+ *
+ * @param cmds Comandos e argumentos
+ * @param len Quantidade de bytes
+ * @return false se o display não respondeu
+ */
+bool ssd1306_send_commands(const uint8_t *cmds, size_t len) {
+    static uint8_t tx_buffer[1 + SSD1306_MAX_COMMANDS] = {SSD1306_CONTROL_CMD};
+    bool ok = true;
+
+    ssd1306_flush_wait();
+    while (len > 0) {
+        size_t chunk = len > SSD1306_MAX_COMMANDS ? SSD1306_MAX_COMMANDS : len;
+        memcpy(tx_buffer + 1, cmds, chunk);
+        if (i2c_write_blocking(I2C_PORT, endereco, tx_buffer, chunk + 1, false) < 0) {
+            ssd1306_bus_error();
+            ok = false;
+        }
+        total_bytes += chunk + 1;
+        bus_info.transactions++;
+        cmds += chunk;
+        len -= chunk;
+    }
+    return ok;
+}
 /**
  * @brief Envia comando para o display
  * @param cmd Byte de comando a ser enviado
  */
 void ssd1306_send_command(uint8_t cmd) {
-    uint8_t buf[2] = {0x00, cmd};  // 0x00 indica comando
-    i2c_write_blocking(I2C_PORT, endereco, buf, 2, false);
+    ssd1306_send_commands(&cmd, 1);
 }
 /**
  * @brief Envia dados para o display
+ *
+ * Usa um buffer estático com o byte de controle na primeira posição, em
+ * blocos de até uma página; com endereçamento horizontal os blocos
+ * continuam de onde o anterior parou. O framebuffer não passa por aqui:
+ * ele é enviado por DMA em ssd1306_flush_async.
+ *
  * @param data Ponteiro para os dados
  * @param len Quantidade de bytes a enviar
  */
 void ssd1306_send_data(uint8_t *data, size_t len) {
-    // Primeiro byte 0x40 indica dados
-    uint8_t *temp_buffer = malloc(len + 1);
-    temp_buffer[0] = 0x40;
-    memcpy(temp_buffer + 1, data, len);
-    i2c_write_blocking(I2C_PORT, endereco, temp_buffer, len + 1, false);
-    free(temp_buffer);
+    static uint8_t tx_buffer[1 + DISPLAY_WIDTH] = {SSD1306_CONTROL_DATA};
+
+    ssd1306_flush_wait();
+    while (len > 0) {
+        size_t chunk = len > DISPLAY_WIDTH ? DISPLAY_WIDTH : len;
+        memcpy(tx_buffer + 1, data, chunk);
+        if (i2c_write_blocking(I2C_PORT, endereco, tx_buffer, chunk + 1, false) < 0) ssd1306_bus_error();
+        total_bytes += chunk + 1;
+        bus_info.transactions++;
+        data += chunk;
+        len -= chunk;
+    }
+}
+/**
+ * @brief Configura os canais DMA usados no envio do framebuffer
+ *
+ * Canal de dados: palavras de 16 bits para IC_DATA_CMD, ritmado pelo DREQ
+ * de TX do I2C. Canal de controle: recarrega o canal de dados a partir de
+ * dma_blocks (técnica de blocos de controle), permitindo enviar várias
+ * janelas numa única cadeia sem intervenção da CPU.
+ */
+static void ssd1306_dma_init(void) {
+    dma_data_chan = dma_claim_unused_channel(true);
+    dma_ctrl_chan = dma_claim_unused_channel(true);
+
+    dma_channel_config c = dma_channel_get_default_config(dma_data_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(I2C_PORT, true));
+    channel_config_set_chain_to(&c, dma_ctrl_chan);
+    channel_config_set_irq_quiet(&c, true);
+    dma_channel_configure(dma_data_chan, &c, &i2c_get_hw(I2C_PORT)->data_cmd, NULL, 0, false);
+
+    c = dma_channel_get_default_config(dma_ctrl_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, 3);  // Alterna entre TRANS_COUNT e READ_ADDR_TRIG
+    dma_channel_configure(dma_ctrl_chan, &c, &dma_hw->ch[dma_data_chan].al3_transfer_count,
+                          dma_blocks, 2, false);
 }
 /**
  * @brief Inicializa o display OLED
  * 
- * Configura I2C e envia sequência de inicialização:
+ * Configura I2C e envia sequência de inicialização em uma transação:
  * - Configura clock e multiplexação
  * - Ativa charge pump
  * - Define modo de endereçamento horizontal
  * - Configura contraste e níveis de tensão
+ *
+ * Com MONITOR_I2C_FAST_PLUS tenta 1 MHz e recua para 400 kHz se o
+ * display não responder à sequência.
  */
 void ssd1306_init() {
     sleep_ms(100);  // Aguarda inicialização do display
+    uint64_t start_us = time_us_64();
+    uint32_t start_bytes = total_bytes;
+    uint32_t start_transactions = bus_info.transactions;
   
     // Inicializa I2C
-    i2c_init(I2C_PORT, 400 * 1000);
+#if MONITOR_I2C_FAST_PLUS
+    bus_info.bus_hz = i2c_init(I2C_PORT, SSD1306_I2C_FAST_HZ);
+#else
+    bus_info.bus_hz = i2c_init(I2C_PORT, SSD1306_I2C_HZ);
+#endif
     gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
     gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
     gpio_pull_up(I2C_SDA);
     gpio_pull_up(I2C_SCL);
+    ssd1306_dma_init();
 
-    // Sequência de inicialização do display
-    ssd1306_send_command(0xAE);  // Display off
-    ssd1306_send_command(0xD5);  // Set display clock
-    ssd1306_send_command(0x80);
-    ssd1306_send_command(0xA8);  // Set multiplex
-    ssd1306_send_command(0x3F);  // 1/64 duty
-    ssd1306_send_command(0xD3);  // Set display offset
-    ssd1306_send_command(0x00);  // No offset
-    ssd1306_send_command(0x40);  // Start line address
-    ssd1306_send_command(0x8D);  // Charge pump
-    ssd1306_send_command(0x14);  // Enable charge pump
-    ssd1306_send_command(0x20);  // Memory mode
-    ssd1306_send_command(0x00);  // Horizontal addressing
-    ssd1306_send_command(0xA1);  // Segment remap
-    ssd1306_send_command(0xC8);  // COM scan direction
-    ssd1306_send_command(0xDA);  // COM pins
-    ssd1306_send_command(0x12);
-    ssd1306_send_command(0x81);  // Contrast
-    ssd1306_send_command(0xCF);  // Maximum
-    ssd1306_send_command(0xD9);  // Pre-charge period
-    ssd1306_send_command(0xF1);
-    ssd1306_send_command(0xDB);  // VCOMH deselect level
-    ssd1306_send_command(0x30);
-    ssd1306_send_command(0xA4);  // Display all on resume
-    ssd1306_send_command(0xA6);  // Normal display
-    ssd1306_send_command(0xAF);  // Display on
+    if (!ssd1306_send_commands(init_sequence, sizeof(init_sequence)) && bus_info.bus_hz > SSD1306_I2C_HZ) {
+        ssd1306_fall_back();
+        ssd1306_send_commands(init_sequence, sizeof(init_sequence));
+    }
 
     ssd1306_clear();
+    ssd1306_invalidate();
     ssd1306_update();
+
+    bus_info.init_us = (uint32_t)(time_us_64() - start_us);
+    bus_info.init_bytes = total_bytes - start_bytes;
+    bus_info.init_transactions = bus_info.transactions - start_transactions;
 }
 /**
  * @brief Limpa o buffer do display
  * 
- * Preenche todo o buffer com zeros
+ * Preenche todo o buffer com zeros e marca todas as páginas como
+ * alteradas; o envio posterior descarta o que já estava apagado.
  */
 void ssd1306_clear() {
-    memset(buffer, 0, sizeof(buffer));
+    memset(buffer, 0, sizeof(frames[0].pages));
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        ssd1306_mark_dirty(page, 0, DISPLAY_WIDTH - 1);
+    }
+}
+/**
+ * @brief Marca uma faixa de colunas de uma página como alterada
+ *
+ * @param page Página (0-7)
+ * @param x0 Coluna inicial (0-127)
+ * @param x1 Coluna final (0-127)
+ */
+void ssd1306_mark_dirty(uint8_t page, uint8_t x0, uint8_t x1) {
+    if (page >= SSD1306_PAGES || x0 > x1) return;
+    if (x1 >= DISPLAY_WIDTH) x1 = DISPLAY_WIDTH - 1;
+
+    if (dirty_first[page] > dirty_last[page]) {
+        dirty_first[page] = x0;
+        dirty_last[page] = x1;
+    } else {
+        if (x0 < dirty_first[page]) dirty_first[page] = x0;
+        if (x1 > dirty_last[page]) dirty_last[page] = x1;
+    }
+}
+/**
+ * @brief Define a linha exibida no topo, enviada com o próximo quadro
+ */
+void ssd1306_set_start_line(uint8_t line) {
+    line &= 0x3F;
+    if (line == start_line) return;
+    start_line = line;
+    start_line_pending = true;
+}
+/**
+ * @brief Força o reenvio completo do buffer na próxima atualização
+ */
+void ssd1306_invalidate() {
+    display_ram_valid = false;
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        ssd1306_mark_dirty(page, 0, DISPLAY_WIDTH - 1);
+    }
 }
 /**
  * @brief Desenha um pixel no buffer
@@ -110,10 +376,12 @@ void ssd1306_draw_pixel(int x, int y, bool color) {
     uint8_t page = y / 8;
     uint8_t bit = y % 8;
 
-    if (color) {
-        buffer[page][x] |= (1 << bit);
-    } else {
-        buffer[page][x] &= ~(1 << bit);
+    uint8_t old_byte = buffer[page][x];
+    uint8_t new_byte = color ? (old_byte | (1 << bit)) : (old_byte & ~(1 << bit));
+
+    if (new_byte != old_byte) {
+        buffer[page][x] = new_byte;
+        ssd1306_mark_dirty(page, x, x);
     }
 }
 /**
@@ -123,9 +391,8 @@ void ssd1306_draw_pixel(int x, int y, bool color) {
  * @param end Página final (0-7)
  */
 void ssd1306_set_page_address(uint8_t start, uint8_t end) {
-    ssd1306_send_command(0x22);  // Page address command
-    ssd1306_send_command(start & 0x07);
-    ssd1306_send_command(end & 0x07);
+    const uint8_t cmds[] = {0x22, start & 0x07, end & 0x07};  // Page address command
+    ssd1306_send_commands(cmds, sizeof(cmds));
 }
 /**
  * @brief Define endereço das colunas
@@ -134,22 +401,244 @@ void ssd1306_set_page_address(uint8_t start, uint8_t end) {
  * @param end Coluna final (0-127)
  */
 void ssd1306_set_column_address(uint8_t start, uint8_t end) {
-    ssd1306_send_command(0x21);  // Column address command
-    ssd1306_send_command(start & 0x7F);
-    ssd1306_send_command(end & 0x7F);
+    const uint8_t cmds[] = {0x21, start & 0x7F, end & 0x7F};  // Column address command
+    ssd1306_send_commands(cmds, sizeof(cmds));
+}
+/**
+ * @brief Acrescenta uma janela de uma página à cadeia de DMA
+ *
+ * Cada janela vira até três blocos: comandos de endereçamento seguidos do
+ * byte 0x40, as colunas lidas diretamente do quadro e a última coluna com
+ * o bit STOP (única palavra copiada).
+ *
+ * @param frame Quadro de origem
+ * @param window Índice da janela
+ * @param block Próximo bloco livre em dma_blocks
+ * @param page Página (0-7)
+ * @param x0 Coluna inicial
+ * @param x1 Coluna final
+ * @return Próximo bloco livre
+ */
+static int ssd1306_add_window(ssd1306_frame_t *frame, int window, int block,
+                              uint8_t page, uint8_t x0, uint8_t x1) {
+    ssd1306_cell_t *cmd = window_cmds[window];
+    cmd[0] = SSD1306_CONTROL_CMD;
+    cmd[1] = 0x22;  // Page address
+    cmd[2] = page;
+    cmd[3] = page;
+    cmd[4] = 0x21;  // Column address
+    cmd[5] = x0;
+    cmd[6] = x1 | I2C_IC_DATA_CMD_STOP_BITS;
+    cmd[7] = SSD1306_CONTROL_DATA;
+
+    dma_blocks[block].count = SSD1306_WINDOW_CMD_WORDS;
+    dma_blocks[block++].read_addr = SSD1306_BUS_ADDR(cmd);
+
+    if (x1 > x0) {
+        dma_blocks[block].count = x1 - x0;
+        dma_blocks[block++].read_addr = SSD1306_BUS_ADDR(&frame->pages[page][x0]);
+    }
+
+    window_tails[window] = frame->pages[page][x1] | I2C_IC_DATA_CMD_STOP_BITS;
+    dma_blocks[block].count = 1;
+    dma_blocks[block++].read_addr = SSD1306_BUS_ADDR(&window_tails[window]);
+
+    frame_bytes += SSD1306_WINDOW_CMD_WORDS + (x1 - x0 + 1);
+    return block;
+}
+/**
+ * @brief Monta a cadeia para o quadro completo
+ *
+ * Usa o byte de controle adjacente à página 0: comandos de endereçamento
+ * da tela inteira, 1024 palavras a partir de frame->control e a última
+ * coluna com STOP.
+ *
+ * @param frame Quadro de origem
+ * @return Próximo bloco livre
+ */
+static int ssd1306_add_full_frame(ssd1306_frame_t *frame) {
+    ssd1306_cell_t *cmd = window_cmds[0];
+    cmd[0] = SSD1306_CONTROL_CMD;
+    cmd[1] = 0x22;
+    cmd[2] = 0;
+    cmd[3] = SSD1306_PAGES - 1;
+    cmd[4] = 0x21;
+    cmd[5] = 0;
+    cmd[6] = (DISPLAY_WIDTH - 1) | I2C_IC_DATA_CMD_STOP_BITS;
+
+    dma_blocks[0].count = SSD1306_WINDOW_CMD_WORDS - 1;
+    dma_blocks[0].read_addr = SSD1306_BUS_ADDR(cmd);
+    dma_blocks[1].count = 1 + SSD1306_PAGES * DISPLAY_WIDTH - 1;
+    dma_blocks[1].read_addr = SSD1306_BUS_ADDR(&frame->control);
+    window_tails[0] = frame->pages[SSD1306_PAGES - 1][DISPLAY_WIDTH - 1] | I2C_IC_DATA_CMD_STOP_BITS;
+    dma_blocks[2].count = 1;
+    dma_blocks[2].read_addr = SSD1306_BUS_ADDR(&window_tails[0]);
+
+    frame_bytes = SSD1306_FULL_FRAME_BYTES;
+    return 3;
+}
+/**
+ * @brief Inicia o envio assíncrono do quadro em desenho
+ *
+ * Compara as faixas marcadas como alteradas com o quadro front (conteúdo
+ * atual do display) e monta uma cadeia de DMA com apenas as janelas que
+ * diferem. Trechos separados por menos de SSD1306_WINDOW_GAP colunas
+ * iguais são agrupados, pois reendereçar custaria mais que reenviar.
+ * Em seguida os quadros são trocados: o desenho continua em uma cópia
+ * enquanto o quadro enviado sai pelo barramento.
+ *
+ * @return false se um envio anterior ainda estiver em andamento
+ */
+bool ssd1306_flush_async() {
+    if (ssd1306_flush_busy()) return false;
+    PROFILE_BEGIN(start_us);
+    if (fallback_pending) ssd1306_fall_back();
+
+    ssd1306_frame_t *back = &frames[back_index];
+    ssd1306_frame_t *front = &frames[front_index()];
+    int window = 0;
+    int block = 0;
+    bool overflow = false;
+
+    frame_bytes = 0;
+
+    for (int page = 0; page < SSD1306_PAGES && display_ram_valid && !overflow; page++) {
+        int first = dirty_first[page];
+        int last = dirty_last[page];
+        if (first > last) continue;
+
+        int x = first;
+        while (x <= last) {
+            // Procura o início do próximo trecho alterado
+            while (x <= last && back->pages[page][x] == front->pages[page][x]) x++;
+            if (x > last) break;
+
+            int window_start = x;
+            int window_end = x;
+            int equal_run = 0;
+            for (x++; x <= last; x++) {
+                if (back->pages[page][x] != front->pages[page][x]) {
+                    window_end = x;
+                    equal_run = 0;
+                } else if (++equal_run >= SSD1306_WINDOW_GAP) {
+                    break;
+                }
+            }
+
+            if (window == SSD1306_MAX_WINDOWS) {
+                overflow = true;
+                break;
+            }
+            block = ssd1306_add_window(back, window++, block, page, window_start, window_end);
+        }
+    }
+
+    // Conteúdo do display desconhecido ou alterações demais: quadro completo
+    if (!display_ram_valid || overflow) {
+        block = ssd1306_add_full_frame(back);
+        window = 1;
+    }
+
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        dirty_first[page] = DISPLAY_WIDTH - 1;
+        dirty_last[page] = 0;
+    }
+
+    // Linha inicial: um comando depois dos dados, na mesma cadeia
+    bool send_start_line = start_line_pending;
+    if (send_start_line) {
+        start_line_cmd[0] = SSD1306_CONTROL_CMD;
+        start_line_cmd[1] = (0x40 | start_line) | I2C_IC_DATA_CMD_STOP_BITS;
+        dma_blocks[block].count = 2;
+        dma_blocks[block++].read_addr = SSD1306_BUS_ADDR(start_line_cmd);
+        frame_bytes += 2;
+        start_line_pending = false;
+    }
+
+    if (window == 0 && !send_start_line) {
+        unchanged_flushes++;
+        PROFILE_END(PROFILE_DISPLAY_FLUSH, start_us);
+        return true;  // Nada mudou desde o último envio
+    }
+
+    dma_blocks[block].count = 0;
+    dma_blocks[block].read_addr = 0;
+    total_bytes += frame_bytes;
+    frames_sent++;
+    bus_info.transactions += 2 * window + (send_start_line ? 1 : 0);  // Janelas (endereçamento + dados) e linha inicial
+    display_ram_valid = true;
+
+    // Garante o endereço do display em IC_TAR (i2c_init o restaura ao padrão)
+    i2c_hw_t *hw = i2c_get_hw(I2C_PORT);
+    hw->enable = 0;
+    hw->tar = endereco;
+    hw->enable = 1;
+
+    dma_active = true;
+    dma_channel_set_read_addr(dma_ctrl_chan, dma_blocks, true);
+
+    // O quadro enviado passa a ser o front; o desenho segue numa cópia dele
+    back_index = front_index();
+    buffer = frames[back_index].pages;
+    memcpy(frames[back_index].pages, back->pages, sizeof(back->pages));
+    PROFILE_END(PROFILE_DISPLAY_FLUSH, start_us);
+    return true;
 }
 /**
  * @brief Atualiza o display com o conteúdo do buffer
  * 
- * Envia o buffer completo para o display página por página
+ * Versão bloqueante de ssd1306_flush_async: envia somente as janelas
+ * alteradas e aguarda o fim da transferência.
  */
 void ssd1306_update() {
-    // Define o endereço inicial
-    ssd1306_set_page_address(0, 7);
-    ssd1306_set_column_address(0, DISPLAY_WIDTH-1);
-    
-    // Envia o buffer página por página
-    for (int page = 0; page < DISPLAY_HEIGHT/8; page++) {
-        ssd1306_send_data(buffer[page], DISPLAY_WIDTH);
-    }
-}
\ No newline at end of file
+    PROFILE_BEGIN(start_us);
+    ssd1306_flush_wait();
+    ssd1306_flush_async();
+    ssd1306_flush_wait();
+    PROFILE_END(PROFILE_DISPLAY_UPDATE, start_us);
+}
+/**
+ * @brief Bytes enviados na última atualização do display
+ * @return Quantidade de bytes
+ */
+uint32_t ssd1306_get_frame_bytes() {
+    return frame_bytes;
+}
+/**
+ * @brief Total de bytes enviados ao display desde a inicialização
+ * @return Quantidade acumulada de bytes
+ */
+uint32_t ssd1306_get_total_bytes() {
+    return total_bytes;
+}
+/**
+ * @brief Quantidade de abortos de transmissão detectados no I2C
+ * @return Total de erros de barramento
+ */
+uint32_t ssd1306_get_bus_errors() {
+    return bus_errors;
+}
+/**
+ * @brief Envios que transmitiram ao menos uma janela
+ */
+uint32_t ssd1306_get_frames() {
+    return frames_sent;
+}
+/**
+ * @brief Envios descartados por não haver diferença para o display
+ */
+uint32_t ssd1306_get_unchanged_flushes() {
+    return unchanged_flushes;
+}
+/**
+ * @brief Tempo estimado no barramento: 9 ciclos de SCL por byte
+ */
+uint32_t ssd1306_bus_time_us(uint32_t bytes) {
+    return (uint32_t)((uint64_t)bytes * 9 * 1000000 / bus_info.bus_hz);
+}
+/**
+ * @brief Clock atual, recuos e custo da inicialização
+ */
+void ssd1306_get_bus_info(ssd1306_bus_info_t *info) {
+    *info = bus_info;
+}
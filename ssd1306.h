@@ -18,18 +18,67 @@
  */
 #define DISPLAY_WIDTH 128
 #define DISPLAY_HEIGHT 64
+#define SSD1306_PAGES (DISPLAY_HEIGHT/8)  ///< Páginas de 8 linhas na GDDRAM
+
+/**
+ * @brief Menor intervalo de colunas inalteradas que divide uma janela de envio
+ *
+ * Cada janela extra custa 6 comandos (12 bytes no barramento); trechos
+ * inalterados menores que isso são enviados junto com a janela vizinha.
+ */
+#define SSD1306_WINDOW_GAP 12
+
+/**
+ * @brief Máximo de janelas por envio assíncrono
+ *
+ * Acima disso o quadro completo é enviado em uma única transferência.
+ */
+#define SSD1306_MAX_WINDOWS 24
 
 // I2C configuração
 /** @defgroup I2CConfig Configurações I2C
  * @{
  */
+#define SSD1306_I2C_HZ (400 * 1000)        ///< Clock do barramento I2C (Fast-mode)
+#define SSD1306_I2C_FAST_HZ (1000 * 1000)  ///< Fast-mode Plus, com MONITOR_I2C_FAST_PLUS
+#define SSD1306_FAST_MAX_ERRORS 3          ///< Erros em Fast-mode Plus antes do recuo para 400 kHz
+#define SSD1306_MAX_COMMANDS 32            ///< Comandos por transação em ssd1306_send_commands
 #define I2C_PORT i2c1
 #define I2C_SDA 14
 #define I2C_SCL 15
 #define endereco 0x3C
 
+/**
+ * @brief Bytes de um quadro completo no barramento
+ *
+ * Endereçamento da tela inteira (7 bytes), byte de controle e 1024 bytes
+ * de dados.
+ */
+#define SSD1306_FULL_FRAME_BYTES (8 + SSD1306_PAGES * DISPLAY_WIDTH)
+
+/**
+ * @brief Célula do framebuffer
+ *
+ * Bits 0-7 contêm a coluna de 8 pixels da página; a célula tem o formato
+ * do registrador IC_DATA_CMD do I2C, para que a DMA envie o quadro
+ * diretamente da memória. Apenas os bits 0-7 devem ser escritos.
+ */
+typedef uint16_t ssd1306_cell_t;
+
+/**
+ * @brief Estado do barramento e custo da inicialização
+ */
+typedef struct {
+    uint32_t bus_hz;             ///< Clock atual do I2C
+    uint32_t fallbacks;          ///< Recuos de Fast-mode Plus para 400 kHz
+    uint32_t transactions;       ///< Transações I2C desde a inicialização
+    uint32_t init_us;            ///< Duração de ssd1306_init (sem a espera de power-on)
+    uint32_t init_bytes;         ///< Bytes enviados na inicialização (comandos + quadro)
+    uint32_t init_transactions;  ///< Transações da inicialização
+} ssd1306_bus_info_t;
+
 // Display buffer
-extern uint8_t buffer[DISPLAY_HEIGHT/8][DISPLAY_WIDTH];  // Reorganizado para páginas
+extern ssd1306_cell_t (*buffer)[DISPLAY_WIDTH];  // Quadro em desenho, reorganizado para páginas
 
 // Declaração de funções
 /**
@@ -37,6 +86,16 @@ extern uint8_t buffer[DISPLAY_HEIGHT/8][DISPLAY_WIDTH];  // Reorganizado para p
  * @param cmd Byte de comando
  */
 void ssd1306_send_command(uint8_t cmd);
+/**
+ * @brief Envia uma sequência de comandos em uma única transação
+ *
+ * Um byte de controle 0x00 seguido de todos os comandos e argumentos, em
+ * vez de START/endereço/STOP por byte.
+ * @param cmds Comandos e argumentos
+ * @param len Quantidade de bytes
+ * @return false se o display não respondeu
+ */
+bool ssd1306_send_commands(const uint8_t *cmds, size_t len);
 /**
  * @brief Envia dados para o display
  * @param data Ponteiro para dados
@@ -61,9 +120,103 @@ void ssd1306_draw_pixel(int x, int y, bool color);
 
 /**
  * @brief Atualiza o display com o buffer
+ *
+ * Envia apenas as janelas (página + faixa de colunas) marcadas como
+ * alteradas e cujo conteúdo difere do que já está no display.
  */
 void ssd1306_update(void);
 
+/**
+ * @brief Inicia o envio assíncrono das alterações via DMA
+ *
+ * Retorna imediatamente; o desenho continua em outro quadro enquanto o
+ * anterior é transmitido.
+ * @return false se um envio anterior ainda estiver em andamento
+ */
+bool ssd1306_flush_async(void);
+
+/**
+ * @brief Verifica se há envio para o display em andamento
+ * @return true enquanto a transferência não terminar
+ */
+bool ssd1306_flush_busy(void);
+
+/**
+ * @brief Aguarda o término do envio em andamento
+ */
+void ssd1306_flush_wait(void);
+
+/**
+ * @brief Marca uma faixa de colunas de uma página como alterada
+ *
+ * Deve ser chamada por quem escreve diretamente em buffer[][].
+ * @param page Página (0-7)
+ * @param x0 Coluna inicial (0-127)
+ * @param x1 Coluna final (0-127)
+ */
+void ssd1306_mark_dirty(uint8_t page, uint8_t x0, uint8_t x1);
+
+/**
+ * @brief Define a linha da GDDRAM exibida no topo da tela (comando 0x40-0x7F)
+ *
+ * O comando é acrescentado ao fim do próximo envio, depois das janelas
+ * de dados, e a linha vale até ser trocada. Com linha inicial diferente
+ * de 0 a página p aparece deslocada na tela, em anel.
+ * @param line Linha (0-63)
+ */
+void ssd1306_set_start_line(uint8_t line);
+
+/**
+ * @brief Força o reenvio completo do buffer na próxima atualização
+ *
+ * Usado quando o conteúdo da GDDRAM do display é desconhecido
+ * (após inicialização ou reset do controlador).
+ */
+void ssd1306_invalidate(void);
+
+/**
+ * @brief Bytes enviados pelo barramento I2C na última chamada a ssd1306_update
+ * @return Quantidade de bytes (comandos + dados, incluindo bytes de controle)
+ */
+uint32_t ssd1306_get_frame_bytes(void);
+
+/**
+ * @brief Total de bytes enviados ao display desde a inicialização
+ * @return Quantidade acumulada de bytes
+ */
+uint32_t ssd1306_get_total_bytes(void);
+
+/**
+ * @brief Envios que transmitiram ao menos uma janela
+ */
+uint32_t ssd1306_get_frames(void);
+
+/**
+ * @brief Envios descartados por não haver diferença para o display
+ */
+uint32_t ssd1306_get_unchanged_flushes(void);
+
+/**
+ * @brief Tempo estimado no barramento para uma quantidade de bytes
+ *
+ * Nove ciclos de SCL por byte (8 bits + ACK) no clock configurado.
+ * @param bytes Bytes transmitidos
+ * @return Tempo em microssegundos
+ */
+uint32_t ssd1306_bus_time_us(uint32_t bytes);
+
+/**
+ * @brief Clock atual, recuos e custo da inicialização
+ * @param info Destino
+ */
+void ssd1306_get_bus_info(ssd1306_bus_info_t *info);
+
+/**
+ * @brief Quantidade de abortos de transmissão detectados no I2C
+ * @return Total de erros de barramento
+ */
+uint32_t ssd1306_get_bus_errors(void);
+
 /**
  * @brief Define endereço das páginas
  * @param start Página inicial (0-7)
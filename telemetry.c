@@ -0,0 +1,127 @@
+/**
+ * @file telemetry.c
+ * @brief Telemetria binária compacta pela serial
+ *
+ * A serialização é feita byte a byte (little-endian explícito), sem
+ * depender do layout de structs nem de printf. O quadro é entregue ao
+ * stdio de uma vez, sem a tradução de '\n' para "\r\n", que corromperia
+ * o COBS.
+ */
+#include "telemetry.h"
+#include "pico/stdlib.h"
+#include "pico/stdio.h"
+
+#ifndef MONITOR_TELEMETRY_BINARY
+#define MONITOR_TELEMETRY_BINARY 0  ///< 1 = inicia no modo binário
+#endif
+
+static telemetry_mode_t mode = MONITOR_TELEMETRY_BINARY ? TELEMETRY_MODE_BINARY : TELEMETRY_MODE_TEXT;
+static uint16_t sequence = 0;
+static uint32_t bytes_sent = 0;
+
+static inline uint8_t *put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+static inline uint8_t *put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+/**
+ * @brief CRC-16/CCITT-FALSE (polinômio 0x1021, valor inicial 0xFFFF)
+ */
+uint16_t telemetry_crc16(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+/**
+ * @brief Codifica um bloco em COBS (sem o delimitador final)
+ *
+ * Cada byte de código indica a distância até o próximo zero (ou 0xFF
+ * para um bloco de 254 bytes não nulos sem zero implícito).
+ */
+size_t telemetry_cobs_encode(const uint8_t *in, size_t len, uint8_t *out) {
+    size_t code_pos = 0;
+    size_t out_pos = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            out[code_pos] = code;
+            code_pos = out_pos++;
+            code = 1;
+            continue;
+        }
+        out[out_pos++] = in[i];
+        if (++code == 0xFF) {
+            out[code_pos] = code;
+            code_pos = out_pos++;
+            code = 1;
+        }
+    }
+    out[code_pos] = code;
+    return out_pos;
+}
+/**
+ * @brief Serializa um registro em um quadro pronto para envio
+ */
+size_t telemetry_build_frame(const telemetry_record_t *record, uint8_t *frame) {
+    uint8_t raw[TELEMETRY_MAX_RECORD];
+    uint8_t *p = raw;
+
+    *p++ = TELEMETRY_VERSION;
+    p = put_u16(p, sequence++);
+    p = put_u32(p, record->timestamp_ms);
+    p = put_u16(p, record->sensor_mask);
+    p = put_u16(p, record->anomaly_mask);
+    *p++ = record->alerts;
+    for (int i = 0; i < TELEMETRY_MAX_SENSORS; i++) {
+        if (!(record->sensor_mask & (1u << i))) continue;
+        p = put_u16(p, (uint16_t)record->value[i]);
+        p = put_u16(p, (uint16_t)record->mean[i]);
+    }
+    p = put_u16(p, telemetry_crc16(raw, (size_t)(p - raw)));
+
+    size_t len = 0;
+    frame[len++] = 0x00;
+    len += telemetry_cobs_encode(raw, (size_t)(p - raw), &frame[len]);
+    frame[len++] = 0x00;
+    return len;
+}
+/**
+ * @brief Serializa e envia um registro pela saída padrão
+ */
+void telemetry_send(const telemetry_record_t *record) {
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    size_t len = telemetry_build_frame(record, frame);
+    stdio_put_string((const char *)frame, (int)len, false, false);
+    bytes_sent += len;
+}
+/**
+ * @brief Formato atual da saída serial
+ */
+telemetry_mode_t telemetry_get_mode() {
+    return mode;
+}
+/**
+ * @brief Seleciona o formato da saída serial
+ */
+void telemetry_set_mode(telemetry_mode_t new_mode) {
+    mode = new_mode;
+}
+/**
+ * @brief Bytes enviados em registros binários desde o boot
+ */
+uint32_t telemetry_get_bytes_sent() {
+    return bytes_sent;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file telemetry.h
+ * @brief Telemetria binária compacta pela serial
+ *
+ * Cada registro é serializado em little-endian, recebe um CRC-16 e é
+ * codificado em COBS, de modo que o byte 0x00 só aparece como delimitador
+ * de quadro. Formato do registro (antes do COBS):
+ *
+ *   versão      u8   TELEMETRY_VERSION
+ *   sequência   u16  incrementada a cada registro
+ *   instante    u32  ms desde o boot
+ *   sensores    u16  bit i = sensor i presente no registro
+ *   anomalias   u16  bit i = leitura do sensor i fora dos limiares
+ *   alertas     u8   TELEMETRY_ALERT_*
+ *   por sensor presente, em ordem de bit:
+ *     valor     i16  leitura × TELEMETRY_SCALE
+ *     média     i16  média da janela × TELEMETRY_SCALE
+ *   crc         u16  CRC-16/CCITT-FALSE dos bytes anteriores
+ *
+ * O decodificador do lado do host está em tools/telemetry_decode.py.
+ */
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "fixed.h"
+
+#define TELEMETRY_VERSION 2
+#define TELEMETRY_MAX_SENSORS 16
+#define TELEMETRY_SCALE 10      ///< Valores em décimos da unidade do sensor
+
+/** @defgroup TelemetryAlerts Bits do campo de alertas
+ * @{
+ */
+#define TELEMETRY_ALERT_FIRE      (1u << 0)  ///< Incêndio ativo
+#define TELEMETRY_ALERT_WILDLIFE  (1u << 1)  ///< Animal detectado
+/** @} */
+
+/** Maior registro serializado (bytes, antes do COBS) */
+#define TELEMETRY_MAX_RECORD (12 + 4 * TELEMETRY_MAX_SENSORS + 2)
+
+/** Maior quadro transmitido: COBS acrescenta 1 byte a cada 254, mais os delimitadores */
+#define TELEMETRY_MAX_FRAME (TELEMETRY_MAX_RECORD + TELEMETRY_MAX_RECORD / 254 + 1 + 2)
+
+/**
+ * @brief Formato da saída serial
+ */
+typedef enum {
+    TELEMETRY_MODE_TEXT = 0,    ///< Relatório legível (printf)
+    TELEMETRY_MODE_BINARY       ///< Registros COBS
+} telemetry_mode_t;
+
+/**
+ * @brief Dados de um registro de telemetria
+ */
+typedef struct {
+    uint32_t timestamp_ms;                    ///< Instante da leitura
+    uint16_t sensor_mask;                     ///< Sensores presentes
+    uint16_t anomaly_mask;                    ///< Sensores em anomalia
+    uint8_t alerts;                           ///< TELEMETRY_ALERT_*
+    int16_t value[TELEMETRY_MAX_SENSORS];     ///< Leitura × TELEMETRY_SCALE
+    int16_t mean[TELEMETRY_MAX_SENSORS];      ///< Média × TELEMETRY_SCALE
+} telemetry_record_t;
+
+/**
+ * @brief Converte um valor Q23.8 para o formato do registro, com saturação
+ * @param value Valor na unidade do sensor
+ * @return value × TELEMETRY_SCALE, arredondado
+ */
+static inline int16_t telemetry_fixed(fix_t value) {
+    int32_t scaled = fix_to_scaled(value, TELEMETRY_SCALE);
+    if (scaled > INT16_MAX) return INT16_MAX;
+    if (scaled < INT16_MIN) return INT16_MIN;
+    return (int16_t)scaled;
+}
+
+/**
+ * @brief CRC-16/CCITT-FALSE (polinômio 0x1021, valor inicial 0xFFFF)
+ */
+uint16_t telemetry_crc16(const uint8_t *data, size_t len);
+
+/**
+ * @brief Codifica um bloco em COBS (sem o delimitador final)
+ *
+ * @param in Dados de entrada
+ * @param len Tamanho da entrada
+ * @param out Saída (len + len / 254 + 1 bytes)
+ * @return Bytes escritos em out
+ */
+size_t telemetry_cobs_encode(const uint8_t *in, size_t len, uint8_t *out);
+
+/**
+ * @brief Serializa um registro em um quadro pronto para envio
+ *
+ * Atribui o próximo número de sequência. O quadro começa e termina com
+ * 0x00, para que o receptor se ressincronize após texto intercalado.
+ *
+ * @param record Registro
+ * @param frame Saída (TELEMETRY_MAX_FRAME bytes)
+ * @return Tamanho do quadro
+ */
+size_t telemetry_build_frame(const telemetry_record_t *record, uint8_t *frame);
+
+/**
+ * @brief Serializa e envia um registro pela saída padrão, sem tradução de fim de linha
+ * @param record Registro
+ */
+void telemetry_send(const telemetry_record_t *record);
+
+/**
+ * @brief Formato atual da saída serial
+ */
+telemetry_mode_t telemetry_get_mode(void);
+
+/**
+ * @brief Seleciona o formato da saída serial
+ */
+void telemetry_set_mode(telemetry_mode_t mode);
+
+/**
+ * @brief Bytes enviados em registros binários desde o boot
+ */
+uint32_t telemetry_get_bytes_sent(void);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,118 @@
+/**
+ * @file anomaly_replay.c
+ * @brief Reprocessa leituras gravadas pelos detectores de anomalia, no host
+ *
+ * Cada amostra passa por sensor_feed(), o mesmo caminho do firmware, com
+ * os parâmetros do driver escolhido. Entrada (arquivo ou stdin), uma
+ * leitura por linha:
+ *   ms,valor                                  traço qualquer
+ *   [LOG,]boot,ms,leitura,sensor,valor,...    dump do log (comando 'd' ou flashlog_host)
+ * No dump valem só as leituras do sensor escolhido, cujo índice é a
+ * posição na tabela abaixo, igual à ordem de init_sensors().
+ *
+ * Compilação:
+ *   cc -std=c11 -I. -o anomaly_replay tools/anomaly_replay.c sensor.c anomaly.c history.c sensor_sim.c sensor_adc.c
+ *
+ * Uso:
+ *   anomaly_replay SENSOR [ARQUIVO]
+ *
+ * Saída em CSV (ms,valor,media,desvio,cusum_hi,cusum_lo,regras) e
+ * contagem por regra em stderr.
+ */
+#include "sensor.h"
+#include "sensor_sim.h"
+#include "sensor_adc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Drivers na ordem de registro do firmware */
+static const sensor_driver_t *const drivers[] = {
+    &sensor_sim_temperature,
+    &sensor_sim_flow,
+    &sensor_sim_rain,
+    &sensor_adc_chip_temperature,
+};
+#define NUM_DRIVERS (int)(sizeof(drivers) / sizeof(drivers[0]))
+
+/** Os drivers são usados só pelos parâmetros: read() nunca é chamado */
+uint32_t analog_get(unsigned channel) {
+    (void)channel;
+    return 0;
+}
+
+/**
+ * @brief Extrai instante e valor de uma linha do sensor escolhido
+ * @return false se a linha não for uma leitura desse sensor
+ */
+static bool parse_line(char *line, int sensor_index, uint32_t *ms, double *value) {
+    if (strncmp(line, "LOG,", 4) == 0) line += 4;
+    unsigned boot;
+    unsigned long t;
+    char type[16];
+    int sensor;
+    if (sscanf(line, "%u,%lu,%15[^,],%d,%lf", &boot, &t, type, &sensor, value) == 5) {
+        if (strcmp(type, "leitura") != 0 || sensor != sensor_index) return false;
+        *ms = (uint32_t)t;
+        return true;
+    }
+    if (sscanf(line, "%lu,%lf", &t, value) != 2) return false;
+    *ms = (uint32_t)t;
+    return true;
+}
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "uso: %s <sensor> [arquivo]\nsensores:", argv[0]);
+        for (int i = 0; i < NUM_DRIVERS; i++) fprintf(stderr, " \"%s\"", drivers[i]->name);
+        fprintf(stderr, "\n");
+        return 2;
+    }
+    int index = -1;
+    for (int i = 0; i < NUM_DRIVERS; i++) {
+        if (strcmp(argv[1], drivers[i]->name) == 0) index = i;
+    }
+    if (index < 0) {
+        fprintf(stderr, "sensor desconhecido: %s\n", argv[1]);
+        return 2;
+    }
+    FILE *in = stdin;
+    if (argc > 2 && (in = fopen(argv[2], "r")) == NULL) {
+        perror(argv[2]);
+        return 1;
+    }
+
+    // init() do driver não é chamado: o histórico começa vazio
+    sensor_t sensor = {.driver = drivers[index], .id = (uint8_t)index, .available = true, .enabled = true};
+    history_init(&sensor.history, SENSOR_HISTORY_WINDOW, sensor.history_storage);
+    anomaly_init(&sensor.detector);
+
+    uint32_t samples = 0;
+    uint32_t fired[ANOMALY_RULE_COUNT] = {0};
+    char line[256];
+    printf("ms,valor,media,desvio,cusum_hi,cusum_lo,regras\n");
+    while (fgets(line, sizeof(line), in) != NULL) {
+        uint32_t ms;
+        double value;
+        if (!parse_line(line, index, &ms, &value)) continue;
+
+        sensor_feed(&sensor, ms, (fix_t)(value * FIX_ONE + (value >= 0 ? 0.5 : -0.5)));
+        samples++;
+        uint8_t rules = sensor_anomaly_rules(&sensor);
+        for (int r = 0; r < ANOMALY_RULE_COUNT; r++) {
+            if (rules & (1u << r)) fired[r]++;
+        }
+        char names[40];
+        printf("%lu,%.2f,%.2f,%.2f,%.2f,%.2f,%s\n", (unsigned long)ms, fix_to_float(sensor.value),
+               fix_to_float(anomaly_mean(&sensor.detector)), fix_to_float(anomaly_stddev(&sensor.detector)),
+               fix_to_float(sensor.detector.cusum_hi), fix_to_float(sensor.detector.cusum_lo),
+               anomaly_format_rules(rules, names, sizeof(names)));
+    }
+    if (in != stdin) fclose(in);
+
+    fprintf(stderr, "%s: %lu amostras;", drivers[index]->name, (unsigned long)samples);
+    for (int r = 0; r < ANOMALY_RULE_COUNT; r++) {
+        fprintf(stderr, " %s=%lu", anomaly_rule_name((uint8_t)(1u << r)), (unsigned long)fired[r]);
+    }
+    fprintf(stderr, "\n");
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file flashlog_host.c
+ * @brief Log da flash (flashlog.c) sobre um arquivo, no host
+ *
+ * O arquivo faz o papel da região reservada: pode ser uma imagem lida da
+ * placa (picotool save -r) ou uma imagem nova, criada apagada (0xFF). O
+ * acesso ao arquivo é o mesmo da compilação do firmware no host
+ * (host/flashlog_file.c).
+ *
+ * Compilação:
+ *   cc -std=c11 -I. -Ihost -o flashlog_host tools/flashlog_host.c flashlog.c host/flashlog_file.c
+ *
+ * Uso:
+ *   flashlog_host IMAGEM dump           registros em CSV, do mais antigo ao mais novo
+ *   flashlog_host IMAGEM append N       nova inicialização com N leituras simuladas
+ *   flashlog_host IMAGEM stats          setores válidos, registros e cabeça
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "flashlog.h"
+#include "flashlog_file.h"
+
+static void dump(void) {
+    flashlog_cursor_t cursor;
+    flashlog_record_t record;
+    uint16_t boot;
+    printf("boot,timestamp_ms,tipo,sensor,valor,alertas\n");
+    flashlog_cursor_begin(&cursor);
+    while (flashlog_cursor_next(&cursor, &record, &boot)) {
+        printf("%u,%lu,%s,%d,%.2f,%u\n", boot, (unsigned long)record.timestamp_ms,
+               record.type == FLASHLOG_EVENT ? "evento" : "leitura",
+               record.sensor == FLASHLOG_NO_SENSOR ? -1 : record.sensor,
+               record.value / 256.0, record.flags);
+    }
+}
+static void append(long n) {
+    for (long i = 0; i < n; i++) {
+        flashlog_record_t record = {
+            .timestamp_ms = (uint32_t)(i / 3 * 1000),
+            .value = (int32_t)(rand() % (40 * 256)),
+            .sensor = (uint8_t)(i % 3),
+            .type = FLASHLOG_READING,
+            .flags = (uint16_t)(rand() % 50 == 0 ? FLASHLOG_FLAG_ANOMALY : 0)
+        };
+        if (!flashlog_append(&record)) {
+            fprintf(stderr, "falha ao gravar o registro %ld\n", i);
+            return;
+        }
+    }
+    flashlog_flush();
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        fprintf(stderr, "uso: %s IMAGEM dump|stats|append N\n", argv[0]);
+        return 2;
+    }
+    const flashlog_storage_t *storage = flashlog_file_storage(argv[1]);
+    if (storage == NULL) {
+        fprintf(stderr, "imagem inválida: %s\n", argv[1]);
+        return 1;
+    }
+    uint32_t sectors = storage->sector_count;
+    uint32_t valid = flashlog_init(storage);
+
+    if (strcmp(argv[2], "dump") == 0) {
+        dump();
+    } else if (strcmp(argv[2], "append") == 0 && argc > 3) {
+        append(strtol(argv[3], NULL, 10));
+        printf("boot %u: %lu setores gravados, %lu registros no log\n", flashlog_boot_id(),
+               (unsigned long)flashlog_sectors_written(), (unsigned long)flashlog_record_count());
+    } else if (strcmp(argv[2], "stats") == 0) {
+        printf("%lu/%lu setores válidos, %lu registros, próximo boot %u\n", (unsigned long)valid,
+               (unsigned long)sectors, (unsigned long)flashlog_record_count(), flashlog_boot_id());
+    } else {
+        fprintf(stderr, "comando desconhecido: %s\n", argv[2]);
+        return 2;
+    }
+    flashlog_file_close();
+    return 0;
+}
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""Decodifica a telemetria binária do monitor (telemetry.h) para CSV.
+
+Lê o fluxo de um arquivo, da entrada padrão ou de uma porta serial
+(requer pyserial), separa os quadros pelo delimitador 0x00, desfaz o
+COBS, confere o CRC-16/CCITT-FALSE e escreve uma linha CSV por registro.
+Texto intercalado no fluxo é descartado como quadro inválido.
+
+Exemplos:
+    python3 tools/telemetry_decode.py captura.bin > dados.csv
+    python3 tools/telemetry_decode.py --port /dev/ttyACM0 --send-mode
+"""
+import argparse
+import csv
+import struct
+import sys
+
+VERSION = 2
+SCALE = 10
+MAX_SENSORS = 16
+HEADER = struct.Struct("<BHIHHB")
+SENSOR_NAMES = ["temperatura", "fluxo_agua", "chuva", "temperatura_interna"]
+
+ALERT_FIRE = 1 << 0
+ALERT_WILDLIFE = 1 << 1
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise ValueError("COBS inválido")
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def sensor_name(index):
+    return SENSOR_NAMES[index] if index < len(SENSOR_NAMES) else "sensor%d" % index
+
+
+def parse_record(raw):
+    if len(raw) < HEADER.size + 2:
+        raise ValueError("registro curto")
+    if crc16(raw[:-2]) != struct.unpack_from("<H", raw, len(raw) - 2)[0]:
+        raise ValueError("CRC inválido")
+    version, seq, timestamp, mask, anomalies, alerts = HEADER.unpack_from(raw, 0)
+    if version != VERSION:
+        raise ValueError("versão %d desconhecida" % version)
+
+    record = {"seq": seq, "timestamp_ms": timestamp,
+              "incendio": int(bool(alerts & ALERT_FIRE)),
+              "vida_silvestre": int(bool(alerts & ALERT_WILDLIFE))}
+    offset = HEADER.size
+    for i in range(MAX_SENSORS):
+        if not mask & (1 << i):
+            continue
+        value, mean = struct.unpack_from("<hh", raw, offset)
+        offset += 4
+        name = sensor_name(i)
+        record[name] = value / SCALE
+        record[name + "_media"] = mean / SCALE
+        record[name + "_anomalia"] = int(bool(anomalies & (1 << i)))
+    if offset != len(raw) - 2:
+        raise ValueError("tamanho incompatível com os sensores")
+    return record
+
+
+def frames(stream, follow=False):
+    """Gera os blocos entre delimitadores 0x00.
+
+    Com follow, leituras vazias (timeout da serial) não encerram o fluxo.
+    """
+    pending = bytearray()
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            if follow:
+                continue
+            break
+        for byte in chunk:
+            if byte == 0:
+                if pending:
+                    yield bytes(pending)
+                    pending.clear()
+            else:
+                pending.append(byte)
+
+
+def columns():
+    """Colunas fixas para todos os MAX_SENSORS índices do quadro.
+
+    O cabeçalho sai antes do primeiro quadro (a serial é acompanhada ao
+    vivo) e sensores habilitados depois continuam tendo coluna; sensores
+    ausentes ficam com as células vazias.
+    """
+    cols = ["seq", "timestamp_ms", "incendio", "vida_silvestre"]
+    for i in range(MAX_SENSORS):
+        name = sensor_name(i)
+        cols += [name, name + "_media", name + "_anomalia"]
+    return cols
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", nargs="?", help="arquivo capturado (padrão: entrada padrão)")
+    parser.add_argument("--port", help="porta serial (ex.: /dev/ttyACM0)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--send-mode", action="store_true",
+                        help="envia 'b' pela porta para ativar o modo binário")
+    args = parser.parse_args()
+
+    if args.port:
+        import serial  # pyserial
+        stream = serial.Serial(args.port, args.baud, timeout=1)
+        if args.send_mode:
+            stream.write(b"b")
+    elif args.input:
+        stream = open(args.input, "rb")
+    else:
+        stream = sys.stdin.buffer
+
+    writer = csv.DictWriter(sys.stdout, fieldnames=columns())
+    writer.writeheader()
+    bad = 0
+    last_seq = None
+    lost = 0
+    for frame in frames(stream, follow=bool(args.port)):
+        try:
+            record = parse_record(cobs_decode(frame))
+        except (ValueError, struct.error):
+            bad += 1
+            continue
+        if last_seq is not None:
+            lost += (record["seq"] - last_seq - 1) & 0xFFFF
+        last_seq = record["seq"]
+        writer.writerow(record)
+        sys.stdout.flush()
+    print("quadros inválidos: %d, registros perdidos: %d" % (bad, lost), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,147 @@
+/**
+ * @file ui.c
+ * @brief Interface retida para o OLED: telas de widgets com conteúdo em cache
+ *
+ * O redesenho de um widget apaga apenas a sua caixa (máscara de linhas
+ * por página) e marca no SSD1306 só as colunas dela; o envio seguinte
+ * compara essas colunas com o que já está no display.
+ */
+#include "ui.h"
+#include "ssd1306.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+static ui_text_fn_t draw_text = NULL;
+static ui_screen_t *current = NULL;
+static bool invalid = true;
+static uint32_t rendered_total = 0;
+
+void ui_init(ui_text_fn_t text_fn) {
+    draw_text = text_fn;
+    current = NULL;
+    invalid = true;
+}
+/**
+ * @brief Acende ou apaga um retângulo e marca as colunas alteradas
+ */
+static void fill_rect(int x, int y, int w, int h, bool on) {
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > DISPLAY_WIDTH) w = DISPLAY_WIDTH - x;
+    if (y + h > DISPLAY_HEIGHT) h = DISPLAY_HEIGHT - y;
+    if (w <= 0 || h <= 0) return;
+
+    for (int page = y / 8; page <= (y + h - 1) / 8; page++) {
+        int top = (y > page * 8) ? y - page * 8 : 0;
+        int bottom = (y + h - 1 < page * 8 + 7) ? y + h - 1 - page * 8 : 7;
+        uint8_t mask = (uint8_t)((0xFF << top) & (0xFF >> (7 - bottom)));
+        ssd1306_cell_t *dst = &buffer[page][x];
+        for (int j = 0; j < w; j++) {
+            dst[j] = on ? (dst[j] | mask) : (dst[j] & (uint8_t)~mask);
+        }
+        ssd1306_mark_dirty((uint8_t)page, (uint8_t)x, (uint8_t)(x + w - 1));
+    }
+}
+/**
+ * @brief Copia um ícone de 8 colunas, dividindo entre páginas se preciso
+ */
+static void draw_icon(int x, int y, const uint8_t *icon) {
+    int page = y / 8, shift = y & 7;
+    int w = (x + 8 > DISPLAY_WIDTH) ? DISPLAY_WIDTH - x : 8;
+    for (int j = 0; j < w; j++) {
+        buffer[page][x + j] |= (uint8_t)(icon[j] << shift);
+        if (shift && page + 1 < SSD1306_PAGES) buffer[page + 1][x + j] |= (uint8_t)(icon[j] >> (8 - shift));
+    }
+    ssd1306_mark_dirty((uint8_t)page, (uint8_t)x, (uint8_t)(x + w - 1));
+    if (shift && page + 1 < SSD1306_PAGES) ssd1306_mark_dirty((uint8_t)(page + 1), (uint8_t)x, (uint8_t)(x + w - 1));
+}
+void ui_show(ui_screen_t *screen) {
+    if (screen == current && !invalid) return;
+    current = screen;
+    invalid = false;
+    ssd1306_clear();
+    for (int i = 0; i < screen->count; i++) {
+        screen->widgets[i].dirty = true;
+    }
+}
+void ui_invalidate() {
+    invalid = true;
+}
+void ui_set_text(ui_widget_t *widget, const char *text) {
+    // Só cabe o que a caixa mostra; o resto não muda a tela
+    size_t max = widget->w / 8;
+    if (max > UI_TEXT_MAX - 1) max = UI_TEXT_MAX - 1;
+    size_t len = strlen(text);
+    if (len > max) len = max;
+    if (strncmp(widget->text, text, len) == 0 && widget->text[len] == '\0') return;
+    memcpy(widget->text, text, len);
+    widget->text[len] = '\0';
+    widget->dirty = true;
+}
+void ui_set_textf(ui_widget_t *widget, const char *fmt, ...) {
+    char text[UI_TEXT_MAX];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+    ui_set_text(widget, text);
+}
+void ui_set_bar(ui_widget_t *widget, int32_t value, int32_t max) {
+    // Barras com mais de 3 linhas têm moldura; o preenchimento é interno
+    int span = (widget->h > 3) ? widget->w - 2 : widget->w;
+    if (max <= 0 || value < 0) value = 0;
+    else if (value > max) value = max;
+    uint8_t fill = (max > 0) ? (uint8_t)(((int64_t)value * span + max / 2) / max) : 0;
+    if (fill == widget->fill) return;
+    widget->fill = fill;
+    widget->dirty = true;
+}
+void ui_set_visible(ui_widget_t *widget, bool visible) {
+    if (widget->visible == visible) return;
+    widget->visible = visible;
+    widget->dirty = true;
+}
+/**
+ * @brief Apaga a caixa do widget e desenha o conteúdo atual
+ */
+static void render_widget(const ui_widget_t *widget) {
+    fill_rect(widget->x, widget->y, widget->w, widget->h, false);
+    if (!widget->visible) return;
+    switch (widget->type) {
+        case UI_LABEL:
+        case UI_VALUE:
+            if (draw_text) draw_text(widget->x, widget->y, widget->text, widget->inverted);
+            break;
+        case UI_BAR:
+            if (widget->h > 3) {
+                fill_rect(widget->x, widget->y, widget->w, 1, true);
+                fill_rect(widget->x, widget->y + widget->h - 1, widget->w, 1, true);
+                fill_rect(widget->x, widget->y, 1, widget->h, true);
+                fill_rect(widget->x + widget->w - 1, widget->y, 1, widget->h, true);
+                fill_rect(widget->x + 1, widget->y + 1, widget->fill, widget->h - 2, true);
+            } else {
+                fill_rect(widget->x, widget->y, widget->fill, widget->h, true);
+            }
+            break;
+        case UI_ICON:
+            if (widget->icon) draw_icon(widget->x, widget->y, widget->icon);
+            break;
+    }
+}
+int ui_render() {
+    if (current == NULL) return 0;
+    int count = 0;
+    for (int i = 0; i < current->count; i++) {
+        ui_widget_t *widget = &current->widgets[i];
+        if (!widget->dirty) continue;
+        widget->dirty = false;
+        render_widget(widget);
+        count++;
+    }
+    rendered_total += (uint32_t)count;
+    return count;
+}
+uint32_t ui_get_rendered() {
+    return rendered_total;
+}
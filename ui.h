@@ -0,0 +1,135 @@
+/**
+ * @file ui.h
+ * @brief Interface retida para o OLED: telas de widgets com conteúdo em cache
+ *
+ * Uma tela é um vetor de widgets (rótulo, valor, barra, ícone), cada um
+ * com sua caixa na tela e o conteúdo exibido em cache. Os setters só
+ * marcam o widget quando o conteúdo muda de fato (o mesmo texto, ou uma
+ * barra com o mesmo comprimento em pixels, não geram trabalho), e
+ * ui_render() redesenha apenas os marcados: apaga a caixa e desenha o
+ * conteúdo novo. Só essas caixas são marcadas no SSD1306, de modo que o
+ * próximo envio compara e transmite poucas colunas em vez do quadro.
+ *
+ * Quem desenhar diretamente no buffer fora da UI (menu, telas de
+ * inicialização) deve chamar ui_invalidate() para que a próxima tela
+ * seja redesenhada por inteiro.
+ */
+#ifndef UI_H
+#define UI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define UI_TEXT_MAX 16   ///< Texto em cache (draw_string quebra a linha após 15 caracteres)
+
+/**
+ * @brief Tipos de widget
+ */
+typedef enum {
+    UI_LABEL = 0,  ///< Texto fixo, definido na declaração da tela
+    UI_VALUE,      ///< Texto atualizado por ui_set_text()
+    UI_BAR,        ///< Barra horizontal preenchida proporcionalmente
+    UI_ICON        ///< Bitmap 8x8 em colunas (formato da fonte)
+} ui_widget_type_t;
+
+/**
+ * @brief Widget de uma tela
+ *
+ * Declarado com UI_LABEL_AT, UI_VALUE_AT, UI_BAR_AT, UI_LINE_AT ou
+ * UI_ICON_AT; os demais campos são estado interno.
+ */
+typedef struct {
+    uint8_t type;            ///< ui_widget_type_t
+    uint8_t x, y, w, h;      ///< Caixa na tela (px)
+    bool inverted;           ///< Texto claro sobre fundo aceso
+    bool visible;
+    bool dirty;              ///< Precisa ser redesenhado
+    char text[UI_TEXT_MAX];  ///< Rótulo ou valor exibido
+    uint8_t fill;            ///< Barra: pixels preenchidos
+    const uint8_t *icon;     ///< Ícone: 8 colunas
+} ui_widget_t;
+
+/** Rótulo fixo em (x, y) */
+#define UI_LABEL_AT(x_, y_, str) \
+    {.type = UI_LABEL, .x = (x_), .y = (y_), .w = (uint8_t)((sizeof(str) - 1) * 8), .h = 8, .visible = true, .text = str}
+/** Valor de até chars caracteres em (x, y) */
+#define UI_VALUE_AT(x_, y_, chars) \
+    {.type = UI_VALUE, .x = (x_), .y = (y_), .w = (chars) * 8, .h = 8, .visible = true}
+/** Barra w x h em (x, y) */
+#define UI_BAR_AT(x_, y_, w_, h_) \
+    {.type = UI_BAR, .x = (x_), .y = (y_), .w = (w_), .h = (h_), .visible = true}
+/** Linha horizontal fixa (barra de 1 px sempre cheia) */
+#define UI_LINE_AT(x_, y_, w_) \
+    {.type = UI_BAR, .x = (x_), .y = (y_), .w = (w_), .h = 1, .visible = true, .fill = (w_)}
+/** Ícone 8x8 em (x, y), inicialmente oculto */
+#define UI_ICON_AT(x_, y_, bitmap) \
+    {.type = UI_ICON, .x = (x_), .y = (y_), .w = 8, .h = 8, .visible = false, .icon = (bitmap)}
+
+/**
+ * @brief Tela: widgets desenhados juntos
+ */
+typedef struct {
+    ui_widget_t *widgets;
+    uint8_t count;
+} ui_screen_t;
+
+/** Declara uma tela a partir de um vetor de widgets */
+#define UI_SCREEN(array) {(array), (uint8_t)(sizeof(array) / sizeof((array)[0]))}
+
+/**
+ * @brief Função de texto usada pelos widgets (ex.: draw_string)
+ */
+typedef void (*ui_text_fn_t)(int x, int y, const char *str, bool inverted);
+
+/**
+ * @brief Define a função que desenha texto
+ */
+void ui_init(ui_text_fn_t draw_text);
+
+/**
+ * @brief Torna a tela a atual
+ *
+ * Se for outra tela (ou após ui_invalidate()), limpa o buffer e marca
+ * todos os widgets; mostrar de novo a tela atual não custa nada.
+ */
+void ui_show(ui_screen_t *screen);
+
+/**
+ * @brief Força o redesenho completo da próxima tela mostrada
+ */
+void ui_invalidate(void);
+
+/**
+ * @brief Atualiza o texto de um valor (marca só se mudar)
+ */
+void ui_set_text(ui_widget_t *widget, const char *text);
+
+/**
+ * @brief ui_set_text() com formatação printf
+ */
+void ui_set_textf(ui_widget_t *widget, const char *fmt, ...);
+
+/**
+ * @brief Atualiza uma barra (marca só se o comprimento em pixels mudar)
+ * @param value Valor, limitado a [0, max]
+ * @param max Valor da barra cheia (> 0)
+ */
+void ui_set_bar(ui_widget_t *widget, int32_t value, int32_t max);
+
+/**
+ * @brief Mostra ou oculta um widget (a caixa oculta fica apagada)
+ */
+void ui_set_visible(ui_widget_t *widget, bool visible);
+
+/**
+ * @brief Redesenha os widgets marcados da tela atual no buffer
+ * @return Widgets redesenhados
+ */
+int ui_render(void);
+
+/**
+ * @brief Total de widgets redesenhados desde a inicialização
+ */
+uint32_t ui_get_rendered(void);
+
+#endif // UI_H